@@ -12,6 +12,15 @@ namespace PhosEngine
             set => InternalCalls.TransformComponent_SetPosition(Entity.Id, ref value);
         }
 
+        public Vector3 WorldPosition
+        {
+            get
+            {
+                InternalCalls.TransformComponent_GetWorldPosition(Entity.Id, out var val);
+                return val;
+            }
+        }
+
         public Vector3 Scale
         {
             get
@@ -63,6 +63,17 @@ namespace PhosEngine
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern void TransformComponent_SetRotation(ulong entityId, ref Vector3 rotation);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void TransformComponent_GetWorldPosition(ulong entityId, out Vector3 position);
+
+        #endregion
+
+        #region Physics
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Physics_Raycast(ref Vector3 origin, ref Vector3 direction, float maxDistance,
+            out bool hit, out ulong entityId, out float distance);
+
         #endregion
     }
 }
\ No newline at end of file
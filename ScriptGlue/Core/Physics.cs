@@ -0,0 +1,21 @@
+namespace PhosEngine
+{
+    public struct RaycastHit
+    {
+        public Entity Entity;
+        public float Distance;
+    }
+
+    public static class Physics
+    {
+        // Closest entity whose mesh bounding box is hit by the ray, as the scene was at the start of the frame
+        public static bool Raycast(Vector3 origin, Vector3 direction, float maxDistance, out RaycastHit hit)
+        {
+            InternalCalls.Physics_Raycast(ref origin, ref direction, maxDistance, out var isHit, out var entityId,
+                out var distance);
+
+            hit = new RaycastHit { Entity = new Entity { Id = entityId }, Distance = distance };
+            return isHit;
+        }
+    }
+}
\ No newline at end of file
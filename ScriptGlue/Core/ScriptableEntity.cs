@@ -5,6 +5,7 @@ namespace PhosEngine
     [StructLayout(LayoutKind.Sequential)]
     public class ScriptableEntity
     {
+        // Runtime handle of the entity in the running scene, not its persistent uuid
         public readonly ulong Id;
 
         public ScriptableEntity() => Id = 0;
@@ -18,11 +18,31 @@ void serialize_component(const Phos::Entity& entity, AssetBuilder& builder) {
 
 #define SERIALIZE_COMPONENT(T) serialize_component<T>(entity, builder)
 
+// The hierarchy is not a component anymore, but it is still saved as one to keep the format
+static void serialize_relationship(const Phos::Entity& entity, AssetBuilder& builder) {
+    auto component_builder = AssetBuilder();
+
+    if (const auto parent = entity.parent()) {
+        component_builder.dump("parent", parent->uuid());
+    }
+
+    if (entity.has_children()) {
+        auto children_list = std::vector<uint64_t>();
+
+        for (const auto& child : entity.children())
+            children_list.push_back(static_cast<uint64_t>(child.uuid()));
+
+        component_builder.dump("children", children_list);
+    }
+
+    builder.dump("RelationshipComponent", component_builder);
+}
+
 AssetBuilder EntitySerializer::serialize(const Phos::Entity& entity) {
     auto builder = AssetBuilder();
 
     SERIALIZE_COMPONENT(Phos::NameComponent);
-    SERIALIZE_COMPONENT(Phos::RelationshipComponent);
+    serialize_relationship(entity, builder);
     SERIALIZE_COMPONENT(Phos::TransformComponent);
     SERIALIZE_COMPONENT(Phos::MeshRendererComponent);
     SERIALIZE_COMPONENT(Phos::LightComponent);
@@ -44,25 +64,6 @@ SERIALIZE_COMPONENT_T(Phos::NameComponent) {
     builder.dump("NameComponent", component.name);
 }
 
-SERIALIZE_COMPONENT_T(Phos::RelationshipComponent) {
-    auto component_builder = AssetBuilder();
-
-    if (component.parent.has_value()) {
-        component_builder.dump("parent", *component.parent);
-    }
-
-    if (!component.children.empty()) {
-        auto children_list = std::vector<uint64_t>();
-
-        for (const auto& child : component.children)
-            children_list.push_back(static_cast<uint64_t>(child));
-
-        component_builder.dump("children", children_list);
-    }
-
-    builder.dump("RelationshipComponent", component_builder);
-}
-
 SERIALIZE_COMPONENT_T(Phos::TransformComponent) {
     auto component_builder = AssetBuilder();
 
@@ -85,6 +86,8 @@ SERIALIZE_COMPONENT_T(Phos::MeshRendererComponent) {
     const auto material_id = component.material == nullptr ? Phos::UUID(0) : component.material->id;
     component_builder.dump("material", material_id);
 
+    component_builder.dump("occluder", component.occluder);
+
     builder.dump("MeshRendererComponent", component_builder);
 }
 
@@ -23,6 +23,8 @@ void SceneSerializer::serialize(const std::shared_ptr<Phos::Scene>& scene, const
         // Rendering config
         auto rendering_config = AssetBuilder();
         rendering_config.dump("shadowMapResolution", config.rendering_config.shadow_map_resolution);
+        rendering_config.dump("occlusionCulling", config.rendering_config.occlusion_culling);
+        rendering_config.dump("gpuInstancing", config.rendering_config.gpu_instancing);
 
         config_builder.dump("renderingConfig", rendering_config);
     }
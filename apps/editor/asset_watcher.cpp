@@ -154,6 +154,7 @@ void AssetWatcher::asset_removed(const std::filesystem::path& path) {
             auto& mr = entity.get_component<Phos::MeshRendererComponent>();
             if (mr.mesh != nullptr && mr.mesh->id == id) {
                 mr.mesh = nullptr;
+                entity.mark_changed<Phos::MeshRendererComponent>();
             }
         }
     } else if (type == Phos::AssetType::Script) {
@@ -223,6 +224,8 @@ void AssetWatcher::update_mesh(const std::shared_ptr<Phos::StaticMesh>& mesh) co
         auto& mr = entity.get_component<Phos::MeshRendererComponent>();
         if (mr.mesh != nullptr && mr.mesh->id == mesh->id) {
             mr.mesh = mesh;
+            // The bounds of the reloaded mesh may differ from the old ones
+            entity.mark_changed<Phos::MeshRendererComponent>();
         }
     }
 }
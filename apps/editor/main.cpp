@@ -175,6 +175,8 @@ class EditorLayer : public Phos::Layer {
         // Viewport
         //
         m_viewport_panel->on_imgui_render();
+        if (const auto picked_entity = m_viewport_panel->take_picked_entity(); picked_entity.has_value())
+            m_entity_panel->select_entity(*picked_entity);
 
         //
         // Viewport Controls
@@ -226,6 +228,33 @@ class EditorLayer : public Phos::Layer {
         const std::string fps_text = "fps = " + std::to_string(m_fps);
         ImGui::Text("%s", fps_text.c_str());
 
+        const auto& statistics = m_renderer->statistics();
+        ImGui::Text("renderables = %u (%u visible)", statistics.renderables, statistics.visible_renderables);
+        ImGui::Text("visible sub meshes = %u", statistics.visible_sub_meshes);
+        ImGui::Text("occluded sub meshes = %u (%u occluder triangles)",
+                    statistics.occluded_sub_meshes,
+                    statistics.occluder_triangles);
+        ImGui::Text("draw calls = %u for %u instances (%u material binds, %u mesh binds)",
+                    statistics.draw_calls,
+                    statistics.instances,
+                    statistics.material_binds,
+                    statistics.mesh_binds);
+        for (std::size_t light_idx = 0; light_idx < statistics.shadow_casters.size(); ++light_idx)
+            ImGui::Text("shadow casters light %zu = %u", light_idx, statistics.shadow_casters[light_idx]);
+
+        constexpr double bytes_to_mib = 1.0 / (1024.0 * 1024.0);
+        const auto memory_statistics = Phos::Renderer::memory_statistics();
+        for (std::size_t heap_idx = 0; heap_idx < memory_statistics.size(); ++heap_idx) {
+            const auto& heap = memory_statistics[heap_idx];
+            ImGui::Text("%s heap %zu = %.1f / %.1f MiB (%u allocations in %u device allocations)",
+                        heap.device_local ? "device" : "host",
+                        heap_idx,
+                        static_cast<double>(heap.used_bytes) * bytes_to_mib,
+                        static_cast<double>(heap.reserved_bytes) * bytes_to_mib,
+                        heap.allocations,
+                        heap.device_allocations);
+        }
+
         ImGui::End();
 
         // Rendering
@@ -1,7 +1,5 @@
 #include "entity_hierarchy_panel.h"
 
-#include <algorithm>
-
 #include "panels/content_browser_panel.h"
 
 #include "editor_scene_manager.h"
@@ -18,17 +16,11 @@ EntityHierarchyPanel::EntityHierarchyPanel(std::string name,
 void EntityHierarchyPanel::on_imgui_render() {
     ImGui::Begin(m_name.c_str());
 
-    std::vector<Phos::Entity> parent_entities;
-    std::ranges::copy_if(m_scene_manager->active_scene()->get_entities_with<Phos::RelationshipComponent>(),
-                         std::back_inserter(parent_entities),
-                         [](Phos::Entity& entity) {
-                             auto relationship = entity.get_component<Phos::RelationshipComponent>();
-                             return !relationship.parent.has_value();
-                         });
+    const auto& scene = m_scene_manager->active_scene();
 
     bool entity_hovered = false;
-    for (const auto& entity : parent_entities) {
-        entity_hovered |= render_entity_r(entity);
+    for (const auto root : scene->hierarchy().roots()) {
+        entity_hovered |= render_entity_r(scene->get_entity(root));
     }
 
     // Left click on blank = deselect entity
@@ -55,8 +47,7 @@ bool EntityHierarchyPanel::render_entity_r(const Phos::Entity& entity) {
         flags |= ImGuiTreeNodeFlags_Selected;
 
     const auto& name = entity.get_component<Phos::NameComponent>().name;
-    const auto& children = entity.get_component<Phos::RelationshipComponent>().children;
-    if (children.empty())
+    if (!entity.has_children())
         flags |= ImGuiTreeNodeFlags_Leaf;
 
     const bool opened = ImGui::TreeNodeEx((void*)static_cast<uint64_t>(entity.uuid()), flags, "%s", name.c_str());
@@ -64,8 +55,8 @@ bool EntityHierarchyPanel::render_entity_r(const Phos::Entity& entity) {
 
     // Drag and drop
     if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID)) {
-        ImGui::SetDragDropPayload(
-            "ENTITY_HIERARCHY_ITEM", &entity.get_component<Phos::UUIDComponent>().uuid, sizeof(Phos::UUID));
+        const auto uuid = entity.uuid();
+        ImGui::SetDragDropPayload("ENTITY_HIERARCHY_ITEM", &uuid, sizeof(Phos::UUID));
         ImGui::EndDragDropSource();
     }
 
@@ -96,8 +87,7 @@ bool EntityHierarchyPanel::render_entity_r(const Phos::Entity& entity) {
     }
 
     if (opened) {
-        for (const auto& child_uuid : children) {
-            const auto& child = m_scene_manager->active_scene()->get_entity_with_uuid(child_uuid);
+        for (const auto& child : entity.children()) {
             hovered |= render_entity_r(child);
         }
 
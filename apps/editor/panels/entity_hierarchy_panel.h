@@ -25,6 +25,7 @@ class EntityHierarchyPanel : public IImGuiPanel {
     void on_imgui_render() override;
     [[nodiscard]] std::optional<Phos::Entity> get_selected_entity() const { return m_selected_entity; }
     void clear_selected_entity() { m_selected_entity = {}; }
+    void select_entity(const Phos::Entity& entity);
 
   private:
     std::string m_name;
@@ -35,5 +36,4 @@ class EntityHierarchyPanel : public IImGuiPanel {
     std::optional<Phos::Entity> m_selected_entity;
 
     bool render_entity_r(const Phos::Entity& entity);
-    void select_entity(const Phos::Entity& entity);
 };
@@ -35,6 +35,7 @@ void render_label_input(const std::string& label, const std::string& group, T* v
 
 template <typename T>
 void render_component(T& component,
+                      const Phos::Entity& entity,
                       const std::shared_ptr<Phos::Scene>& scene,
                       const std::shared_ptr<Phos::EditorAssetManager>& asset_manager);
 
@@ -48,11 +49,15 @@ void render_component(Phos::Entity& entity,
 
     ImGui::BeginGroup();
 
-    render_component<T>(entity.get_component<T>(), scene, asset_manager);
+    render_component<T>(entity.get_component<T>(), entity, scene, asset_manager);
     ImGui::Separator();
 
     ImGui::EndGroup();
 
+    // Let systems that cache derived data know about edits made from the inspector
+    if (ImGui::IsItemEdited())
+        entity.mark_changed<T>();
+
     if (!right_click)
         return;
 
@@ -113,6 +118,7 @@ void EntityComponentsRenderer::display(Phos::Entity& entity,
 #define RENDER_COMPONENT(T)                                                              \
     template <>                                                                          \
     void render_component<T>(T & component,                                              \
+                             [[maybe_unused]] const Phos::Entity& entity,                \
                              [[maybe_unused]] const std::shared_ptr<Phos::Scene>& scene, \
                              [[maybe_unused]] const std::shared_ptr<Phos::EditorAssetManager>& asset_manager)
 
@@ -205,8 +211,11 @@ RENDER_COMPONENT(Phos::MeshRendererComponent) {
     ImGui::InputText("##MeshInput", mesh_name.data(), mesh_name.length(), ImGuiInputTextFlags_ReadOnly);
 
     const auto mesh_asset = ImGuiUtils::drag_drop_target<EditorAsset>("CONTENT_BROWSER_ITEM");
-    if (mesh_asset.has_value() && !mesh_asset->is_directory && mesh_asset->type == Phos::AssetType::StaticMesh)
+    if (mesh_asset.has_value() && !mesh_asset->is_directory && mesh_asset->type == Phos::AssetType::StaticMesh) {
         component.mesh = asset_manager->load_by_id_type<Phos::StaticMesh>(mesh_asset->uuid);
+        // Dropping does not count as an ImGui edit, but the spatial index needs the bounds of the new mesh
+        entity.mark_changed<Phos::MeshRendererComponent>();
+    }
 
     ImGui::TableNextRow();
 
@@ -223,6 +232,15 @@ RENDER_COMPONENT(Phos::MeshRendererComponent) {
     if (mat_asset.has_value() && !mat_asset->is_directory && mat_asset->type == Phos::AssetType::Material)
         component.material = asset_manager->load_by_id_type<Phos::Material>(mat_asset->uuid);
 
+    ImGui::TableNextRow();
+
+    // Occluder
+    ImGui::TableSetColumnIndex(0);
+    ImGui::Text("Occluder:");
+
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Checkbox("##OccluderCheckbox", &component.occluder);
+
     ImGui::EndTable();
 }
 
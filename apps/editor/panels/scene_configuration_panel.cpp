@@ -44,6 +44,9 @@ void SceneConfigurationPanel::render_rendering_config() {
     ImGui::InputScalar("##ShadowMapResolution", ImGuiDataType_U32, &config.shadow_map_resolution);
 
     config.shadow_map_resolution = std::max(1u, config.shadow_map_resolution);
+
+    ImGui::Checkbox("Occlusion Culling", &config.occlusion_culling);
+    ImGui::Checkbox("GPU Instancing", &config.gpu_instancing);
 }
 
 
@@ -69,9 +69,42 @@ void ViewportPanel::on_imgui_render() {
 
     ImGui::Image(m_texture_id, viewport_node->Size);
 
+    if (camera != nullptr && EditorStateManager::get_state() == EditorState::Editing &&
+        ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
+        const auto mouse = ImGui::GetMousePos();
+        const auto image_min = ImGui::GetItemRectMin();
+        pick_entity(*camera, glm::vec2(mouse.x - image_min.x, mouse.y - image_min.y));
+    }
+
     ImGui::End();
 }
 
+std::optional<Phos::Entity> ViewportPanel::take_picked_entity() {
+    return std::exchange(m_picked_entity, std::nullopt);
+}
+
+void ViewportPanel::pick_entity(const Phos::Camera& camera, glm::vec2 mouse_position) {
+    // The projection is flipped vertically when uploaded, so the top of the image is +1 in normalized device coordinates
+    const auto ndc = glm::vec2(2.0f * mouse_position.x / static_cast<float>(m_width) - 1.0f,
+                               1.0f - 2.0f * mouse_position.y / static_cast<float>(m_height));
+
+    const auto inverse_view_projection = glm::inverse(camera.projection_matrix() * camera.view_matrix());
+    const auto unproject = [&](float depth) {
+        const auto position = inverse_view_projection * glm::vec4(ndc, depth, 1.0f);
+        return glm::vec3(position) / position.w;
+    };
+
+    const auto near_point = unproject(0.0f);
+    const auto far_point = unproject(1.0f);
+
+    const auto ray = Phos::Ray{.origin = near_point, .direction = glm::normalize(far_point - near_point)};
+
+    const auto scene = m_scene_manager->active_scene();
+    const auto hit = scene->spatial_index().raycast(ray, glm::length(far_point - near_point));
+    if (hit.has_value())
+        m_picked_entity = scene->get_entity(hit->entity);
+}
+
 void ViewportPanel::on_mouse_moved(Phos::MouseMovedEvent& mouse_moved, uint32_t dockspace_id) {
     if (!ImGui::DockBuilderGetCentralNode(dockspace_id)->IsFocused ||
         EditorStateManager::get_state() != EditorState::Editing)
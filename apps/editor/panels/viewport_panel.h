@@ -3,8 +3,11 @@
 #include "imgui_panel.h"
 
 #include <memory>
+#include <optional>
 #include <glm/glm.hpp>
 
+#include "scene/entity.h"
+
 namespace Phos {
 
 // Forward declarations
@@ -34,6 +37,9 @@ class ViewportPanel : public IImGuiPanel {
     void on_mouse_moved(Phos::MouseMovedEvent& mouse_moved, uint32_t dockspace_id);
     void on_key_pressed(Phos::KeyPressedEvent& key_Pressed, uint32_t dockspace_id);
 
+    /// Entity clicked in the viewport since the last call, if any
+    [[nodiscard]] std::optional<Phos::Entity> take_picked_entity();
+
   private:
     std::string m_name;
     std::shared_ptr<Phos::ISceneRenderer> m_renderer;
@@ -45,5 +51,9 @@ class ViewportPanel : public IImGuiPanel {
     uint32_t m_width, m_height;
     ImTextureID m_texture_id;
 
+    std::optional<Phos::Entity> m_picked_entity;
+
     [[nodiscard]] std::shared_ptr<Phos::Camera> get_camera() const;
+    /// Picks the closest entity under the mouse, given in pixels relative to the viewport image
+    void pick_entity(const Phos::Camera& camera, glm::vec2 mouse_position);
 };
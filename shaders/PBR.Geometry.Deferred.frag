@@ -1,5 +1,6 @@
 #version 450
 
+#include "include/Bindless.glslh"
 #include "include/LightInformation.glslh"
 
 layout (location = 0) in vec3 vPosition;
@@ -13,13 +14,7 @@ layout (location = 2) out vec4 outAlbedo;
 layout (location = 3) out vec4 outMetallicRoughnessAO;
 layout (location = 4) out vec4 outEmission;
 
-layout (set = 2, binding = 0) uniform sampler2D uAlbedoMap;
-layout (set = 2, binding = 1) uniform sampler2D uMetallicMap;
-layout (set = 2, binding = 2) uniform sampler2D uRoughnessMap;
-layout (set = 2, binding = 3) uniform sampler2D uAOMap;
-layout (set = 2, binding = 4) uniform sampler2D uNormalMap;
-
-layout (set = 2, binding = 5) uniform PBRMaterialInfo {
+struct PBRMaterialInfo {
     vec3 albedo;
     float metallic;
     float roughness;
@@ -27,12 +22,29 @@ layout (set = 2, binding = 5) uniform PBRMaterialInfo {
 
     float emissionIntensity;
     vec3 emissionColor;
+
+    // Indices in uTextures
+    uint uAlbedoMap;
+    uint uMetallicMap;
+    uint uRoughnessMap;
+    uint uAOMap;
+    uint uNormalMap;
+};
+
+layout (std430, set = 3, binding = 1) readonly buffer PBRMaterialBuffer {
+    PBRMaterialInfo materials[];
 } uMaterialInfo;
 
+vec4 sampleMaterialTexture(uint textureIdx, vec2 coords) {
+    return texture(uTextures[nonuniformEXT(textureIdx)], coords);
+}
+
 void main() {
+    PBRMaterialInfo material = uMaterialInfo.materials[uMaterial.index];
+
     outPosition = vec4(vPosition, 1.0f);
 
-    vec3 normal = texture(uNormalMap, vTextureCoords).rgb;
+    vec3 normal = sampleMaterialTexture(material.uNormalMap, vTextureCoords).rgb;
     if (normal == vec3(1.0f)) {
         outNormal.rgb = vNormal;
     } else {
@@ -42,10 +54,10 @@ void main() {
         outNormal.rgb = normal;
     }
 
-    outAlbedo = texture(uAlbedoMap, vTextureCoords) * vec4(uMaterialInfo.albedo, 1.0f);
+    outAlbedo = sampleMaterialTexture(material.uAlbedoMap, vTextureCoords) * vec4(material.albedo, 1.0f);
 
-    outMetallicRoughnessAO.r = texture(uMetallicMap, vTextureCoords).r * uMaterialInfo.metallic;
-    outMetallicRoughnessAO.g = texture(uRoughnessMap, vTextureCoords).r * uMaterialInfo.roughness;
-    outMetallicRoughnessAO.b = texture(uAOMap, vTextureCoords).r * uMaterialInfo.ao;
-    outEmission = vec4(uMaterialInfo.emissionColor * uMaterialInfo.emissionIntensity, 1.0f);
+    outMetallicRoughnessAO.r = sampleMaterialTexture(material.uMetallicMap, vTextureCoords).r * material.metallic;
+    outMetallicRoughnessAO.g = sampleMaterialTexture(material.uRoughnessMap, vTextureCoords).r * material.roughness;
+    outMetallicRoughnessAO.b = sampleMaterialTexture(material.uAOMap, vTextureCoords).r * material.ao;
+    outEmission = vec4(material.emissionColor * material.emissionIntensity, 1.0f);
 }
\ No newline at end of file
@@ -6,12 +6,17 @@ layout (location = 2) in vec2 aTextureCoords;
 layout (location = 3) in vec3 aTangent;
 
 #include "include/FrameUniforms.Vertex.glslh"
+#include "include/InstanceData.Vertex.glslh"
 
 layout (push_constant) uniform ShadowMapPushConstants {
     mat4 lightSpaceMatrix;
-    mat4 model;
 } uShadowMapInfo;
 
 void main() {
-    gl_Position = uShadowMapInfo.lightSpaceMatrix * uShadowMapInfo.model * vec4(aPosition, 1.0f);
+    mat4 model = uInstances.instances[gl_InstanceIndex].model;
+
+    gl_Position = uShadowMapInfo.lightSpaceMatrix * model * vec4(aPosition, 1.0f);
+
+    // Casters between the light and the near plane are flattened onto it instead of being clipped
+    gl_Position.z = max(gl_Position.z, 0.0f);
 }
\ No newline at end of file
@@ -229,6 +229,35 @@ std::shared_ptr<Texture> MaterialParser::parse_texture(const YAML::Node& node) c
 // StaticMeshParser
 //
 
+static std::vector<OccluderGeometry> load_occluder_geometry(const std::filesystem::path& model_path,
+                                                            uint32_t import_flags) {
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(model_path.string().c_str(), import_flags);
+
+    if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) {
+        PHOS_LOG_ERROR("Failed to load occluder geometry, error loading file: {}\n", model_path.string());
+        return {};
+    }
+
+    std::vector<OccluderGeometry> geometry(scene->mNumMeshes);
+    for (std::size_t i = 0; i < scene->mNumMeshes; ++i) {
+        const auto mesh = scene->mMeshes[i];
+
+        geometry[i].positions.reserve(mesh->mNumVertices);
+        for (uint32_t j = 0; j < mesh->mNumVertices; ++j) {
+            const auto& vs = mesh->mVertices[j];
+            geometry[i].positions.emplace_back(vs.x, vs.y, vs.z);
+        }
+
+        for (uint32_t j = 0; j < mesh->mNumFaces; ++j) {
+            const aiFace& face = mesh->mFaces[j];
+            geometry[i].indices.insert(geometry[i].indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+        }
+    }
+
+    return geometry;
+}
+
 std::shared_ptr<IAsset> StaticMeshParser::parse(const YAML::Node& node, [[maybe_unused]] const std::string& path) {
     const auto model_path = node["source"].as<std::string>();
     const auto real_model_path = std::filesystem::path(path).parent_path() / model_path;
@@ -302,7 +331,9 @@ std::shared_ptr<IAsset> StaticMeshParser::parse(const YAML::Node& node, [[maybe_
         meshes.push_back(std::make_shared<SubMesh>(vertices, indices));
     }
 
-    return std::make_shared<StaticMesh>(meshes);
+    // Only meshes used as occluders need their geometry on the CPU, it is imported again the first time it is used
+    return std::make_shared<StaticMesh>(
+        meshes, [real_model_path, import_flags] { return load_occluder_geometry(real_model_path, import_flags); });
 }
 
 //
@@ -331,6 +362,10 @@ std::shared_ptr<IAsset> SceneParser::parse(const YAML::Node& node, [[maybe_unuse
 
     renderer_config.rendering_config.shadow_map_resolution =
         config_node["renderingConfig"]["shadowMapResolution"].as<uint32_t>();
+    if (const auto occlusion_culling = config_node["renderingConfig"]["occlusionCulling"])
+        renderer_config.rendering_config.occlusion_culling = occlusion_culling.as<bool>();
+    if (const auto gpu_instancing = config_node["renderingConfig"]["gpuInstancing"])
+        renderer_config.rendering_config.gpu_instancing = gpu_instancing.as<bool>();
 
     renderer_config.bloom_config.enabled = config_node["bloomConfig"]["enabled"].as<bool>();
     renderer_config.bloom_config.threshold = config_node["bloomConfig"]["threshold"].as<float>();
@@ -346,6 +381,12 @@ std::shared_ptr<IAsset> SceneParser::parse(const YAML::Node& node, [[maybe_unuse
         EntityDeserializer::deserialize(entities[it.first], id, scene, m_manager);
     }
 
+    // Children can appear before their parents, so the hierarchy is linked once every entity exists
+    for (const auto& it : entities) {
+        const auto entity = scene->get_entity_with_uuid(UUID(it.first.as<uint64_t>()));
+        EntityDeserializer::deserialize_children(entities[it.first], entity, scene);
+    }
+
     return scene;
 }
 
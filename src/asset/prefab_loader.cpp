@@ -16,4 +16,11 @@ Entity PrefabLoader::load(const PrefabAsset& prefab,
     return EntityDeserializer::deserialize(components_node, UUID(), scene, asset_manager.get());
 }
 
+EntityHandle PrefabLoader::load(const PrefabAsset& prefab,
+                                EntityCommandBuffer& commands,
+                                const std::shared_ptr<AssetManagerBase>& asset_manager) {
+    const auto components_node = YAML::Load(prefab.components_string_representation);
+    return EntityDeserializer::deserialize(components_node, UUID(), commands, asset_manager.get());
+}
+
 } // namespace Phos
@@ -2,6 +2,8 @@
 
 #include <memory>
 
+#include "scene/entity_handle.h"
+
 namespace Phos {
 
 // Forward declarations
@@ -9,6 +11,7 @@ class Scene;
 class AssetManagerBase;
 class Entity;
 class PrefabAsset;
+class EntityCommandBuffer;
 
 class PrefabLoader {
   public:
@@ -17,6 +20,11 @@ class PrefabLoader {
     [[nodiscard]] static Entity load(const PrefabAsset& prefab,
                                      const std::shared_ptr<Scene>& scene,
                                      const std::shared_ptr<AssetManagerBase>& asset_manager);
+
+    /// Records the instantiation in the command buffer, the entity is created on the next flush
+    [[nodiscard]] static EntityHandle load(const PrefabAsset& prefab,
+                                           EntityCommandBuffer& commands,
+                                           const std::shared_ptr<AssetManagerBase>& asset_manager);
 };
 
 } // namespace Phos
@@ -5,6 +5,7 @@
 #include "utility/logging.h"
 #include "utility/profiling.h"
 #include "core/window.h"
+#include "core/job_system.h"
 #include "renderer/backend/renderer.h"
 #include "scripting/scripting_engine.h"
 
@@ -15,6 +16,8 @@ Application* Application::m_instance = nullptr;
 Application::Application(std::string_view title, uint32_t width, uint32_t height) {
     PHOS_LOG_SETUP;
 
+    JobSystem::initialize();
+
     m_window = std::make_shared<Window>(title, width, height);
     m_window->add_event_callback_func([&](Event& event) { on_event(event); });
 
@@ -35,6 +38,8 @@ Application::~Application() {
     ScriptingEngine::shutdown();
     Renderer::shutdown();
 
+    JobSystem::shutdown();
+
     m_instance = nullptr;
 }
 
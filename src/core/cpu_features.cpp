@@ -0,0 +1,77 @@
+#include "cpu_features.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PHOS_CPU_FEATURES_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+namespace Phos {
+
+#ifdef PHOS_CPU_FEATURES_X86
+
+#if defined(_MSC_VER)
+
+static bool cpu_supports_sse4() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+}
+
+static bool cpu_supports_avx2() {
+    int info[4];
+    __cpuid(info, 1);
+
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    if (!fma || !os_saves_ymm)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+#else
+
+static bool cpu_supports_sse4() {
+    return __builtin_cpu_supports("sse4.1");
+}
+
+static bool cpu_supports_avx2() {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+#endif
+
+#endif
+
+SimdBackend CpuFeatures::best_simd_backend() {
+    static const SimdBackend backend = [] {
+        if (supports(SimdBackend::AVX2))
+            return SimdBackend::AVX2;
+        if (supports(SimdBackend::SSE4))
+            return SimdBackend::SSE4;
+        return SimdBackend::Scalar;
+    }();
+
+    return backend;
+}
+
+bool CpuFeatures::supports(SimdBackend backend) {
+    switch (backend) {
+    case SimdBackend::Scalar:
+        return true;
+#ifdef PHOS_CPU_FEATURES_X86
+    case SimdBackend::SSE4:
+        return cpu_supports_sse4();
+    case SimdBackend::AVX2:
+        return cpu_supports_avx2();
+#endif
+    default:
+        return false;
+    }
+}
+
+} // namespace Phos
\ No newline at end of file
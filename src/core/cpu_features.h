@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Phos {
+
+/// Instruction sets the SIMD kernels of the engine are compiled for
+enum class SimdBackend {
+    Scalar,
+    SSE4,
+    AVX2,
+};
+
+class CpuFeatures {
+  public:
+    /// Widest backend supported by the CPU, detected on first use
+    [[nodiscard]] static SimdBackend best_simd_backend();
+    [[nodiscard]] static bool supports(SimdBackend backend);
+};
+
+} // namespace Phos
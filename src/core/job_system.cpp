@@ -0,0 +1,231 @@
+#include "job_system.h"
+
+#include <limits>
+#include <string>
+#include <algorithm>
+
+#include "utility/logging.h"
+#include "utility/profiling.h"
+
+namespace Phos {
+
+JobSystem::JobSystemContext JobSystem::m_context;
+
+// Index of the queue owned by the current thread, threads that are not workers have none
+static thread_local uint32_t s_worker_idx = std::numeric_limits<uint32_t>::max();
+
+//
+// JobCounter
+//
+
+void JobCounter::decrement() {
+    // Decrement under the lock, so that waiters (see JobSystem::wait) can not destroy the counter while it is in use
+    std::vector<std::pair<Job, JobCounter*>> dependents;
+    bool reached_zero = false;
+    {
+        const std::scoped_lock lock(m_mutex);
+        if (m_value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            dependents.swap(m_dependents);
+            reached_zero = true;
+        }
+    }
+
+    if (reached_zero)
+        JobSystem::notify_waiters();
+
+    // The signal counters were already incremented when the dependents were scheduled
+    for (auto& [job, signal] : dependents)
+        JobSystem::push(std::move(job), signal);
+}
+
+//
+// JobSystem
+//
+
+void JobSystem::initialize(uint32_t num_workers) {
+    if (num_workers == 0)
+        num_workers = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+
+    m_context.stopping = false;
+
+    for (uint32_t i = 0; i < num_workers; ++i)
+        m_context.queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (uint32_t i = 0; i < num_workers; ++i)
+        m_context.workers.emplace_back(worker_loop, i);
+
+    PHOS_LOG_INFO("Job system started with {} worker threads", num_workers);
+}
+
+void JobSystem::shutdown() {
+    {
+        const std::scoped_lock lock(m_context.sleep_mutex);
+        m_context.stopping = true;
+    }
+    m_context.sleep_cv.notify_all();
+
+    for (auto& worker : m_context.workers)
+        worker.join();
+
+    m_context.workers.clear();
+    m_context.queues.clear();
+    m_context.pending_jobs = 0;
+}
+
+void JobSystem::schedule(Job job, JobCounter* signal) {
+    if (signal != nullptr)
+        signal->increment();
+
+    push(std::move(job), signal);
+}
+
+void JobSystem::schedule_after(JobCounter& dependency, Job job, JobCounter* signal) {
+    if (signal != nullptr)
+        signal->increment();
+
+    {
+        const std::scoped_lock lock(dependency.m_mutex);
+        if (!dependency.is_zero()) {
+            dependency.m_dependents.emplace_back(std::move(job), signal);
+            return;
+        }
+    }
+
+    push(std::move(job), signal);
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    const auto preferred_queue = s_worker_idx != std::numeric_limits<uint32_t>::max() ? s_worker_idx : 0;
+
+    while (!counter.is_zero()) {
+        if (try_run_job(preferred_queue))
+            continue;
+
+        // Nothing to run, sleep until a job is pushed or a counter reaches zero
+        std::unique_lock lock(m_context.sleep_mutex);
+        m_context.sleep_cv.wait(lock, [&counter] { return m_context.pending_jobs > 0 || counter.is_zero(); });
+    }
+
+    // The last decrement may still be releasing the lock
+    const std::scoped_lock lock(counter.m_mutex);
+}
+
+void JobSystem::parallel_for(std::size_t count,
+                             std::size_t grain_size,
+                             const std::function<void(std::size_t, std::size_t)>& func) {
+    if (count == 0)
+        return;
+
+    // A few batches per thread, so that stealing can balance uneven work
+    const auto num_threads = static_cast<std::size_t>(number_workers()) + 1;
+    const auto batch_size = std::max({grain_size, (count + num_threads * 4 - 1) / (num_threads * 4), std::size_t{1}});
+
+    if (number_workers() == 0 || batch_size >= count) {
+        func(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (std::size_t begin = batch_size; begin < count; begin += batch_size) {
+        const auto end = std::min(begin + batch_size, count);
+        schedule([&func, begin, end] { func(begin, end); }, &counter);
+    }
+
+    // The calling thread takes the first batch instead of idling
+    func(0, batch_size);
+
+    wait(counter);
+}
+
+void JobSystem::worker_loop(uint32_t worker_idx) {
+    s_worker_idx = worker_idx;
+
+    [[maybe_unused]] const auto thread_name = "Worker " + std::to_string(worker_idx);
+    PHOS_PROFILE_SET_THREAD_NAME(thread_name.c_str());
+
+    while (true) {
+        if (try_run_job(worker_idx))
+            continue;
+
+        std::unique_lock lock(m_context.sleep_mutex);
+        m_context.sleep_cv.wait(lock, [] { return m_context.pending_jobs > 0 || m_context.stopping; });
+
+        if (m_context.stopping)
+            return;
+    }
+}
+
+void JobSystem::push(Job job, JobCounter* signal) {
+    if (m_context.queues.empty()) {
+        run(job, signal);
+        return;
+    }
+
+    // Workers keep their own jobs, other threads spread them over all the queues
+    const auto queue_idx = s_worker_idx != std::numeric_limits<uint32_t>::max()
+                               ? s_worker_idx
+                               : m_context.next_queue.fetch_add(1, std::memory_order_relaxed) % m_context.queues.size();
+
+    auto& queue = *m_context.queues[queue_idx];
+    {
+        const std::scoped_lock lock(queue.mutex);
+        queue.jobs.emplace_back(std::move(job), signal);
+    }
+
+    {
+        const std::scoped_lock lock(m_context.sleep_mutex);
+        ++m_context.pending_jobs;
+    }
+    m_context.sleep_cv.notify_one();
+}
+
+void JobSystem::notify_waiters() {
+    // Taking the lock makes sure that a waiter is either already sleeping or will see the counter at zero
+    {
+        const std::scoped_lock lock(m_context.sleep_mutex);
+    }
+    m_context.sleep_cv.notify_all();
+}
+
+bool JobSystem::try_run_job(uint32_t preferred_queue) {
+    const auto num_queues = static_cast<uint32_t>(m_context.queues.size());
+
+    for (uint32_t i = 0; i < num_queues; ++i) {
+        const auto queue_idx = (preferred_queue + i) % num_queues;
+        auto& queue = *m_context.queues[queue_idx];
+
+        std::pair<Job, JobCounter*> entry;
+        {
+            const std::scoped_lock lock(queue.mutex);
+            if (queue.jobs.empty())
+                continue;
+
+            // Newest job from the own queue (still warm in cache), oldest when stealing
+            if (queue_idx == s_worker_idx) {
+                entry = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+            } else {
+                entry = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            }
+        }
+
+        --m_context.pending_jobs;
+        run(entry.first, entry.second);
+        return true;
+    }
+
+    return false;
+}
+
+void JobSystem::run(Job& job, JobCounter* signal) {
+    {
+        PHOS_PROFILE_ZONE_SCOPED_NAMED("Job");
+        job();
+    }
+
+    if (signal != nullptr)
+        signal->decrement();
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+namespace Phos {
+
+using Job = std::function<void()>;
+
+/// Counts the jobs that have not finished yet. Jobs can be scheduled to run after a counter reaches zero, which is
+/// how dependencies between jobs are expressed. A counter must outlive the jobs that signal or wait for it.
+class JobCounter {
+  public:
+    JobCounter() = default;
+    ~JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    [[nodiscard]] bool is_zero() const { return m_value.load(std::memory_order_acquire) == 0; }
+
+  private:
+    std::atomic<uint32_t> m_value = 0;
+
+    // Jobs waiting for the counter to reach zero
+    mutable std::mutex m_mutex;
+    std::vector<std::pair<Job, JobCounter*>> m_dependents;
+
+    void increment() { m_value.fetch_add(1, std::memory_order_relaxed); }
+    void decrement();
+
+    friend class JobSystem;
+};
+
+/// Work-stealing job system. Every worker thread owns a deque: it pushes and pops its own jobs from the back, and
+/// steals from the front of the other workers' deques when it runs out of work.
+class JobSystem {
+  public:
+    JobSystem() = delete;
+
+    /// Starts num_workers threads, or one less than the number of hardware threads if 0.
+    /// Without workers (not initialized, or a single core), jobs run inline on the scheduling thread.
+    static void initialize(uint32_t num_workers = 0);
+    static void shutdown();
+
+    /// Schedules a job. If signal is given, it is incremented now and decremented once the job has finished.
+    static void schedule(Job job, JobCounter* signal = nullptr);
+    /// Schedules a job that will not start until dependency reaches zero
+    static void schedule_after(JobCounter& dependency, Job job, JobCounter* signal = nullptr);
+
+    /// Blocks until the counter reaches zero, running other jobs in the meantime and sleeping when there are none
+    static void wait(const JobCounter& counter);
+
+    /// Calls func(begin, end) over batches covering [0, count) and waits for all of them.
+    /// Batches are at least grain_size elements long, grain_size should be large enough to amortize scheduling.
+    static void parallel_for(std::size_t count,
+                             std::size_t grain_size,
+                             const std::function<void(std::size_t begin, std::size_t end)>& func);
+
+    [[nodiscard]] static uint32_t number_workers() { return static_cast<uint32_t>(m_context.workers.size()); }
+
+  private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::pair<Job, JobCounter*>> jobs;
+    };
+
+    struct JobSystemContext {
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+        std::atomic<uint32_t> pending_jobs = 0;
+        std::atomic<uint32_t> next_queue = 0;
+        std::atomic<bool> stopping = false;
+
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+    };
+
+    static JobSystemContext m_context;
+
+    static void worker_loop(uint32_t worker_idx);
+    static void push(Job job, JobCounter* signal);
+    // Wakes the threads sleeping in wait, called when a counter reaches zero
+    static void notify_waiters();
+    static bool try_run_job(uint32_t preferred_queue);
+    static void run(Job& job, JobCounter* signal);
+
+    friend class JobCounter;
+};
+
+} // namespace Phos
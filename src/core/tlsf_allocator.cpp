@@ -0,0 +1,263 @@
+#include "tlsf_allocator.h"
+
+#include <bit>
+
+#include "utility/logging.h"
+
+namespace Phos {
+
+TLSFAllocator::TLSFAllocator(uint64_t size) : m_size(size) {
+    PHOS_ASSERT(size > 0, "TLSFAllocator size must be greater than 0");
+
+    for (auto& lists : m_free_lists)
+        lists.fill(INVALID_NODE);
+
+    [[maybe_unused]] const auto first = create_node(0, size);
+    PHOS_ASSERT(first == FIRST_NODE, "First node of TLSFAllocator must have id {}", FIRST_NODE);
+
+    insert_free(FIRST_NODE);
+}
+
+std::optional<TLSFAllocator::Allocation> TLSFAllocator::allocate(uint64_t size, uint64_t alignment) {
+    PHOS_ASSERT(size > 0, "Allocation size must be greater than 0");
+    PHOS_ASSERT(std::has_single_bit(alignment), "Alignment {} is not a power of two", alignment);
+
+    // Enough space to align the start of any free range
+    const auto padded_size = size + alignment - 1;
+    if (padded_size > m_size)
+        return std::nullopt;
+
+    uint32_t fl, sl;
+    if (!find_free(padded_size, fl, sl))
+        return std::nullopt;
+
+    auto node = m_free_lists[fl][sl];
+    remove_free(node);
+
+    // Front padding stays free, it can not be merged with the previous range as free ranges are never neighbours
+    const auto offset = m_nodes[node].offset;
+    const auto aligned_offset = (offset + alignment - 1) & ~(alignment - 1);
+    if (aligned_offset != offset) {
+        const auto padding = node;
+        node = split(padding, aligned_offset - offset);
+        insert_free(padding);
+    }
+
+    // Same with the remaining space at the end
+    if (m_nodes[node].size > size) {
+        const auto remaining = split(node, size);
+        insert_free(remaining);
+    }
+
+    m_nodes[node].free = false;
+    m_used += size;
+    ++m_allocation_count;
+
+    return Allocation{.offset = aligned_offset, .node = node};
+}
+
+void TLSFAllocator::free(NodeId node) {
+    PHOS_ASSERT(node < m_nodes.size() && !m_nodes[node].free, "Node {} is not allocated", node);
+
+    m_nodes[node].free = true;
+    m_used -= m_nodes[node].size;
+    --m_allocation_count;
+
+    const auto next = m_nodes[node].next_physical;
+    if (next != INVALID_NODE && m_nodes[next].free) {
+        remove_free(next);
+        merge(node, next);
+    }
+
+    const auto prev = m_nodes[node].prev_physical;
+    if (prev != INVALID_NODE && m_nodes[prev].free) {
+        remove_free(prev);
+        merge(prev, node);
+        node = prev;
+    }
+
+    insert_free(node);
+}
+
+bool TLSFAllocator::validate() const {
+    uint64_t expected_offset = 0;
+    uint64_t used = 0;
+    uint32_t allocations = 0;
+    uint32_t free_nodes = 0;
+
+    bool previous_free = false;
+    for (auto node = FIRST_NODE; node != INVALID_NODE; node = m_nodes[node].next_physical) {
+        const auto& info = m_nodes[node];
+
+        if (info.offset != expected_offset || info.size == 0)
+            return false;
+        if (info.next_physical != INVALID_NODE && m_nodes[info.next_physical].prev_physical != node)
+            return false;
+        if (info.free && previous_free)
+            return false;
+
+        if (info.free) {
+            ++free_nodes;
+        } else {
+            used += info.size;
+            ++allocations;
+        }
+
+        expected_offset += info.size;
+        previous_free = info.free;
+    }
+
+    if (expected_offset != m_size || used != m_used || allocations != m_allocation_count)
+        return false;
+
+    uint32_t listed_nodes = 0;
+    for (uint32_t fl = 0; fl < FL_COUNT; ++fl) {
+        const bool fl_set = (m_fl_bitmap >> fl) & 1;
+        if (fl_set != (m_sl_bitmaps[fl] != 0))
+            return false;
+
+        for (uint32_t sl = 0; sl < SL_COUNT; ++sl) {
+            const bool sl_set = (m_sl_bitmaps[fl] >> sl) & 1;
+            if (sl_set != (m_free_lists[fl][sl] != INVALID_NODE))
+                return false;
+
+            for (auto node = m_free_lists[fl][sl]; node != INVALID_NODE; node = m_nodes[node].next_free) {
+                uint32_t node_fl, node_sl;
+                mapping(m_nodes[node].size, node_fl, node_sl);
+
+                if (!m_nodes[node].free || node_fl != fl || node_sl != sl)
+                    return false;
+
+                ++listed_nodes;
+            }
+        }
+    }
+
+    return listed_nodes == free_nodes;
+}
+
+TLSFAllocator::NodeId TLSFAllocator::create_node(uint64_t offset, uint64_t size) {
+    const auto node = Node{.offset = offset, .size = size};
+
+    if (!m_unused_nodes.empty()) {
+        const auto id = m_unused_nodes.back();
+        m_unused_nodes.pop_back();
+
+        m_nodes[id] = node;
+        return id;
+    }
+
+    m_nodes.push_back(node);
+    return static_cast<NodeId>(m_nodes.size() - 1);
+}
+
+void TLSFAllocator::release_node(NodeId node) {
+    m_unused_nodes.push_back(node);
+}
+
+TLSFAllocator::NodeId TLSFAllocator::split(NodeId node, uint64_t size) {
+    PHOS_ASSERT(size < m_nodes[node].size, "Split size must be smaller than the node");
+
+    const auto second = create_node(m_nodes[node].offset + size, m_nodes[node].size - size);
+
+    // m_nodes might have been reallocated by create_node
+    auto& first_info = m_nodes[node];
+    auto& second_info = m_nodes[second];
+
+    first_info.size = size;
+
+    second_info.prev_physical = node;
+    second_info.next_physical = first_info.next_physical;
+    if (second_info.next_physical != INVALID_NODE)
+        m_nodes[second_info.next_physical].prev_physical = second;
+    first_info.next_physical = second;
+
+    return second;
+}
+
+void TLSFAllocator::merge(NodeId node, NodeId next) {
+    auto& info = m_nodes[node];
+    const auto& next_info = m_nodes[next];
+
+    info.size += next_info.size;
+    info.next_physical = next_info.next_physical;
+    if (info.next_physical != INVALID_NODE)
+        m_nodes[info.next_physical].prev_physical = node;
+
+    release_node(next);
+}
+
+void TLSFAllocator::insert_free(NodeId node) {
+    uint32_t fl, sl;
+    mapping(m_nodes[node].size, fl, sl);
+
+    auto& info = m_nodes[node];
+    info.free = true;
+    info.prev_free = INVALID_NODE;
+    info.next_free = m_free_lists[fl][sl];
+
+    if (info.next_free != INVALID_NODE)
+        m_nodes[info.next_free].prev_free = node;
+    m_free_lists[fl][sl] = node;
+
+    m_fl_bitmap |= uint64_t{1} << fl;
+    m_sl_bitmaps[fl] |= 1u << sl;
+}
+
+void TLSFAllocator::remove_free(NodeId node) {
+    uint32_t fl, sl;
+    mapping(m_nodes[node].size, fl, sl);
+
+    const auto& info = m_nodes[node];
+    if (info.prev_free != INVALID_NODE)
+        m_nodes[info.prev_free].next_free = info.next_free;
+    else
+        m_free_lists[fl][sl] = info.next_free;
+
+    if (info.next_free != INVALID_NODE)
+        m_nodes[info.next_free].prev_free = info.prev_free;
+
+    if (m_free_lists[fl][sl] == INVALID_NODE) {
+        m_sl_bitmaps[fl] &= ~(1u << sl);
+        if (m_sl_bitmaps[fl] == 0)
+            m_fl_bitmap &= ~(uint64_t{1} << fl);
+    }
+}
+
+void TLSFAllocator::mapping(uint64_t size, uint32_t& fl, uint32_t& sl) {
+    // Sizes smaller than SL_COUNT have a size class each
+    if (size < SL_COUNT) {
+        fl = 0;
+        sl = static_cast<uint32_t>(size);
+        return;
+    }
+
+    const auto msb = static_cast<uint32_t>(std::bit_width(size)) - 1;
+    fl = msb - SL_BITS + 1;
+    sl = static_cast<uint32_t>(size >> (msb - SL_BITS)) - SL_COUNT;
+}
+
+bool TLSFAllocator::find_free(uint64_t size, uint32_t& fl, uint32_t& sl) const {
+    // Rounding up to the next size class, so that any range of the class is big enough
+    if (size >= SL_COUNT) {
+        const auto msb = static_cast<uint32_t>(std::bit_width(size)) - 1;
+        size += (uint64_t{1} << (msb - SL_BITS)) - 1;
+    }
+    mapping(size, fl, sl);
+
+    auto sl_bitmap = m_sl_bitmaps[fl] & (~0u << sl);
+    if (sl_bitmap == 0) {
+        // Smallest bigger first level
+        const auto fl_bitmap = fl + 1 < FL_COUNT ? m_fl_bitmap & (~uint64_t{0} << (fl + 1)) : 0;
+        if (fl_bitmap == 0)
+            return false;
+
+        fl = static_cast<uint32_t>(std::countr_zero(fl_bitmap));
+        sl_bitmap = m_sl_bitmaps[fl];
+    }
+
+    sl = static_cast<uint32_t>(std::countr_zero(sl_bitmap));
+    return true;
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+namespace Phos {
+
+/// Two-Level Segregated Fit allocator of ranges inside of a block of a fixed size. It only manages offsets, the
+/// memory itself is owned by the user (for example a VkDeviceMemory). Free ranges are kept in lists indexed by size
+/// class, with the first level being the power of two of the size and the second level dividing it in SL_COUNT
+/// linear steps, so that both allocations and frees run in constant time. Neighbouring free ranges are merged.
+class TLSFAllocator {
+  public:
+    using NodeId = uint32_t;
+    static constexpr NodeId INVALID_NODE = UINT32_MAX;
+
+    static constexpr uint32_t SL_BITS = 4;
+    static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+    static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+
+    struct Allocation {
+        uint64_t offset;
+        // Identifies the allocation when freeing it
+        NodeId node;
+    };
+
+    explicit TLSFAllocator(uint64_t size);
+    ~TLSFAllocator() = default;
+
+    /// Returns std::nullopt if there is no free range big enough. alignment must be a power of two.
+    [[nodiscard]] std::optional<Allocation> allocate(uint64_t size, uint64_t alignment = 1);
+    void free(NodeId node);
+
+    [[nodiscard]] uint64_t size() const { return m_size; }
+    [[nodiscard]] uint64_t used() const { return m_used; }
+    [[nodiscard]] uint32_t allocation_count() const { return m_allocation_count; }
+    [[nodiscard]] bool empty() const { return m_allocation_count == 0; }
+
+    /// Checks that the ranges cover the block without overlapping, that no two free ranges are neighbours and that
+    /// every free range is in the list of its size class. Used for testing.
+    [[nodiscard]] bool validate() const;
+
+  private:
+    struct Node {
+        uint64_t offset;
+        uint64_t size;
+
+        // Neighbouring ranges in the block
+        NodeId prev_physical = INVALID_NODE;
+        NodeId next_physical = INVALID_NODE;
+
+        // Neighbours in the free list of the size class, only used by free nodes
+        NodeId prev_free = INVALID_NODE;
+        NodeId next_free = INVALID_NODE;
+
+        bool free = true;
+    };
+
+    uint64_t m_size;
+    uint64_t m_used = 0;
+    uint32_t m_allocation_count = 0;
+
+    // The node with offset 0 is always the first one, ranges are merged into their previous neighbour
+    static constexpr NodeId FIRST_NODE = 0;
+
+    std::vector<Node> m_nodes;
+    std::vector<NodeId> m_unused_nodes;
+
+    // Bit fl of m_fl_bitmap is set if any list of m_sl_bitmaps[fl] is not empty
+    uint64_t m_fl_bitmap = 0;
+    std::array<uint32_t, FL_COUNT> m_sl_bitmaps{};
+    std::array<std::array<NodeId, SL_COUNT>, FL_COUNT> m_free_lists{};
+
+    [[nodiscard]] NodeId create_node(uint64_t offset, uint64_t size);
+    void release_node(NodeId node);
+
+    // Splits node at size, the second half is a new node that is returned
+    [[nodiscard]] NodeId split(NodeId node, uint64_t size);
+    // Merges next into node, next must follow node in the block
+    void merge(NodeId node, NodeId next);
+
+    void insert_free(NodeId node);
+    void remove_free(NodeId node);
+
+    // Size class containing size
+    static void mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+    // First non empty size class whose ranges are all at least as big as size
+    [[nodiscard]] bool find_free(uint64_t size, uint32_t& fl, uint32_t& sl) const;
+};
+
+} // namespace Phos
@@ -1,8 +1,13 @@
 #include "shader_manager.h"
 
+#include <array>
+#include <vector>
 #include <filesystem>
+#include <string_view>
 
 #include "utility/logging.h"
+#include "utility/profiling.h"
+#include "core/job_system.h"
 #include "renderer/backend/shader.h"
 
 namespace Phos {
@@ -13,41 +18,55 @@ namespace Phos {
 
 #define SHADER_PATH(name) (std::filesystem::path(PHOS_BASE_SHADER_PATH) / name).string()
 
-ShaderManager::ShaderManager() {
-    // PBR Deferred Shaders
-    const auto pbr_geometry_deferred =
-        Shader::create(SHADER_PATH("PBR.Geometry.Deferred.Vert.spv"), SHADER_PATH("PBR.Geometry.Deferred.Frag.spv"));
-    const auto pbr_lighting_deferred =
-        Shader::create(SHADER_PATH("PBR.Lighting.Deferred.Vert.spv"), SHADER_PATH("PBR.Lighting.Deferred.Frag.spv"));
+struct BuiltinShader {
+    std::string_view name;
+    // Compute shaders only have the first stage
+    std::string_view vertex_or_compute;
+    std::string_view fragment;
+};
 
-    m_builtin_shaders.insert(std::make_pair("PBR.Geometry.Deferred", pbr_geometry_deferred));
-    m_builtin_shaders.insert(std::make_pair("PBR.Lighting.Deferred", pbr_lighting_deferred));
+// Every builtin shader, loaded when the ShaderManager is created
+constexpr std::array BUILTIN_SHADERS = {
+    // PBR Deferred Shaders
+    BuiltinShader{"PBR.Geometry.Deferred", "PBR.Geometry.Deferred.Vert.spv", "PBR.Geometry.Deferred.Frag.spv"},
+    BuiltinShader{"PBR.Lighting.Deferred", "PBR.Lighting.Deferred.Vert.spv", "PBR.Lighting.Deferred.Frag.spv"},
 
     // PBR Forward Shaders
-    const auto pbr_forward = Shader::create(SHADER_PATH("PBR.Forward.Vert.spv"), SHADER_PATH("PBR.Forward.Frag.spv"));
-
-    m_builtin_shaders.insert(std::make_pair("PBR.Forward", pbr_forward));
+    BuiltinShader{"PBR.Forward", "PBR.Forward.Vert.spv", "PBR.Forward.Frag.spv"},
 
     // Base Shaders
-    const auto skybox = Shader::create(SHADER_PATH("Skybox.Vert.spv"), SHADER_PATH("Skybox.Frag.spv"));
-    const auto blending = Shader::create(SHADER_PATH("Blending.Vert.spv"), SHADER_PATH("Blending.Frag.spv"));
-    const auto shadow_map = Shader::create(SHADER_PATH("ShadowMap.Vert.spv"), SHADER_PATH("ShadowMap.Frag.spv"));
-
-    m_builtin_shaders.insert(std::make_pair("Skybox", skybox));
-    m_builtin_shaders.insert(std::make_pair("Blending", blending));
-    m_builtin_shaders.insert(std::make_pair("ShadowMap", shadow_map));
+    BuiltinShader{"Skybox", "Skybox.Vert.spv", "Skybox.Frag.spv"},
+    BuiltinShader{"Blending", "Blending.Vert.spv", "Blending.Frag.spv"},
+    BuiltinShader{"ShadowMap", "ShadowMap.Vert.spv", "ShadowMap.Frag.spv"},
 
     // Post Processing
-    const auto tone_mapping = Shader::create(SHADER_PATH("ToneMapping.Vert.spv"), SHADER_PATH("ToneMapping.Frag.spv"));
-    const auto bloom = Shader::create(SHADER_PATH("Bloom.Compute.spv"));
-
-    m_builtin_shaders.insert(std::make_pair("ToneMapping", tone_mapping));
-    m_builtin_shaders.insert(std::make_pair("Bloom", bloom));
+    BuiltinShader{"ToneMapping", "ToneMapping.Vert.spv", "ToneMapping.Frag.spv"},
+    BuiltinShader{"Bloom", "Bloom.Compute.spv", ""},
 
     // Other
-    const auto equirectangular_to_cubemap = Shader::create(SHADER_PATH("EquirectangularToCubemap.Compute.spv"));
+    BuiltinShader{"EquirectangularToCubemap", "EquirectangularToCubemap.Compute.spv", ""},
+};
+
+ShaderManager::ShaderManager() {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("ShaderManager::ShaderManager");
+
+    // Reading, creating the modules and reflecting every shader is independent from the other shaders
+    std::vector<std::shared_ptr<Shader>> shaders(BUILTIN_SHADERS.size());
+
+    JobSystem::parallel_for(BUILTIN_SHADERS.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t shader_idx = begin; shader_idx < end; ++shader_idx) {
+            const auto& description = BUILTIN_SHADERS[shader_idx];
+
+            if (description.fragment.empty())
+                shaders[shader_idx] = Shader::create(SHADER_PATH(description.vertex_or_compute));
+            else
+                shaders[shader_idx] =
+                    Shader::create(SHADER_PATH(description.vertex_or_compute), SHADER_PATH(description.fragment));
+        }
+    });
 
-    m_builtin_shaders.insert(std::make_pair("EquirectangularToCubemap", equirectangular_to_cubemap));
+    for (std::size_t shader_idx = 0; shader_idx < BUILTIN_SHADERS.size(); ++shader_idx)
+        m_builtin_shaders.insert(std::make_pair(std::string(BUILTIN_SHADERS[shader_idx].name), shaders[shader_idx]));
 }
 
 std::shared_ptr<Shader> ShaderManager::get_builtin_shader(const std::string& name) const {
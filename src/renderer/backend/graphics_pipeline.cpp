@@ -17,4 +17,14 @@ std::shared_ptr<GraphicsPipeline> GraphicsPipeline::create(const Phos::GraphicsP
     }
 }
 
+std::vector<std::shared_ptr<GraphicsPipeline>> GraphicsPipeline::create_batch(
+    std::span<const Description> descriptions) {
+    switch (Renderer::graphics_api()) {
+    case GraphicsAPI::Vulkan:
+        return VulkanGraphicsPipeline::create_batch(descriptions);
+    default:
+        PHOS_FAIL("Vulkan is the only supported api");
+    }
+}
+
 } // namespace Phos
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <vector>
+#include <span>
 #include <string_view>
 
 namespace Phos {
@@ -47,6 +48,9 @@ class GraphicsPipeline {
     virtual ~GraphicsPipeline() = default;
 
     static std::shared_ptr<GraphicsPipeline> create(const Description& description);
+    /// Creates the pipelines of several descriptions at once, faster than creating them one by one.
+    /// Pipelines are returned in the same order as descriptions.
+    static std::vector<std::shared_ptr<GraphicsPipeline>> create_batch(std::span<const Description> descriptions);
 
     [[nodiscard]] virtual bool bake() = 0;
     [[nodiscard]] virtual std::shared_ptr<Framebuffer> target_framebuffer() const = 0;
@@ -61,6 +61,39 @@ void Renderer::submit_static_mesh(const std::shared_ptr<CommandBuffer>& command_
     m_native_renderer->submit_static_mesh(command_buffer, mesh, material);
 }
 
+void Renderer::submit_static_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                                  const std::shared_ptr<StaticMesh>& mesh,
+                                  const std::shared_ptr<Material>& material,
+                                  std::span<const uint32_t> sub_meshes) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("Renderer::submit_static_mesh");
+    m_native_renderer->submit_static_mesh(command_buffer, mesh, material, sub_meshes);
+}
+
+void Renderer::bind_material(const std::shared_ptr<CommandBuffer>& command_buffer,
+                             const std::shared_ptr<Material>& material) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("Renderer::bind_material");
+    m_native_renderer->bind_material(command_buffer, material);
+}
+
+void Renderer::bind_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                             const std::shared_ptr<SubMesh>& sub_mesh) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("Renderer::bind_sub_mesh");
+    m_native_renderer->bind_sub_mesh(command_buffer, sub_mesh);
+}
+
+void Renderer::draw_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                             const std::shared_ptr<SubMesh>& sub_mesh,
+                             uint32_t first_instance,
+                             uint32_t instance_count) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("Renderer::draw_sub_mesh");
+    m_native_renderer->draw_sub_mesh(command_buffer, sub_mesh, first_instance, instance_count);
+}
+
+void Renderer::update_instances(std::span<const InstanceData> instances) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("Renderer::update_instances");
+    m_native_renderer->update_instances(instances);
+}
+
 void Renderer::bind_graphics_pipeline(const std::shared_ptr<CommandBuffer>& command_buffer,
                                       const std::shared_ptr<GraphicsPipeline>& pipeline) {
     PHOS_PROFILE_ZONE_SCOPED_NAMED("Renderer::bind_graphics_pipeline");
@@ -91,4 +124,8 @@ uint32_t Renderer::current_frame() {
     return m_native_renderer->current_frame();
 }
 
+std::vector<GpuMemoryHeapStatistics> Renderer::memory_statistics() {
+    return m_native_renderer->memory_statistics();
+}
+
 } // namespace Phos
@@ -2,11 +2,16 @@
 
 #include <memory>
 #include <vector>
+#include <span>
+#include <filesystem>
+#include <cstdint>
+#include <glm/glm.hpp>
 
 namespace Phos {
 
 // Forward declarations
 class StaticMesh;
+class SubMesh;
 class CommandBuffer;
 class RenderPass;
 class GraphicsPipeline;
@@ -28,6 +33,9 @@ struct RendererConfig {
     std::shared_ptr<Window> window;
 
     uint32_t num_frames;
+
+    // File where compiled pipelines are kept between runs, the cache directory of the user if empty
+    std::filesystem::path pipeline_cache_path;
 };
 
 struct FrameInformation {
@@ -35,6 +43,25 @@ struct FrameInformation {
     std::vector<std::shared_ptr<Light>> lights;
 };
 
+// Should match with "shaders/include/InstanceData.Vertex.glslh"
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 color;
+};
+
+/// Device memory of a heap. Reserved bytes are the ones allocated from the driver, of which used bytes are bound to
+/// resources.
+struct GpuMemoryHeapStatistics {
+    uint64_t heap_size = 0;
+    bool device_local = false;
+
+    uint64_t reserved_bytes = 0;
+    uint64_t used_bytes = 0;
+    // Resources with memory in the heap, and allocations made to the driver
+    uint32_t allocations = 0;
+    uint32_t device_allocations = 0;
+};
+
 class INativeRenderer {
   public:
     virtual ~INativeRenderer() = default;
@@ -47,6 +74,26 @@ class INativeRenderer {
                                     const std::shared_ptr<StaticMesh>& mesh,
                                     const std::shared_ptr<Material>& material) = 0;
 
+    /// Only draws the sub meshes whose index is in sub_meshes
+    virtual void submit_static_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                                    const std::shared_ptr<StaticMesh>& mesh,
+                                    const std::shared_ptr<Material>& material,
+                                    std::span<const uint32_t> sub_meshes) = 0;
+
+    virtual void bind_material(const std::shared_ptr<CommandBuffer>& command_buffer,
+                               const std::shared_ptr<Material>& material) = 0;
+    virtual void bind_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                               const std::shared_ptr<SubMesh>& sub_mesh) = 0;
+    /// Draws instance_count instances of sub_mesh with the state already bound, sub_mesh must be the last bound sub
+    /// mesh. Instanced shaders read the instances [first_instance, first_instance + instance_count).
+    virtual void draw_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                               const std::shared_ptr<SubMesh>& sub_mesh,
+                               uint32_t first_instance,
+                               uint32_t instance_count) = 0;
+
+    /// Replaces the instance data of the current frame, must be called before the frame descriptors are bound
+    virtual void update_instances(std::span<const InstanceData> instances) = 0;
+
     virtual void bind_graphics_pipeline(const std::shared_ptr<CommandBuffer>& command_buffer,
                                         const std::shared_ptr<GraphicsPipeline>& pipeline) = 0;
 
@@ -61,6 +108,7 @@ class INativeRenderer {
     virtual void draw_screen_quad(const std::shared_ptr<CommandBuffer>& command_buffer) = 0;
 
     [[nodiscard]] virtual uint32_t current_frame() = 0;
+    [[nodiscard]] virtual std::vector<GpuMemoryHeapStatistics> memory_statistics() = 0;
 };
 
 // Should match with values in "shaders/LightInformation.glslh"
@@ -80,6 +128,25 @@ class Renderer {
                                    const std::shared_ptr<StaticMesh>& mesh,
                                    const std::shared_ptr<Material>& material);
 
+    /// Only draws the sub meshes whose index is in sub_meshes, for example the ones that passed culling
+    static void submit_static_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                                   const std::shared_ptr<StaticMesh>& mesh,
+                                   const std::shared_ptr<Material>& material,
+                                   std::span<const uint32_t> sub_meshes);
+
+    /// Fine grained alternative to submit_static_mesh, used by RenderQueue to skip state that is already bound
+    static void bind_material(const std::shared_ptr<CommandBuffer>& command_buffer,
+                              const std::shared_ptr<Material>& material);
+    static void bind_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                              const std::shared_ptr<SubMesh>& sub_mesh);
+    static void draw_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                              const std::shared_ptr<SubMesh>& sub_mesh,
+                              uint32_t first_instance,
+                              uint32_t instance_count);
+
+    /// Per instance data of the frame, read by instanced shaders with gl_InstanceIndex
+    static void update_instances(std::span<const InstanceData> instances);
+
     static void bind_graphics_pipeline(const std::shared_ptr<CommandBuffer>& command_buffer,
                                        const std::shared_ptr<GraphicsPipeline>& pipeline);
 
@@ -94,6 +161,8 @@ class Renderer {
     static void draw_screen_quad(const std::shared_ptr<CommandBuffer>& command_buffer);
 
     [[nodiscard]] static uint32_t current_frame();
+    /// Live memory usage of every heap of the device
+    [[nodiscard]] static std::vector<GpuMemoryHeapStatistics> memory_statistics();
     static GraphicsAPI graphics_api() { return m_config.graphics_api; }
 
     static const RendererConfig& config() { return m_config; }
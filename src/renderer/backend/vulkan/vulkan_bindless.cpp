@@ -0,0 +1,230 @@
+#include "vulkan_bindless.h"
+
+#include <array>
+#include <algorithm>
+
+#include "utility/logging.h"
+
+#include "vk_core.h"
+
+#include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_device.h"
+#include "renderer/backend/vulkan/vulkan_buffer.h"
+#include "renderer/backend/vulkan/vulkan_texture.h"
+#include "renderer/backend/vulkan/vulkan_image.h"
+
+namespace Phos {
+
+constexpr uint32_t MATERIAL_WORD_SIZE = 4;
+
+VulkanBindlessResources::VulkanBindlessResources() {
+    const auto device = VulkanContext::device->handle();
+
+    // Descriptor set layout
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+    bindings[0].binding = TEXTURES_BINDING;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = MAX_TEXTURES;
+    bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+
+    bindings[1].binding = MATERIALS_BINDING;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+    // Textures are added while the set is in use by command buffers, and most of the array is never written
+    const std::array<VkDescriptorBindingFlags, 2> binding_flags = {
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+            | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+        0,
+    };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{};
+    binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    binding_flags_info.bindingCount = static_cast<uint32_t>(binding_flags.size());
+    binding_flags_info.pBindingFlags = binding_flags.data();
+
+    VkDescriptorSetLayoutCreateInfo layout_info{};
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.pNext = &binding_flags_info;
+    layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    layout_info.pBindings = bindings.data();
+
+    VK_CHECK(vkCreateDescriptorSetLayout(device, &layout_info, nullptr, &m_layout));
+
+    // Descriptor pool, only used by the bindless set
+    const std::array<VkDescriptorPoolSize, 2> pool_sizes = {
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_TEXTURES},
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},
+    };
+
+    VkDescriptorPoolCreateInfo pool_info{};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    pool_info.maxSets = 1;
+    pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    pool_info.pPoolSizes = pool_sizes.data();
+
+    VK_CHECK(vkCreateDescriptorPool(device, &pool_info, nullptr, &m_pool));
+
+    VkDescriptorSetAllocateInfo allocate_info{};
+    allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocate_info.descriptorPool = m_pool;
+    allocate_info.descriptorSetCount = 1;
+    allocate_info.pSetLayouts = &m_layout;
+
+    VK_CHECK(vkAllocateDescriptorSets(device, &allocate_info, &m_set));
+
+    // Material buffer
+    m_material_buffer =
+        std::make_unique<VulkanBuffer>(MATERIAL_BUFFER_SIZE,
+                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    void* material_memory;
+    m_material_buffer->map_memory(material_memory);
+    m_material_memory = static_cast<char*>(material_memory);
+
+    m_used_material_words.resize(MATERIAL_BUFFER_SIZE / MATERIAL_WORD_SIZE, false);
+
+    VkDescriptorBufferInfo buffer_info{};
+    buffer_info.buffer = m_material_buffer->handle();
+    buffer_info.offset = 0;
+    buffer_info.range = MATERIAL_BUFFER_SIZE;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = m_set;
+    write.dstBinding = MATERIALS_BINDING;
+    write.dstArrayElement = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &buffer_info;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+VulkanBindlessResources::~VulkanBindlessResources() {
+    m_material_buffer.reset();
+
+    // Destroying the pool frees the set
+    vkDestroyDescriptorPool(VulkanContext::device->handle(), m_pool, nullptr);
+    vkDestroyDescriptorSetLayout(VulkanContext::device->handle(), m_layout, nullptr);
+}
+
+uint32_t VulkanBindlessResources::acquire_texture(const std::shared_ptr<VulkanTexture>& texture) {
+    std::scoped_lock lock(m_mutex);
+
+    const auto it = m_texture_slots.find(texture.get());
+    if (it != m_texture_slots.end()) {
+        ++it->second.references;
+        return it->second.index;
+    }
+
+    uint32_t index;
+    if (!m_free_texture_indices.empty()) {
+        index = m_free_texture_indices.back();
+        m_free_texture_indices.pop_back();
+    } else {
+        PHOS_ASSERT(m_next_texture_idx < MAX_TEXTURES, "Reached maximum number of bindless textures");
+        index = m_next_texture_idx++;
+    }
+
+    write_texture(index, *texture);
+    m_texture_slots.insert({texture.get(), TextureSlot{.index = index, .references = 1}});
+
+    return index;
+}
+
+void VulkanBindlessResources::release_texture(const std::shared_ptr<VulkanTexture>& texture) {
+    std::scoped_lock lock(m_mutex);
+
+    const auto it = m_texture_slots.find(texture.get());
+    PHOS_ASSERT(it != m_texture_slots.end(), "Texture was not acquired");
+
+    // The descriptor is left as is, it is overwritten when the index is reused
+    if (--it->second.references == 0) {
+        current_retired().texture_indices.push_back(it->second.index);
+        m_texture_slots.erase(it);
+    }
+}
+
+uint32_t VulkanBindlessResources::allocate_material(uint32_t stride) {
+    PHOS_ASSERT(stride > 0 && stride % MATERIAL_WORD_SIZE == 0, "Material stride ({}) is not valid", stride);
+
+    std::scoped_lock lock(m_mutex);
+
+    // Materials are indexed as an array of their own struct, so they can only start at multiples of their stride
+    const auto words = stride / MATERIAL_WORD_SIZE;
+    const auto count = static_cast<uint32_t>(MATERIAL_BUFFER_SIZE / stride);
+
+    for (uint32_t index = 0; index < count; ++index) {
+        const auto begin = m_used_material_words.begin() + index * words;
+        if (std::find(begin, begin + words, true) != begin + words)
+            continue;
+
+        std::fill(begin, begin + words, true);
+        return index;
+    }
+
+    PHOS_FAIL("Material buffer is full");
+    return 0;
+}
+
+void VulkanBindlessResources::free_material(uint32_t index, uint32_t stride) {
+    std::scoped_lock lock(m_mutex);
+    current_retired().materials.push_back(RetiredMaterial{.index = index, .stride = stride});
+}
+
+void VulkanBindlessResources::begin_frame(uint32_t frame) {
+    std::scoped_lock lock(m_mutex);
+
+    m_current_frame = frame;
+    auto& retired = current_retired();
+
+    m_free_texture_indices.insert(
+        m_free_texture_indices.end(), retired.texture_indices.begin(), retired.texture_indices.end());
+
+    for (const auto& material : retired.materials) {
+        const auto words = material.stride / MATERIAL_WORD_SIZE;
+        const auto begin = m_used_material_words.begin() + material.index * words;
+        std::fill(begin, begin + words, false);
+    }
+
+    retired.texture_indices.clear();
+    retired.materials.clear();
+}
+
+char* VulkanBindlessResources::material_data(uint32_t index, uint32_t stride) const {
+    return m_material_memory + static_cast<VkDeviceSize>(index) * stride;
+}
+
+VulkanBindlessResources::RetiredResources& VulkanBindlessResources::current_retired() {
+    if (m_current_frame >= m_retired.size())
+        m_retired.resize(m_current_frame + 1);
+
+    return m_retired[m_current_frame];
+}
+
+void VulkanBindlessResources::write_texture(uint32_t index, const VulkanTexture& texture) const {
+    const auto image = std::dynamic_pointer_cast<VulkanImage>(texture.get_image());
+
+    VkDescriptorImageInfo image_info{};
+    image_info.sampler = texture.sampler();
+    image_info.imageView = image->view();
+    image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = m_set;
+    write.dstBinding = TEXTURES_BINDING;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &image_info;
+
+    vkUpdateDescriptorSets(VulkanContext::device->handle(), 1, &write, 0, nullptr);
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+namespace Phos {
+
+// Forward declarations
+class VulkanBuffer;
+class VulkanTexture;
+
+/// Descriptor set shared by every bindless material (set BINDLESS_DESCRIPTOR_SET). Binding 0 is an array with every
+/// texture used by a material, binding 1 a storage buffer with the parameters of every material. Shaders index the
+/// buffer with the material index pushed by VulkanMaterial::bind, and the texture array with the texture indices
+/// stored in the material parameters. The set is bound once per pipeline instead of a set per material.
+class VulkanBindlessResources {
+  public:
+    static constexpr uint32_t BINDLESS_DESCRIPTOR_SET = 3;
+    static constexpr uint32_t TEXTURES_BINDING = 0;
+    static constexpr uint32_t MATERIALS_BINDING = 1;
+
+    static constexpr uint32_t MAX_TEXTURES = 4096;
+    static constexpr VkDeviceSize MATERIAL_BUFFER_SIZE = 1024 * 1024;
+
+    VulkanBindlessResources();
+    ~VulkanBindlessResources();
+
+    VulkanBindlessResources(const VulkanBindlessResources&) = delete;
+    VulkanBindlessResources& operator=(const VulkanBindlessResources&) = delete;
+
+    /// Returns the index of texture in the texture array, adding it if no other material uses it. Every call must be
+    /// paired with a call to release_texture.
+    [[nodiscard]] uint32_t acquire_texture(const std::shared_ptr<VulkanTexture>& texture);
+    /// The index of the texture is not reused until the frames that could still read it have finished
+    void release_texture(const std::shared_ptr<VulkanTexture>& texture);
+
+    /// Reserves the parameters of a material whose struct is stride bytes, returns the index of the material in the
+    /// shader array. Materials with different strides share the buffer.
+    [[nodiscard]] uint32_t allocate_material(uint32_t stride);
+    /// Like release_texture, the parameters are not reused until the frames that could still read them have finished
+    void free_material(uint32_t index, uint32_t stride);
+
+    /// Makes the texture indices and materials released while frame was last recorded available again, frame must
+    /// no longer be in use by the GPU
+    void begin_frame(uint32_t frame);
+
+    /// Parameters of the material at index, written directly by the CPU like the uniform buffers of the materials
+    [[nodiscard]] char* material_data(uint32_t index, uint32_t stride) const;
+
+    [[nodiscard]] VkDescriptorSetLayout descriptor_set_layout() const { return m_layout; }
+    [[nodiscard]] VkDescriptorSet descriptor_set() const { return m_set; }
+
+  private:
+    VkDescriptorSetLayout m_layout{VK_NULL_HANDLE};
+    VkDescriptorPool m_pool{VK_NULL_HANDLE};
+    VkDescriptorSet m_set{VK_NULL_HANDLE};
+
+    std::unique_ptr<VulkanBuffer> m_material_buffer;
+    char* m_material_memory = nullptr;
+    // Every 4 bytes of the material buffer, true if they belong to a material
+    std::vector<bool> m_used_material_words;
+
+    struct TextureSlot {
+        uint32_t index;
+        uint32_t references;
+    };
+    std::unordered_map<const VulkanTexture*, TextureSlot> m_texture_slots;
+    std::vector<uint32_t> m_free_texture_indices;
+    uint32_t m_next_texture_idx = 0;
+
+    // Texture indices and materials released in every frame, freed when the frame begins again
+    struct RetiredMaterial {
+        uint32_t index;
+        uint32_t stride;
+    };
+
+    struct RetiredResources {
+        std::vector<uint32_t> texture_indices;
+        std::vector<RetiredMaterial> materials;
+    };
+    std::vector<RetiredResources> m_retired;
+    uint32_t m_current_frame = 0;
+
+    std::mutex m_mutex;
+
+    [[nodiscard]] RetiredResources& current_retired();
+    void write_texture(uint32_t index, const VulkanTexture& texture) const;
+};
+
+} // namespace Phos
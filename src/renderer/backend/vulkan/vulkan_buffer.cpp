@@ -13,7 +13,10 @@
 
 namespace Phos {
 
-VulkanBuffer::VulkanBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+VulkanBuffer::VulkanBuffer(VkDeviceSize size,
+                           VkBufferUsageFlags usage,
+                           VkMemoryPropertyFlags properties,
+                           bool transient)
       : m_size(size) {
     // Create buffer
     VkBufferCreateInfo create_info{};
@@ -22,39 +25,32 @@ VulkanBuffer::VulkanBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemory
     create_info.usage = usage;
     create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    VK_CHECK(vkCreateBuffer(VulkanContext::device->handle(), &create_info, nullptr, &m_buffer));
-
-    // Allocate memory
-    VkMemoryRequirements memory_requirements;
-    vkGetBufferMemoryRequirements(VulkanContext::device->handle(), m_buffer, &memory_requirements);
-
-    const auto memory_type_index =
-        VulkanContext::device->physical_device().find_memory_type(memory_requirements.memoryTypeBits, properties);
-    PHOS_ASSERT(memory_type_index.has_value(), "No suitable memory to allocate buffer");
+    // Buffers written by the upload manager are used by other queue families without ownership transfers
+    const auto queue_families = VulkanContext::device->get_queue_families();
+    if ((usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT) && queue_families.size() > 1) {
+        create_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        create_info.queueFamilyIndexCount = static_cast<uint32_t>(queue_families.size());
+        create_info.pQueueFamilyIndices = queue_families.data();
+    }
 
-    VkMemoryAllocateInfo allocate_info{};
-    allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocate_info.allocationSize = memory_requirements.size;
-    allocate_info.memoryTypeIndex = memory_type_index.value();
-
-    VK_CHECK(vkAllocateMemory(VulkanContext::device->handle(), &allocate_info, nullptr, &m_memory));
+    VK_CHECK(vkCreateBuffer(VulkanContext::device->handle(), &create_info, nullptr, &m_buffer));
 
-    // Bind memory to buffer
-    VK_CHECK(vkBindBufferMemory(VulkanContext::device->handle(), m_buffer, m_memory, 0));
+    // Allocate and bind memory
+    m_allocation = transient ? VulkanContext::memory_allocator->allocate_transient_buffer(m_buffer, properties)
+                             : VulkanContext::memory_allocator->allocate_buffer(m_buffer, properties);
 }
 
 VulkanBuffer::~VulkanBuffer() {
     vkDestroyBuffer(VulkanContext::device->handle(), m_buffer, nullptr);
-    vkFreeMemory(VulkanContext::device->handle(), m_memory, nullptr);
+    VulkanContext::memory_allocator->free(m_allocation);
 }
 
 void VulkanBuffer::map_memory(void*& memory) const {
-    VK_CHECK(vkMapMemory(VulkanContext::device->handle(), m_memory, 0, m_size, 0, &memory));
+    PHOS_ASSERT(m_allocation.mapped != nullptr, "Buffer memory is not host visible");
+    memory = m_allocation.mapped;
 }
 
-void VulkanBuffer::unmap_memory() const {
-    vkUnmapMemory(VulkanContext::device->handle(), m_memory);
-}
+void VulkanBuffer::unmap_memory() const {}
 
 void VulkanBuffer::copy_data(const void* data) const {
     void* mem;
@@ -2,6 +2,8 @@
 
 #include <vulkan/vulkan.h>
 
+#include "renderer/backend/vulkan/vulkan_memory_allocator.h"
+
 namespace Phos {
 
 // Forward declarations
@@ -10,9 +12,12 @@ class VulkanImage;
 
 class VulkanBuffer {
   public:
-    VulkanBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+    /// Transient buffers are allocated from the linear pool of the current frame, and can only be used until the
+    /// frame begins again
+    VulkanBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, bool transient = false);
     ~VulkanBuffer();
 
+    /// Host visible memory is persistently mapped, so mapping is free and unmap_memory does nothing
     void map_memory(void*& memory) const;
     void unmap_memory() const;
 
@@ -24,7 +29,7 @@ class VulkanBuffer {
 
   private:
     VkBuffer m_buffer{};
-    VkDeviceMemory m_memory{};
+    VulkanAllocation m_allocation;
 
     VkDeviceSize m_size;
 };
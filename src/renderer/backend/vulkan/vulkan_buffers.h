@@ -10,6 +10,8 @@
 #include "renderer/backend/vulkan/vulkan_device.h"
 #include "renderer/backend/vulkan/vulkan_command_buffer.h"
 #include "renderer/backend/vulkan/vulkan_buffer.h"
+#include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_upload_manager.h"
 
 namespace Phos {
 
@@ -22,19 +24,11 @@ class VulkanVertexBuffer : public VertexBuffer {
     explicit VulkanVertexBuffer(const std::vector<T>& data) {
         const VkDeviceSize size = data.size() * sizeof(T);
 
-        const auto staging_buffer = VulkanBuffer{
-            size,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        };
-
-        staging_buffer.copy_data(data.data());
-
         m_buffer = std::make_unique<VulkanBuffer>(size,
                                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-        staging_buffer.copy_to_buffer(*m_buffer);
+        VulkanContext::upload_manager->upload_buffer(*m_buffer, data.data(), size);
 
         m_size = static_cast<uint32_t>(data.size());
     }
@@ -52,9 +52,18 @@ void VulkanCommandBuffer::submit_single_time(
     info.commandBufferCount = static_cast<uint32_t>(command_buffers.size());
     info.pCommandBuffers = command_buffers.data();
 
+    // Waiting for a fence instead of the queue, which is shared with other threads and with the uploads
+    VkFenceCreateInfo fence_info{};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkFence fence;
+    VK_CHECK(vkCreateFence(VulkanContext::device->handle(), &fence_info, nullptr, &fence));
+
     const auto& queue = VulkanContext::device->get_queue_from_type(type);
-    queue->submit(info, VK_NULL_HANDLE);
-    vkQueueWaitIdle(queue->handle());
+    queue->submit(info, fence);
+
+    VK_CHECK(vkWaitForFences(VulkanContext::device->handle(), 1, &fence, VK_TRUE, UINT64_MAX));
+    vkDestroyFence(VulkanContext::device->handle(), fence, nullptr);
 }
 
 void VulkanCommandBuffer::begin(bool one_time) const {
@@ -9,6 +9,7 @@
 #include "renderer/backend/renderer.h"
 
 #include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_pipeline_cache.h"
 #include "renderer/backend/vulkan/vulkan_device.h"
 #include "renderer/backend/vulkan/vulkan_command_buffer.h"
 #include "renderer/backend/vulkan/vulkan_texture.h"
@@ -119,7 +120,8 @@ VulkanComputePipeline::VulkanComputePipeline(const Description& description) {
     create_info.stage = m_shader->get_shader_stage_create_infos()[0];
     create_info.layout = m_shader->get_pipeline_layout();
 
-    VK_CHECK(vkCreateComputePipelines(VulkanContext::device->handle(), nullptr, 1, &create_info, nullptr, &m_pipeline));
+    VK_CHECK(vkCreateComputePipelines(
+        VulkanContext::device->handle(), VulkanContext::pipeline_cache->handle(), 1, &create_info, nullptr, &m_pipeline));
 
     // Allocator for descriptor builder
     m_allocator = std::make_shared<VulkanDescriptorAllocator>();
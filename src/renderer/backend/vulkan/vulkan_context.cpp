@@ -4,15 +4,23 @@
 #include "renderer/backend/vulkan/vulkan_instance.h"
 #include "renderer/backend/vulkan/vulkan_device.h"
 #include "renderer/backend/vulkan/vulkan_descriptors.h"
+#include "renderer/backend/vulkan/vulkan_memory_allocator.h"
+#include "renderer/backend/vulkan/vulkan_upload_manager.h"
+#include "renderer/backend/vulkan/vulkan_bindless.h"
+#include "renderer/backend/vulkan/vulkan_pipeline_cache.h"
 
 namespace Phos {
 
 std::unique_ptr<VulkanInstance> VulkanContext::instance = nullptr;
 std::unique_ptr<VulkanDevice> VulkanContext::device = nullptr;
+std::unique_ptr<VulkanMemoryAllocator> VulkanContext::memory_allocator = nullptr;
+std::unique_ptr<VulkanUploadManager> VulkanContext::upload_manager = nullptr;
 std::shared_ptr<VulkanDescriptorLayoutCache> VulkanContext::descriptor_layout_cache = nullptr;
+std::unique_ptr<VulkanBindlessResources> VulkanContext::bindless = nullptr;
+std::unique_ptr<VulkanPipelineCache> VulkanContext::pipeline_cache = nullptr;
 std::shared_ptr<Window> VulkanContext::window = nullptr;
 
-void VulkanContext::init(std::shared_ptr<Window> wnd) {
+void VulkanContext::init(std::shared_ptr<Window> wnd, const std::filesystem::path& pipeline_cache_path) {
     window = std::move(wnd);
     instance = std::make_unique<VulkanInstance>(window);
 
@@ -28,12 +36,24 @@ void VulkanContext::init(std::shared_ptr<Window> wnd) {
         .extensions = device_extensions,
     };
     device = std::make_unique<VulkanDevice>(instance, device_requirements);
+    memory_allocator = std::make_unique<VulkanMemoryAllocator>();
+    upload_manager = std::make_unique<VulkanUploadManager>();
 
     descriptor_layout_cache = std::make_shared<VulkanDescriptorLayoutCache>();
+    bindless = std::make_unique<VulkanBindlessResources>();
+
+    pipeline_cache = std::make_unique<VulkanPipelineCache>(
+        pipeline_cache_path.empty() ? VulkanPipelineCache::default_path() : pipeline_cache_path);
 }
 
 void VulkanContext::free() {
+    pipeline_cache->save();
+    pipeline_cache.reset();
+
+    bindless.reset();
     descriptor_layout_cache.reset();
+    upload_manager.reset();
+    memory_allocator.reset();
     device.reset();
     instance.reset();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <filesystem>
 
 namespace Phos {
 
@@ -8,16 +9,24 @@ namespace Phos {
 class VulkanInstance;
 class VulkanDevice;
 class VulkanDescriptorLayoutCache;
+class VulkanMemoryAllocator;
+class VulkanUploadManager;
+class VulkanBindlessResources;
+class VulkanPipelineCache;
 class Window;
 
 class VulkanContext {
   public:
     static std::unique_ptr<VulkanInstance> instance;
     static std::unique_ptr<VulkanDevice> device;
+    static std::unique_ptr<VulkanMemoryAllocator> memory_allocator;
+    static std::unique_ptr<VulkanUploadManager> upload_manager;
     static std::shared_ptr<VulkanDescriptorLayoutCache> descriptor_layout_cache;
+    static std::unique_ptr<VulkanBindlessResources> bindless;
+    static std::unique_ptr<VulkanPipelineCache> pipeline_cache;
     static std::shared_ptr<Window> window;
 
-    static void init(std::shared_ptr<Window> wnd);
+    static void init(std::shared_ptr<Window> wnd, const std::filesystem::path& pipeline_cache_path);
     static void free();
 };
 
@@ -17,6 +17,7 @@
 #include "renderer/backend/vulkan/vulkan_image.h"
 #include "renderer/backend/vulkan/vulkan_texture.h"
 #include "renderer/backend/vulkan/vulkan_buffer.h"
+#include "renderer/backend/vulkan/vulkan_upload_manager.h"
 #include "renderer/backend/vulkan/vulkan_compute_pipeline.h"
 
 namespace Phos {
@@ -129,21 +130,8 @@ void VulkanCubemap::init(const Faces& faces) {
         .transfer = true,
     });
 
-    const auto staging_buffer = VulkanBuffer{
-        image_size,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-    };
-    staging_buffer.copy_data(data.data());
-
-    // Transition image layout for copying
-    m_image->transition_layout(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    // Copy staging buffer to image
-    staging_buffer.copy_to_image(*m_image);
-
-    // Transition image layout for shader access
-    m_image->transition_layout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // Upload faces, the image is left ready for shader access
+    VulkanContext::upload_manager->upload_image(*m_image, data.data(), image_size);
 
     // Create sampler
     VkSamplerCreateInfo sampler_info{};
@@ -144,6 +144,8 @@ VkDescriptorSetLayout VulkanDescriptorLayoutCache::create_descriptor_layout(
         std::ranges::sort(layout_info.bindings, [](const auto& a, const auto& b) { return a.binding < b.binding; });
     }
 
+    std::scoped_lock lock(m_mutex);
+
     if (m_layout_cache.contains(layout_info)) {
         return m_layout_cache.find(layout_info)->second;
     }
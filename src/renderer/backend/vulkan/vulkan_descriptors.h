@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 #include <vulkan/vulkan.h>
 
@@ -66,6 +67,8 @@ class VulkanDescriptorLayoutCache {
     };
 
     std::unordered_map<DescriptorLayoutInfo, VkDescriptorSetLayout, DescriptorLayoutHash> m_layout_cache;
+    // Shaders are created from several threads while loading
+    std::mutex m_mutex;
 };
 
 class VulkanDescriptorBuilder {
@@ -1,15 +1,74 @@
 #include "vulkan_device.h"
 
 #include <optional>
+#include <algorithm>
 #include <ranges>
 
 #include "vk_core.h"
 
 #include "renderer/backend/vulkan/vulkan_instance.h"
 #include "renderer/backend/vulkan/vulkan_queue.h"
+#include "renderer/backend/vulkan/vulkan_bindless.h"
 
 namespace Phos {
 
+static VkPhysicalDeviceVulkan12Features required_features_12() {
+    VkPhysicalDeviceVulkan12Features features_12{};
+    features_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    // Timeline semaphores track the completion of uploads
+    features_12.timelineSemaphore = VK_TRUE;
+
+    // Descriptor indexing for the bindless texture array
+    features_12.descriptorIndexing = VK_TRUE;
+    features_12.runtimeDescriptorArray = VK_TRUE;
+    features_12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    features_12.descriptorBindingPartiallyBound = VK_TRUE;
+    features_12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    features_12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+
+    return features_12;
+}
+
+static bool supports_required_features(const VulkanPhysicalDevice& device) {
+    const auto required = required_features_12();
+    const auto supported = device.get_vulkan_12_features();
+
+    const auto supports = [](VkBool32 required_feature, VkBool32 supported_feature) {
+        return !required_feature || supported_feature;
+    };
+
+    const bool features_supported =
+        supports(required.timelineSemaphore, supported.timelineSemaphore)
+        && supports(required.descriptorIndexing, supported.descriptorIndexing)
+        && supports(required.runtimeDescriptorArray, supported.runtimeDescriptorArray)
+        && supports(required.shaderSampledImageArrayNonUniformIndexing,
+                    supported.shaderSampledImageArrayNonUniformIndexing)
+        && supports(required.descriptorBindingPartiallyBound, supported.descriptorBindingPartiallyBound)
+        && supports(required.descriptorBindingSampledImageUpdateAfterBind,
+                    supported.descriptorBindingSampledImageUpdateAfterBind)
+        && supports(required.descriptorBindingUpdateUnusedWhilePending,
+                    supported.descriptorBindingUpdateUnusedWhilePending);
+
+    if (!features_supported) {
+        PHOS_LOG_INFO("Physical device {} does not support the required Vulkan 1.2 features",
+                      device.get_properties().deviceName);
+        return false;
+    }
+
+    // The bindless texture array is visible to every stage
+    const auto properties_12 = device.get_vulkan_12_properties();
+    if (properties_12.maxDescriptorSetUpdateAfterBindSampledImages < VulkanBindlessResources::MAX_TEXTURES
+        || properties_12.maxPerStageDescriptorUpdateAfterBindSampledImages < VulkanBindlessResources::MAX_TEXTURES) {
+        PHOS_LOG_INFO("Physical device {} does not support {} bindless textures",
+                      device.get_properties().deviceName,
+                      VulkanBindlessResources::MAX_TEXTURES);
+        return false;
+    }
+
+    return true;
+}
+
 VulkanDevice::VulkanDevice(const std::unique_ptr<VulkanInstance>& instance,
                            const VulkanPhysicalDevice::Requirements& requirements)
       : m_physical_device(select_physical_device(instance, requirements)) {
@@ -36,10 +95,11 @@ VulkanDevice::VulkanDevice(const std::unique_ptr<VulkanInstance>& instance,
         queues.push_back(queue_create_info_base);
     }
 
-    //    if (requirements.transfer) {
-    //        queue_create_info_base.queueFamilyIndex = queue_families.transfer;
-    //        queues.push_back(queue_create_info_base);
-    //    }
+    if (requirements.transfer && queue_families.transfer != queue_families.graphics &&
+        queue_families.transfer != queue_families.compute) {
+        queue_create_info_base.queueFamilyIndex = queue_families.transfer;
+        queues.push_back(queue_create_info_base);
+    }
 
     if (requirements.presentation && requirements.graphics != requirements.presentation) {
         queue_create_info_base.queueFamilyIndex = queue_families.presentation;
@@ -61,6 +121,10 @@ VulkanDevice::VulkanDevice(const std::unique_ptr<VulkanInstance>& instance,
 
     create_info.ppEnabledExtensionNames = extensions.data();
 
+    // Support was checked when selecting the physical device
+    const auto features_12 = required_features_12();
+    create_info.pNext = &features_12;
+
     VK_CHECK(vkCreateDevice(m_physical_device.handle(), &create_info, nullptr, &m_device));
 
     // Request graphics queue
@@ -96,6 +160,20 @@ VulkanDevice::VulkanDevice(const std::unique_ptr<VulkanInstance>& instance,
         }
     }
 
+    // Request transfer queue
+    if (requirements.transfer) {
+        if (queue_families.transfer == queue_families.graphics) {
+            m_transfer_queue = m_graphics_queue;
+        } else if (queue_families.transfer == queue_families.compute) {
+            m_transfer_queue = m_compute_queue;
+        } else {
+            VkQueue transfer_queue;
+            vkGetDeviceQueue(m_device, queue_families.transfer, 0, &transfer_queue);
+
+            m_transfer_queue = std::make_shared<VulkanQueue>(transfer_queue, queue_families.transfer);
+        }
+    }
+
     // Create command pools
     if (requirements.graphics) {
         m_graphics_command_pool = std::make_unique<VulkanCommandPool>(m_device, queue_families.graphics);
@@ -149,21 +227,35 @@ const std::shared_ptr<VulkanQueue>& VulkanDevice::get_queue_from_type(VulkanQueu
     case VulkanQueue::Type::Compute:
         PHOS_ASSERT(m_compute_command_pool != nullptr, "Compute queue was not requested");
         return m_compute_queue;
+    case VulkanQueue::Type::Transfer:
+        PHOS_ASSERT(m_transfer_queue != nullptr, "Transfer queue was not requested");
+        return m_transfer_queue;
     default:
         PHOS_FAIL("Not implemented");
     }
 }
 
+std::vector<uint32_t> VulkanDevice::get_queue_families() const {
+    std::vector<uint32_t> families;
+    for (const auto& queue : {m_graphics_queue, m_compute_queue, m_transfer_queue}) {
+        if (queue != nullptr && std::ranges::find(families, queue->family()) == families.end())
+            families.push_back(queue->family());
+    }
+
+    return families;
+}
+
 VulkanPhysicalDevice VulkanDevice::select_physical_device(const std::unique_ptr<VulkanInstance>& instance,
                                                           const VulkanPhysicalDevice::Requirements& reqs) const {
     const auto physical_devices = instance->get_physical_devices();
 
     const auto is_device_suitable = [&reqs](const VulkanPhysicalDevice& device) -> bool {
-        return device.is_suitable(reqs);
+        return device.is_suitable(reqs) && supports_required_features(device);
     };
 
     // TODO: Should make these parameters configurable
-    constexpr bool graphics_transfer_same_queue = true;
+    // Uploads run asynchronously on a separate transfer queue when there is one
+    constexpr bool graphics_transfer_same_queue = false;
     constexpr bool graphics_presentation_same_queue = false;
     constexpr bool graphics_compute_same_queue = false;
 
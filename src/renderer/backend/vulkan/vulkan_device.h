@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <vector>
 
 #include "utility/logging.h"
 
@@ -38,7 +39,14 @@ class VulkanDevice {
         return m_compute_queue;
     }
 
+    [[nodiscard]] std::shared_ptr<VulkanQueue> get_transfer_queue() const {
+        PHOS_ASSERT(m_transfer_queue != nullptr, "Transfer queue was not requested");
+        return m_transfer_queue;
+    }
+
     [[nodiscard]] const std::shared_ptr<VulkanQueue>& get_queue_from_type(VulkanQueue::Type type) const;
+    /// Distinct families of the graphics, compute and transfer queues
+    [[nodiscard]] std::vector<uint32_t> get_queue_families() const;
 
     [[nodiscard]] VkDevice handle() const { return m_device; }
     [[nodiscard]] VulkanPhysicalDevice physical_device() const { return m_physical_device; }
@@ -50,6 +58,7 @@ class VulkanDevice {
     std::shared_ptr<VulkanQueue> m_graphics_queue = nullptr;
     std::shared_ptr<VulkanQueue> m_presentation_queue = nullptr;
     std::shared_ptr<VulkanQueue> m_compute_queue = nullptr;
+    std::shared_ptr<VulkanQueue> m_transfer_queue = nullptr;
 
     std::unique_ptr<VulkanCommandPool> m_graphics_command_pool = nullptr;
     std::unique_ptr<VulkanCommandPool> m_compute_command_pool = nullptr;
@@ -1,61 +1,147 @@
 #include "vulkan_graphics_pipeline.h"
 
+#include <array>
 #include <ranges>
+#include <optional>
 
 #include "vk_core.h"
 
+#include "utility/profiling.h"
+#include "core/job_system.h"
+
 #include "renderer/backend/vulkan/vulkan_shader.h"
 #include "renderer/backend/vulkan/vulkan_command_buffer.h"
 #include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_pipeline_cache.h"
 #include "renderer/backend/vulkan/vulkan_framebuffer.h"
 #include "renderer/backend/vulkan/vulkan_buffers.h"
 #include "renderer/backend/vulkan/vulkan_image.h"
 #include "renderer/backend/vulkan/vulkan_texture.h"
 #include "renderer/backend/vulkan/vulkan_descriptors.h"
 #include "renderer/backend/vulkan/vulkan_cubemap.h"
+#include "renderer/backend/vulkan/vulkan_bindless.h"
 
 namespace Phos {
 
-VulkanGraphicsPipeline::VulkanGraphicsPipeline(const Description& description) {
+// State pointed to by the create info of a pipeline, must outlive the vkCreateGraphicsPipelines call
+struct VulkanGraphicsPipeline::PipelineState {
+    std::vector<VkPipelineShaderStageCreateInfo> shader_stages;
+
+    std::optional<VkVertexInputBindingDescription> binding_description;
+    std::vector<VkVertexInputAttributeDescription> attribute_descriptions;
+    VkPipelineVertexInputStateCreateInfo vertex_input{};
+
+    VkPipelineInputAssemblyStateCreateInfo input_assembly{};
+    VkPipelineTessellationStateCreateInfo tessellation{};
+    VkPipelineViewportStateCreateInfo viewport{};
+    VkPipelineRasterizationStateCreateInfo rasterization{};
+    VkPipelineMultisampleStateCreateInfo multisample{};
+    VkPipelineDepthStencilStateCreateInfo depth_stencil{};
+
+    std::vector<VkPipelineColorBlendAttachmentState> color_blend_attachments;
+    VkPipelineColorBlendStateCreateInfo color_blend{};
+
+    VkPipelineDynamicStateCreateInfo dynamic_state{};
+};
+
+// Using dynamic state for Viewport and Scissor
+constexpr std::array<VkDynamicState, 2> DYNAMIC_STATE = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+VulkanGraphicsPipeline::VulkanGraphicsPipeline(const Description& description)
+      : VulkanGraphicsPipeline(description, create_pipelines({&description, 1}).front()) {}
+
+VulkanGraphicsPipeline::VulkanGraphicsPipeline(const Description& description, VkPipeline pipeline)
+      : m_pipeline(pipeline) {
     // TODO: Maybe do differently?
     m_shader = std::dynamic_pointer_cast<VulkanShader>(description.shader);
     m_target_framebuffer = description.target_framebuffer;
+
+    // Start descriptor builder
+    m_allocator = std::make_shared<VulkanDescriptorAllocator>();
+}
+
+std::vector<std::shared_ptr<GraphicsPipeline>> VulkanGraphicsPipeline::create_batch(
+    std::span<const Description> descriptions) {
+    const auto pipelines = create_pipelines(descriptions);
+
+    std::vector<std::shared_ptr<GraphicsPipeline>> graphics_pipelines;
+    graphics_pipelines.reserve(descriptions.size());
+
+    // The constructor that takes an already created pipeline is private, so std::make_shared can not be used
+    for (std::size_t pipeline_idx = 0; pipeline_idx < descriptions.size(); ++pipeline_idx)
+        graphics_pipelines.push_back(std::shared_ptr<VulkanGraphicsPipeline>(
+            new VulkanGraphicsPipeline(descriptions[pipeline_idx], pipelines[pipeline_idx])));
+
+    return graphics_pipelines;
+}
+
+std::vector<VkPipeline> VulkanGraphicsPipeline::create_pipelines(std::span<const Description> descriptions) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanGraphicsPipeline::create_pipelines");
+
+    // Not resized after this point, the create infos point to the states
+    std::vector<PipelineState> states(descriptions.size());
+
+    std::vector<VkGraphicsPipelineCreateInfo> create_infos;
+    create_infos.reserve(descriptions.size());
+
+    for (std::size_t pipeline_idx = 0; pipeline_idx < descriptions.size(); ++pipeline_idx)
+        create_infos.push_back(build_create_info(descriptions[pipeline_idx], states[pipeline_idx]));
+
+    std::vector<VkPipeline> pipelines(descriptions.size(), VK_NULL_HANDLE);
+
+    // Most drivers compile the pipelines of a single call one after the other, so the batch is split across the
+    // workers and every range is created with one call. The pipeline cache is synchronized by the driver.
+    JobSystem::parallel_for(create_infos.size(), 1, [&](std::size_t begin, std::size_t end) {
+        VK_CHECK(vkCreateGraphicsPipelines(VulkanContext::device->handle(),
+                                           VulkanContext::pipeline_cache->handle(),
+                                           static_cast<uint32_t>(end - begin),
+                                           create_infos.data() + begin,
+                                           nullptr,
+                                           pipelines.data() + begin));
+    });
+
+    return pipelines;
+}
+
+VkGraphicsPipelineCreateInfo VulkanGraphicsPipeline::build_create_info(const Description& description,
+                                                                       PipelineState& state) {
+    const auto shader = std::dynamic_pointer_cast<VulkanShader>(description.shader);
     const auto target_framebuffer = std::dynamic_pointer_cast<VulkanFramebuffer>(description.target_framebuffer);
 
     // Shaders
-    const std::vector<VkPipelineShaderStageCreateInfo> shader_stages = m_shader->get_shader_stage_create_infos();
+    state.shader_stages = shader->get_shader_stage_create_infos();
 
     // Vertex input
-    const auto binding_description = m_shader->get_binding_description();
-    const auto attribute_descriptions = m_shader->get_attribute_descriptions();
+    state.binding_description = shader->get_binding_description();
+    state.attribute_descriptions = shader->get_attribute_descriptions();
 
-    VkPipelineVertexInputStateCreateInfo vertex_input_create_info{};
+    auto& vertex_input_create_info = state.vertex_input;
     vertex_input_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertex_input_create_info.vertexBindingDescriptionCount = static_cast<bool>(binding_description.has_value());
+    vertex_input_create_info.vertexBindingDescriptionCount = static_cast<bool>(state.binding_description.has_value());
     vertex_input_create_info.pVertexBindingDescriptions =
-        binding_description.has_value() ? &binding_description.value() : VK_NULL_HANDLE;
-    vertex_input_create_info.vertexAttributeDescriptionCount = (uint32_t)attribute_descriptions.size();
+        state.binding_description.has_value() ? &state.binding_description.value() : VK_NULL_HANDLE;
+    vertex_input_create_info.vertexAttributeDescriptionCount = (uint32_t)state.attribute_descriptions.size();
     vertex_input_create_info.pVertexAttributeDescriptions =
-        !attribute_descriptions.empty() ? attribute_descriptions.data() : VK_NULL_HANDLE;
+        !state.attribute_descriptions.empty() ? state.attribute_descriptions.data() : VK_NULL_HANDLE;
 
     // Input Assembly
-    VkPipelineInputAssemblyStateCreateInfo input_assembly_create_info{};
+    auto& input_assembly_create_info = state.input_assembly;
     input_assembly_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
     input_assembly_create_info.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST; // TODO: Make this configurable?
     input_assembly_create_info.primitiveRestartEnable = VK_FALSE;
 
     // Tessellation State (Not using)
-    VkPipelineTessellationStateCreateInfo tessellation_create_info{};
+    auto& tessellation_create_info = state.tessellation;
     tessellation_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO;
 
     // Viewport State (Using dynamic state for Viewport and Scissor)
-    VkPipelineViewportStateCreateInfo viewport_create_info{};
+    auto& viewport_create_info = state.viewport;
     viewport_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewport_create_info.viewportCount = 1;
     viewport_create_info.scissorCount = 1;
 
     // Rasterization State
-    VkPipelineRasterizationStateCreateInfo rasterization_create_info{};
+    auto& rasterization_create_info = state.rasterization;
     rasterization_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
     rasterization_create_info.depthClampEnable = VK_FALSE;
     rasterization_create_info.rasterizerDiscardEnable = VK_FALSE;
@@ -67,13 +153,13 @@ VulkanGraphicsPipeline::VulkanGraphicsPipeline(const Description& description) {
     rasterization_create_info.lineWidth = 1.0f;
 
     // Multisample State
-    VkPipelineMultisampleStateCreateInfo multisample_create_info{};
+    auto& multisample_create_info = state.multisample;
     multisample_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
     multisample_create_info.sampleShadingEnable = VK_FALSE;
     multisample_create_info.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 
     // Depth-Stencil State
-    VkPipelineDepthStencilStateCreateInfo depth_stencil_create_info{};
+    auto& depth_stencil_create_info = state.depth_stencil;
     depth_stencil_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
     depth_stencil_create_info.depthTestEnable = VK_TRUE;
     depth_stencil_create_info.depthWriteEnable = description.depth_write ? VK_TRUE : VK_FALSE;
@@ -84,41 +170,37 @@ VulkanGraphicsPipeline::VulkanGraphicsPipeline(const Description& description) {
     depth_stencil_create_info.maxDepthBounds = 1.0f;
 
     // Color Blend State
-    std::vector<VkPipelineColorBlendAttachmentState> color_blend_attachments;
-
     for (const auto& attachment : description.target_framebuffer->get_attachments()) {
         if (VulkanImage::is_depth_format(attachment.image->format()))
             continue;
 
-        VkPipelineColorBlendAttachmentState state{};
-        state.blendEnable = VK_FALSE;
-        state.colorWriteMask =
+        VkPipelineColorBlendAttachmentState attachment_state{};
+        attachment_state.blendEnable = VK_FALSE;
+        attachment_state.colorWriteMask =
             VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
 
-        color_blend_attachments.push_back(state);
+        state.color_blend_attachments.push_back(attachment_state);
     }
 
-    VkPipelineColorBlendStateCreateInfo color_blend_create_info{};
+    auto& color_blend_create_info = state.color_blend;
     color_blend_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
     color_blend_create_info.logicOpEnable = VK_FALSE;
-    color_blend_create_info.attachmentCount = static_cast<uint32_t>(color_blend_attachments.size());
-    color_blend_create_info.pAttachments = color_blend_attachments.data();
+    color_blend_create_info.attachmentCount = static_cast<uint32_t>(state.color_blend_attachments.size());
+    color_blend_create_info.pAttachments = state.color_blend_attachments.data();
 
     // Dynamic State
-    constexpr std::array<VkDynamicState, 2> dynamic_state = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
-
-    VkPipelineDynamicStateCreateInfo dynamic_state_create_info{};
+    auto& dynamic_state_create_info = state.dynamic_state;
     dynamic_state_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamic_state_create_info.dynamicStateCount = dynamic_state.size();
-    dynamic_state_create_info.pDynamicStates = dynamic_state.data();
+    dynamic_state_create_info.dynamicStateCount = DYNAMIC_STATE.size();
+    dynamic_state_create_info.pDynamicStates = DYNAMIC_STATE.data();
 
     //
-    // Create pipeline
+    // Create info
     //
     VkGraphicsPipelineCreateInfo create_info{};
     create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    create_info.stageCount = (uint32_t)shader_stages.size();
-    create_info.pStages = shader_stages.data();
+    create_info.stageCount = (uint32_t)state.shader_stages.size();
+    create_info.pStages = state.shader_stages.data();
     create_info.pVertexInputState = &vertex_input_create_info;
     create_info.pInputAssemblyState = &input_assembly_create_info;
     create_info.pTessellationState = &tessellation_create_info;
@@ -128,15 +210,11 @@ VulkanGraphicsPipeline::VulkanGraphicsPipeline(const Description& description) {
     create_info.pDepthStencilState = &depth_stencil_create_info;
     create_info.pColorBlendState = &color_blend_create_info;
     create_info.pDynamicState = &dynamic_state_create_info;
-    create_info.layout = m_shader->get_pipeline_layout();
+    create_info.layout = shader->get_pipeline_layout();
     create_info.renderPass = target_framebuffer->get_render_pass();
     create_info.subpass = 0;
 
-    VK_CHECK(
-        vkCreateGraphicsPipelines(VulkanContext::device->handle(), nullptr, 1, &create_info, nullptr, &m_pipeline));
-
-    // Start descriptor builder
-    m_allocator = std::make_shared<VulkanDescriptorAllocator>();
+    return create_info;
 }
 
 VulkanGraphicsPipeline::~VulkanGraphicsPipeline() {
@@ -186,6 +264,19 @@ void VulkanGraphicsPipeline::bind(const std::shared_ptr<CommandBuffer>& command_
                                 0,
                                 nullptr);
     }
+
+    // Bindless materials only push their index, the set with every material is bound once with the pipeline
+    if (m_shader->is_bindless()) {
+        const auto bindless_set = VulkanContext::bindless->descriptor_set();
+        vkCmdBindDescriptorSets(native_command_buffer->handle(),
+                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                m_shader->get_pipeline_layout(),
+                                VulkanBindlessResources::BINDLESS_DESCRIPTOR_SET,
+                                1,
+                                &bindless_set,
+                                0,
+                                nullptr);
+    }
 }
 
 VkPipelineLayout VulkanGraphicsPipeline::layout() const {
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 #include <memory>
 #include <vector>
+#include <span>
 
 #include "renderer/backend/graphics_pipeline.h"
 
@@ -19,6 +20,10 @@ class VulkanGraphicsPipeline : public GraphicsPipeline {
     explicit VulkanGraphicsPipeline(const Description& description);
     ~VulkanGraphicsPipeline() override;
 
+    /// Creates a pipeline for every description, spreading the work across the JobSystem workers
+    [[nodiscard]] static std::vector<std::shared_ptr<GraphicsPipeline>> create_batch(
+        std::span<const Description> descriptions);
+
     void bind(const std::shared_ptr<CommandBuffer>& command_buffer);
 
     /// Builds the descriptor sets
@@ -56,6 +61,13 @@ class VulkanGraphicsPipeline : public GraphicsPipeline {
 
     VkDescriptorSet m_set{VK_NULL_HANDLE};
 
+    VulkanGraphicsPipeline(const Description& description, VkPipeline pipeline);
+
+    struct PipelineState;
+    [[nodiscard]] static std::vector<VkPipeline> create_pipelines(std::span<const Description> descriptions);
+    [[nodiscard]] static VkGraphicsPipelineCreateInfo build_create_info(const Description& description,
+                                                                        PipelineState& state);
+
     [[nodiscard]] static VkCompareOp get_depth_compare_op(DepthCompareOp op);
     [[nodiscard]] static VkFrontFace get_rasterization_front_face(FrontFace face);
 };
@@ -44,29 +44,23 @@ VulkanImage::VulkanImage(const Description& description) : m_description(descrip
     if (description.storage)
         image_create_info.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
 
+    // Images written by the upload manager are used by other queue families without ownership transfers
+    const auto queue_families = VulkanContext::device->get_queue_families();
+    if (description.transfer && queue_families.size() > 1) {
+        image_create_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        image_create_info.queueFamilyIndexCount = static_cast<uint32_t>(queue_families.size());
+        image_create_info.pQueueFamilyIndices = queue_families.data();
+    }
+
     // Flags
     if (description.type == Image::Type::Cubemap)
         image_create_info.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
 
     VK_CHECK(vkCreateImage(VulkanContext::device->handle(), &image_create_info, nullptr, &m_image));
 
-    // Allocate image
-    VkMemoryRequirements memory_requirements;
-    vkGetImageMemoryRequirements(VulkanContext::device->handle(), m_image, &memory_requirements);
-
-    const auto memory_type_index = VulkanContext::device->physical_device().find_memory_type(
-        memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    PHOS_ASSERT(memory_type_index.has_value(), "No suitable memory to allocate image");
-
-    VkMemoryAllocateInfo allocate_info{};
-    allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocate_info.allocationSize = memory_requirements.size;
-    allocate_info.memoryTypeIndex = memory_type_index.value();
-
-    VK_CHECK(vkAllocateMemory(VulkanContext::device->handle(), &allocate_info, nullptr, &m_memory));
-
-    // Bind memory to image
-    VK_CHECK(vkBindImageMemory(VulkanContext::device->handle(), m_image, m_memory, 0));
+    // Allocate and bind memory
+    m_allocation = VulkanContext::memory_allocator->allocate_image(
+        m_image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, description.attachment);
 
     // Create image view
     create_image_view(description);
@@ -80,7 +74,7 @@ VulkanImage::VulkanImage(const Description& description, VkImage image) : m_imag
 VulkanImage::~VulkanImage() {
     if (m_created_resources) {
         vkDestroyImage(VulkanContext::device->handle(), m_image, nullptr);
-        vkFreeMemory(VulkanContext::device->handle(), m_memory, nullptr);
+        VulkanContext::memory_allocator->free(m_allocation);
     }
 
     // Destroy main image_view
@@ -6,6 +6,7 @@
 
 #include "utility/logging.h"
 #include "renderer/backend/image.h"
+#include "renderer/backend/vulkan/vulkan_memory_allocator.h"
 
 namespace Phos {
 
@@ -41,7 +42,7 @@ class VulkanImage : public Image {
 
   private:
     VkImage m_image{VK_NULL_HANDLE};
-    VkDeviceMemory m_memory{VK_NULL_HANDLE};
+    VulkanAllocation m_allocation;
 
     VkImageView m_image_view{VK_NULL_HANDLE};
     std::vector<VkImageView> m_mip_image_views;
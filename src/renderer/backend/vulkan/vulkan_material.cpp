@@ -1,6 +1,7 @@
 #include "vulkan_material.h"
 
 #include <ranges>
+#include <cstring>
 #include <utility>
 
 #include "utility/logging.h"
@@ -16,20 +17,56 @@
 #include "renderer/backend/vulkan/vulkan_image.h"
 #include "renderer/backend/vulkan/vulkan_descriptors.h"
 #include "renderer/backend/vulkan/vulkan_buffers.h"
+#include "renderer/backend/vulkan/vulkan_bindless.h"
 
 namespace Phos {
 
 constexpr uint32_t MATERIAL_DESCRIPTOR_SET = 2;
+constexpr std::string_view MATERIAL_PUSH_CONSTANT = "uMaterial";
 
 VulkanMaterial::VulkanMaterial(const std::shared_ptr<Shader>& shader, std::string name) : m_name(std::move(name)) {
     m_shader = std::dynamic_pointer_cast<VulkanShader>(shader);
-    m_allocator = std::make_shared<VulkanDescriptorAllocator>();
-
-    const auto descriptors = m_shader->descriptors_in_set(MATERIAL_DESCRIPTOR_SET);
 
     const auto white_texture =
         std::dynamic_pointer_cast<VulkanTexture>(Renderer::texture_manager()->get_white_texture());
 
+    if (m_shader->is_bindless()) {
+        m_bindless = true;
+
+        const auto push_constant = m_shader->push_constant_info(MATERIAL_PUSH_CONSTANT);
+        PHOS_ASSERT(push_constant.has_value(), "Bindless shader does not have material push constant");
+        m_push_constant_stage = push_constant->stage;
+
+        const auto descriptors = m_shader->descriptors_in_set(VulkanBindlessResources::BINDLESS_DESCRIPTOR_SET);
+        for (const auto& descriptor : descriptors) {
+            if (descriptor.type != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                continue;
+
+            m_material_stride = descriptor.size;
+            m_material_idx = VulkanContext::bindless->allocate_material(m_material_stride);
+
+            // Same defaults as uniform buffers, texture indices are overwritten below
+            auto* data = VulkanContext::bindless->material_data(m_material_idx, m_material_stride);
+            const auto default_data = std::vector<float>(m_material_stride / sizeof(float), 1.0f);
+            memcpy(data, default_data.data(), m_material_stride);
+
+            for (const auto& member : descriptor.members) {
+                if (member.texture_index)
+                    m_textures.insert({member.name, white_texture});
+            }
+
+            m_name_to_descriptor_info.insert({descriptor.name, descriptor});
+        }
+
+        // Point the texture indices at the white texture, the material can be drawn before it is baked
+        [[maybe_unused]] const auto baked = bake_bindless();
+
+        return;
+    }
+
+    m_allocator = std::make_shared<VulkanDescriptorAllocator>();
+
+    const auto descriptors = m_shader->descriptors_in_set(MATERIAL_DESCRIPTOR_SET);
     for (const auto& descriptor : descriptors) {
         if (descriptor.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
             m_textures.insert({descriptor.name, white_texture});
@@ -48,6 +85,16 @@ VulkanMaterial::VulkanMaterial(const std::shared_ptr<Shader>& shader, std::strin
     }
 }
 
+VulkanMaterial::~VulkanMaterial() {
+    if (!m_bindless)
+        return;
+
+    for (const auto& texture : m_acquired_textures)
+        VulkanContext::bindless->release_texture(texture);
+
+    VulkanContext::bindless->free_material(m_material_idx, m_material_stride);
+}
+
 void VulkanMaterial::set(const std::string& name, float data) {
     const auto data_size = sizeof(float);
 
@@ -63,10 +110,7 @@ void VulkanMaterial::set(const std::string& name, float data) {
         return;
     }
 
-    const std::string ubo_name = name.substr(0, name.find('.'));
-
-    const auto& d = m_uniform_buffers[ubo_name];
-    d->set_data(&data, member->size, member->offset);
+    write_member(name, *member, &data);
 }
 
 void VulkanMaterial::set(const std::string& name, glm::vec3 data) {
@@ -84,10 +128,7 @@ void VulkanMaterial::set(const std::string& name, glm::vec3 data) {
         return;
     }
 
-    const std::string ubo_name = name.substr(0, name.find('.'));
-
-    const auto& d = m_uniform_buffers[ubo_name];
-    d->set_data(&data, member->size, member->offset);
+    write_member(name, *member, &data);
 }
 
 void VulkanMaterial::set(const std::string& name, glm::vec4 data) {
@@ -105,10 +146,7 @@ void VulkanMaterial::set(const std::string& name, glm::vec4 data) {
         return;
     }
 
-    const std::string ubo_name = name.substr(0, name.find('.'));
-
-    const auto& d = m_uniform_buffers[ubo_name];
-    d->set_data(&data, member->size, member->offset);
+    write_member(name, *member, &data);
 }
 
 void VulkanMaterial::set(const std::string& name, std::shared_ptr<Texture> texture) {
@@ -121,6 +159,9 @@ void VulkanMaterial::set(const std::string& name, std::shared_ptr<Texture> textu
 }
 
 bool VulkanMaterial::bake() {
+    if (m_bindless)
+        return bake_bindless();
+
     auto builder = VulkanDescriptorBuilder::begin(VulkanContext::descriptor_layout_cache, m_allocator);
 
     // Build textures
@@ -167,6 +208,16 @@ bool VulkanMaterial::bake() {
 }
 
 void VulkanMaterial::bind(const std::shared_ptr<VulkanCommandBuffer>& command_buffer) const {
+    if (m_bindless) {
+        vkCmdPushConstants(command_buffer->handle(),
+                           m_shader->get_pipeline_layout(),
+                           m_push_constant_stage,
+                           0,
+                           sizeof(uint32_t),
+                           &m_material_idx);
+        return;
+    }
+
     vkCmdBindDescriptorSets(command_buffer->handle(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS,
                             m_shader->get_pipeline_layout(),
@@ -179,7 +230,7 @@ void VulkanMaterial::bind(const std::shared_ptr<VulkanCommandBuffer>& command_bu
 
 std::optional<VulkanUniformBufferMember> VulkanMaterial::find_uniform_buffer_member(const std::string& name) {
     for (const auto& [_, info] : m_name_to_descriptor_info) {
-        if (info.type != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+        if (info.type != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && info.type != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
             continue;
 
         auto member = std::ranges::find_if(info.members, [&](const VulkanUniformBufferMember& mem) {
@@ -194,4 +245,43 @@ std::optional<VulkanUniformBufferMember> VulkanMaterial::find_uniform_buffer_mem
     return {};
 }
 
+void VulkanMaterial::write_member(const std::string& name, const VulkanUniformBufferMember& member, const void* data) {
+    if (m_bindless) {
+        auto* material_data = VulkanContext::bindless->material_data(m_material_idx, m_material_stride);
+        memcpy(material_data + member.offset, data, member.size);
+        return;
+    }
+
+    const std::string ubo_name = name.substr(0, name.find('.'));
+
+    const auto& d = m_uniform_buffers[ubo_name];
+    d->set_data(data, member.size, member.offset);
+}
+
+bool VulkanMaterial::bake_bindless() {
+    // Textures of the previous bake keep their index until the new ones have been acquired
+    auto previous_textures = std::move(m_acquired_textures);
+    m_acquired_textures.clear();
+
+    auto* material_data = VulkanContext::bindless->material_data(m_material_idx, m_material_stride);
+
+    for (const auto& [_, info] : m_name_to_descriptor_info) {
+        for (const auto& member : info.members) {
+            if (!member.texture_index)
+                continue;
+
+            const auto& texture = m_textures[member.name];
+            const auto texture_idx = VulkanContext::bindless->acquire_texture(texture);
+            memcpy(material_data + member.offset, &texture_idx, sizeof(uint32_t));
+
+            m_acquired_textures.push_back(texture);
+        }
+    }
+
+    for (const auto& texture : previous_textures)
+        VulkanContext::bindless->release_texture(texture);
+
+    return true;
+}
+
 } // namespace Phos
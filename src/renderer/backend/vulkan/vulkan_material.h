@@ -15,10 +15,12 @@ class VulkanUniformBuffer;
 class VulkanDescriptorAllocator;
 struct VulkanDescriptorInfo;
 
+/// Materials of bindless shaders (see VulkanBindlessResources) store their parameters and texture indices in the
+/// shared material buffer and bind only pushes their index. Other materials bake their own descriptor set.
 class VulkanMaterial : public Material {
   public:
     explicit VulkanMaterial(const std::shared_ptr<Shader>& shader, std::string name);
-    ~VulkanMaterial() override = default;
+    ~VulkanMaterial() override;
 
     void set(const std::string& name, float data) override;
     void set(const std::string& name, glm::vec3 data) override;
@@ -43,7 +45,18 @@ class VulkanMaterial : public Material {
     VkDescriptorSet m_set{VK_NULL_HANDLE};
     std::shared_ptr<VulkanDescriptorAllocator> m_allocator;
 
+    // Bindless materials
+    bool m_bindless = false;
+    uint32_t m_material_idx = 0;
+    uint32_t m_material_stride = 0;
+    VkShaderStageFlags m_push_constant_stage = 0;
+    // Textures whose bindless index is written in the material, released when baking again
+    std::vector<std::shared_ptr<VulkanTexture>> m_acquired_textures;
+
     std::optional<VulkanUniformBufferMember> find_uniform_buffer_member(const std::string& name);
+    void write_member(const std::string& name, const VulkanUniformBufferMember& member, const void* data);
+
+    [[nodiscard]] bool bake_bindless();
 };
 
 } // namespace Phos
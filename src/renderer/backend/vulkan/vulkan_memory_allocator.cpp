@@ -0,0 +1,384 @@
+#include "vulkan_memory_allocator.h"
+
+#include <string>
+#include <algorithm>
+
+#include "utility/logging.h"
+#include "utility/profiling.h"
+
+#include "vk_core.h"
+
+#include "renderer/backend/vulkan/vulkan_device.h"
+#include "renderer/backend/vulkan/vulkan_context.h"
+
+namespace Phos {
+
+VulkanMemoryAllocator::VulkanMemoryAllocator() {
+    m_memory_properties = VulkanContext::device->physical_device().get_memory_properties();
+}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+    for (const auto& block : m_blocks) {
+        if (block.memory == VK_NULL_HANDLE)
+            continue;
+
+        if (!block.allocator->empty())
+            PHOS_LOG_WARNING("Memory block freed with {} live allocations", block.allocator->allocation_count());
+
+        vkFreeMemory(VulkanContext::device->handle(), block.memory, nullptr);
+    }
+
+    for (const auto& pools : m_frame_pools) {
+        for (const auto& pool : pools) {
+            for (const auto& block : pool.blocks)
+                vkFreeMemory(VulkanContext::device->handle(), block.memory, nullptr);
+        }
+    }
+}
+
+VulkanAllocation VulkanMemoryAllocator::allocate_buffer(VkBuffer buffer, VkMemoryPropertyFlags properties) {
+    VkBufferMemoryRequirementsInfo2 requirements_info{};
+    requirements_info.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+    requirements_info.buffer = buffer;
+
+    VkMemoryDedicatedRequirements dedicated_requirements{};
+    dedicated_requirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicated_requirements;
+
+    vkGetBufferMemoryRequirements2(VulkanContext::device->handle(), &requirements_info, &requirements);
+
+    VkMemoryDedicatedAllocateInfo dedicated_info{};
+    dedicated_info.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicated_info.buffer = buffer;
+
+    const bool dedicated = dedicated_requirements.requiresDedicatedAllocation == VK_TRUE ||
+                           dedicated_requirements.prefersDedicatedAllocation == VK_TRUE;
+
+    const auto allocation =
+        allocate(requirements.memoryRequirements, properties, ResourceKind::Buffer, dedicated, &dedicated_info);
+    VK_CHECK(vkBindBufferMemory(VulkanContext::device->handle(), buffer, allocation.memory, allocation.offset));
+
+    return allocation;
+}
+
+VulkanAllocation VulkanMemoryAllocator::allocate_transient_buffer(VkBuffer buffer, VkMemoryPropertyFlags properties) {
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(VulkanContext::device->handle(), buffer, &requirements);
+
+    std::scoped_lock lock(m_mutex);
+
+    const auto memory_type = find_memory_type(requirements.memoryTypeBits, properties);
+
+    if (m_current_frame >= m_frame_pools.size())
+        m_frame_pools.resize(m_current_frame + 1);
+
+    auto& pools = m_frame_pools[m_current_frame];
+    auto pool_it = std::ranges::find_if(pools, [&](const LinearPool& pool) { return pool.memory_type == memory_type; });
+    if (pool_it == pools.end()) {
+        pools.push_back(LinearPool{.memory_type = memory_type});
+        pool_it = pools.end() - 1;
+    }
+
+    auto& pool = *pool_it;
+
+    // Bump allocate from the current block, moving to the next one when it is full
+    VkDeviceSize offset;
+    while (true) {
+        if (pool.current_block == pool.blocks.size()) {
+            auto block = LinearBlock{.size = std::max(TRANSIENT_BLOCK_SIZE, requirements.size)};
+            block.memory = allocate_memory(block.size, memory_type, nullptr, block.mapped);
+
+            pool.blocks.push_back(block);
+        }
+
+        auto& block = pool.blocks[pool.current_block];
+
+        offset = (block.offset + requirements.alignment - 1) & ~(requirements.alignment - 1);
+        if (offset + requirements.size <= block.size) {
+            block.offset = offset + requirements.size;
+            break;
+        }
+
+        ++pool.current_block;
+    }
+
+    const auto& block = pool.blocks[pool.current_block];
+
+    pool.used += requirements.size;
+    ++pool.allocations;
+
+    auto& counters = heap(memory_type);
+    counters.used += requirements.size;
+    ++counters.allocations;
+
+    VK_CHECK(vkBindBufferMemory(VulkanContext::device->handle(), buffer, block.memory, offset));
+
+    return VulkanAllocation{
+        .memory = block.memory,
+        .offset = offset,
+        .size = requirements.size,
+        .mapped = block.mapped != nullptr ? static_cast<char*>(block.mapped) + offset : nullptr,
+        .type = VulkanAllocation::Type::Transient,
+        .memory_type = memory_type,
+    };
+}
+
+VulkanAllocation VulkanMemoryAllocator::allocate_image(VkImage image,
+                                                       VkMemoryPropertyFlags properties,
+                                                       bool attachment) {
+    VkImageMemoryRequirementsInfo2 requirements_info{};
+    requirements_info.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+    requirements_info.image = image;
+
+    VkMemoryDedicatedRequirements dedicated_requirements{};
+    dedicated_requirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicated_requirements;
+
+    vkGetImageMemoryRequirements2(VulkanContext::device->handle(), &requirements_info, &requirements);
+
+    VkMemoryDedicatedAllocateInfo dedicated_info{};
+    dedicated_info.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicated_info.image = image;
+
+    // Big attachments are usually recreated with the framebuffers, a block would keep their memory fragmented
+    const bool dedicated = dedicated_requirements.requiresDedicatedAllocation == VK_TRUE ||
+                           dedicated_requirements.prefersDedicatedAllocation == VK_TRUE ||
+                           (attachment && requirements.memoryRequirements.size >= DEDICATED_ATTACHMENT_SIZE);
+
+    const auto allocation =
+        allocate(requirements.memoryRequirements, properties, ResourceKind::Image, dedicated, &dedicated_info);
+    VK_CHECK(vkBindImageMemory(VulkanContext::device->handle(), image, allocation.memory, allocation.offset));
+
+    return allocation;
+}
+
+void VulkanMemoryAllocator::free(const VulkanAllocation& allocation) {
+    // Released all at once in begin_frame
+    if (allocation.type == VulkanAllocation::Type::Transient)
+        return;
+
+    std::scoped_lock lock(m_mutex);
+
+    auto& counters = heap(allocation.memory_type);
+    counters.used -= allocation.size;
+    --counters.allocations;
+
+    if (allocation.type == VulkanAllocation::Type::Dedicated) {
+        free_memory(allocation.memory, allocation.size, allocation.memory_type);
+        return;
+    }
+
+    auto& block = m_blocks[allocation.block_idx];
+    block.allocator->free(allocation.node);
+
+    if (!block.allocator->empty())
+        return;
+
+    // Empty blocks are kept if they are the last one of their kind, to avoid allocating again when a resource is
+    // destroyed and created again
+    const auto same_blocks = std::ranges::count_if(m_blocks, [&](const Block& other) {
+        return other.memory != VK_NULL_HANDLE && other.memory_type == block.memory_type && other.kind == block.kind;
+    });
+
+    if (same_blocks > 1) {
+        free_memory(block.memory, block.allocator->size(), block.memory_type);
+        block = Block{};
+    }
+}
+
+void VulkanMemoryAllocator::begin_frame(uint32_t frame) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanMemoryAllocator::begin_frame");
+
+    std::scoped_lock lock(m_mutex);
+
+    m_current_frame = frame;
+    if (m_current_frame >= m_frame_pools.size())
+        m_frame_pools.resize(m_current_frame + 1);
+
+    for (auto& pool : m_frame_pools[m_current_frame]) {
+        auto& counters = heap(pool.memory_type);
+        counters.used -= pool.used;
+        counters.allocations -= pool.allocations;
+
+        for (auto& block : pool.blocks)
+            block.offset = 0;
+
+        pool.current_block = 0;
+        pool.used = 0;
+        pool.allocations = 0;
+    }
+
+    // Tracy identifies plots by the address of their name
+    [[maybe_unused]] static const auto plot_names = [] {
+        std::array<std::string, VK_MAX_MEMORY_HEAPS> names;
+        for (uint32_t heap_idx = 0; heap_idx < VK_MAX_MEMORY_HEAPS; ++heap_idx)
+            names[heap_idx] = "GPU memory heap " + std::to_string(heap_idx);
+
+        return names;
+    }();
+
+    for (uint32_t heap_idx = 0; heap_idx < m_memory_properties.memoryHeapCount; ++heap_idx)
+        PHOS_PROFILE_PLOT(plot_names[heap_idx].c_str(), static_cast<int64_t>(m_heaps[heap_idx].used));
+}
+
+std::vector<GpuMemoryHeapStatistics> VulkanMemoryAllocator::statistics() const {
+    std::scoped_lock lock(m_mutex);
+
+    std::vector<GpuMemoryHeapStatistics> heaps;
+    for (uint32_t heap_idx = 0; heap_idx < m_memory_properties.memoryHeapCount; ++heap_idx) {
+        const auto& properties = m_memory_properties.memoryHeaps[heap_idx];
+        const auto& counters = m_heaps[heap_idx];
+
+        heaps.push_back(GpuMemoryHeapStatistics{
+            .heap_size = properties.size,
+            .device_local = (properties.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0,
+            .reserved_bytes = counters.reserved,
+            .used_bytes = counters.used,
+            .allocations = counters.allocations,
+            .device_allocations = counters.device_allocations,
+        });
+    }
+
+    return heaps;
+}
+
+VulkanAllocation VulkanMemoryAllocator::allocate(const VkMemoryRequirements& requirements,
+                                                 VkMemoryPropertyFlags properties,
+                                                 ResourceKind kind,
+                                                 bool dedicated,
+                                                 const VkMemoryDedicatedAllocateInfo* dedicated_info) {
+    std::scoped_lock lock(m_mutex);
+
+    const auto memory_type = find_memory_type(requirements.memoryTypeBits, properties);
+    const auto size = block_size(memory_type);
+
+    auto& counters = heap(memory_type);
+    counters.used += requirements.size;
+    ++counters.allocations;
+
+    // Resources that would take most of a block are not worth sub allocating
+    if (dedicated || requirements.size > size / 2)
+        return allocate_dedicated(requirements.size, memory_type, dedicated_info);
+
+    const auto sub_allocate = [&](uint32_t block_idx) -> std::optional<VulkanAllocation> {
+        const auto& block = m_blocks[block_idx];
+
+        const auto range = block.allocator->allocate(requirements.size, requirements.alignment);
+        if (!range.has_value())
+            return std::nullopt;
+
+        return VulkanAllocation{
+            .memory = block.memory,
+            .offset = range->offset,
+            .size = requirements.size,
+            .mapped = block.mapped != nullptr ? static_cast<char*>(block.mapped) + range->offset : nullptr,
+            .type = VulkanAllocation::Type::Block,
+            .memory_type = memory_type,
+            .block_idx = block_idx,
+            .node = range->node,
+        };
+    };
+
+    for (uint32_t block_idx = 0; block_idx < m_blocks.size(); ++block_idx) {
+        const auto& block = m_blocks[block_idx];
+        if (block.memory == VK_NULL_HANDLE || block.memory_type != memory_type || block.kind != kind)
+            continue;
+
+        if (const auto allocation = sub_allocate(block_idx))
+            return *allocation;
+    }
+
+    // No block has enough space, a new one is created in the first empty slot
+    auto slot = std::ranges::find_if(m_blocks, [](const Block& block) { return block.memory == VK_NULL_HANDLE; });
+    if (slot == m_blocks.end()) {
+        m_blocks.emplace_back();
+        slot = m_blocks.end() - 1;
+    }
+
+    slot->memory_type = memory_type;
+    slot->kind = kind;
+    slot->allocator = std::make_unique<TLSFAllocator>(size);
+    slot->memory = allocate_memory(size, memory_type, nullptr, slot->mapped);
+
+    const auto allocation = sub_allocate(static_cast<uint32_t>(slot - m_blocks.begin()));
+    PHOS_ASSERT(allocation.has_value(), "Allocation of {} bytes does not fit in a new block", requirements.size);
+
+    return *allocation;
+}
+
+VulkanAllocation VulkanMemoryAllocator::allocate_dedicated(VkDeviceSize size,
+                                                           uint32_t memory_type,
+                                                           const VkMemoryDedicatedAllocateInfo* dedicated_info) {
+    void* mapped = nullptr;
+    const auto memory = allocate_memory(size, memory_type, dedicated_info, mapped);
+
+    return VulkanAllocation{
+        .memory = memory,
+        .offset = 0,
+        .size = size,
+        .mapped = mapped,
+        .type = VulkanAllocation::Type::Dedicated,
+        .memory_type = memory_type,
+    };
+}
+
+VkDeviceMemory VulkanMemoryAllocator::allocate_memory(VkDeviceSize size,
+                                                      uint32_t memory_type,
+                                                      const void* next,
+                                                      void*& mapped) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanMemoryAllocator::allocate_memory");
+
+    VkMemoryAllocateInfo allocate_info{};
+    allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocate_info.pNext = next;
+    allocate_info.allocationSize = size;
+    allocate_info.memoryTypeIndex = memory_type;
+
+    VkDeviceMemory memory;
+    VK_CHECK(vkAllocateMemory(VulkanContext::device->handle(), &allocate_info, nullptr, &memory));
+
+    // Host visible memory stays mapped until it is freed
+    mapped = nullptr;
+    if (m_memory_properties.memoryTypes[memory_type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        VK_CHECK(vkMapMemory(VulkanContext::device->handle(), memory, 0, VK_WHOLE_SIZE, 0, &mapped));
+
+    auto& counters = heap(memory_type);
+    counters.reserved += size;
+    ++counters.device_allocations;
+
+    return memory;
+}
+
+void VulkanMemoryAllocator::free_memory(VkDeviceMemory memory, VkDeviceSize size, uint32_t memory_type) {
+    // Mapped memory is unmapped when freed
+    vkFreeMemory(VulkanContext::device->handle(), memory, nullptr);
+
+    auto& counters = heap(memory_type);
+    counters.reserved -= size;
+    --counters.device_allocations;
+}
+
+uint32_t VulkanMemoryAllocator::find_memory_type(uint32_t filter, VkMemoryPropertyFlags properties) const {
+    for (uint32_t type_idx = 0; type_idx < m_memory_properties.memoryTypeCount; ++type_idx) {
+        const auto flags = m_memory_properties.memoryTypes[type_idx].propertyFlags;
+        if ((filter & (1u << type_idx)) && (flags & properties) == properties)
+            return type_idx;
+    }
+
+    PHOS_FAIL("No suitable memory type for properties {}", properties);
+    return 0;
+}
+
+VkDeviceSize VulkanMemoryAllocator::block_size(uint32_t memory_type) const {
+    // Small heaps, like the device local and host visible one without resizable BAR, get smaller blocks
+    const auto heap_idx = m_memory_properties.memoryTypes[memory_type].heapIndex;
+    return std::min(DEFAULT_BLOCK_SIZE, m_memory_properties.memoryHeaps[heap_idx].size / 8);
+}
+
+} // namespace Phos
\ No newline at end of file
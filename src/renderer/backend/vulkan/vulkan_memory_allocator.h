@@ -0,0 +1,139 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <memory>
+#include <vector>
+#include <array>
+#include <mutex>
+
+#include "core/tlsf_allocator.h"
+#include "renderer/backend/renderer.h"
+
+namespace Phos {
+
+/// Range of device memory bound to a resource
+struct VulkanAllocation {
+    enum class Type {
+        // Sub allocated from a block shared with other resources
+        Block,
+        // Own VkDeviceMemory
+        Dedicated,
+        // Sub allocated from the linear pool of a frame, released when the frame begins again
+        Transient,
+    };
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    // Pointer to offset if the memory is host visible, it stays mapped for the whole lifetime of the allocation
+    void* mapped = nullptr;
+
+    Type type = Type::Block;
+    uint32_t memory_type = 0;
+
+    uint32_t block_idx = 0;
+    TLSFAllocator::NodeId node = TLSFAllocator::INVALID_NODE;
+};
+
+/// Sub allocates the memory of buffers and images from big VkDeviceMemory blocks, as drivers limit the number of
+/// allocations and vkAllocateMemory is slow. Every memory type has its own blocks, split between buffers and images so
+/// that bufferImageGranularity never needs to be considered, and ranges are managed with a TLSFAllocator. Big
+/// attachments and resources that do not fit comfortably in a block get a dedicated allocation. Data that only lives
+/// for a frame is bump allocated from per frame linear pools instead.
+class VulkanMemoryAllocator {
+  public:
+    static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+    static constexpr VkDeviceSize TRANSIENT_BLOCK_SIZE = 8ull * 1024 * 1024;
+    static constexpr VkDeviceSize DEDICATED_ATTACHMENT_SIZE = 8ull * 1024 * 1024;
+
+    VulkanMemoryAllocator();
+    ~VulkanMemoryAllocator();
+
+    VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+    VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) = delete;
+
+    /// Allocates and binds the memory of buffer
+    [[nodiscard]] VulkanAllocation allocate_buffer(VkBuffer buffer, VkMemoryPropertyFlags properties);
+    /// Same as allocate_buffer from the linear pool of the current frame, the memory can only be used until
+    /// begin_frame is called again with the current frame. Freeing the allocation is not necessary.
+    [[nodiscard]] VulkanAllocation allocate_transient_buffer(VkBuffer buffer, VkMemoryPropertyFlags properties);
+    /// Allocates and binds the memory of image, attachments bigger than DEDICATED_ATTACHMENT_SIZE are not sub allocated
+    [[nodiscard]] VulkanAllocation allocate_image(VkImage image, VkMemoryPropertyFlags properties, bool attachment);
+
+    void free(const VulkanAllocation& allocation);
+
+    /// Releases the transient allocations of frame, which must no longer be in use by the GPU
+    void begin_frame(uint32_t frame);
+
+    [[nodiscard]] std::vector<GpuMemoryHeapStatistics> statistics() const;
+
+  private:
+    enum class ResourceKind {
+        Buffer,
+        Image,
+    };
+
+    struct Block {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void* mapped = nullptr;
+        uint32_t memory_type = 0;
+        ResourceKind kind = ResourceKind::Buffer;
+        std::unique_ptr<TLSFAllocator> allocator;
+    };
+    // Freed blocks leave an empty slot, so that the index of the other blocks does not change
+    std::vector<Block> m_blocks;
+
+    struct LinearBlock {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void* mapped = nullptr;
+        VkDeviceSize size = 0;
+        VkDeviceSize offset = 0;
+    };
+
+    struct LinearPool {
+        uint32_t memory_type = 0;
+        std::vector<LinearBlock> blocks;
+        std::size_t current_block = 0;
+
+        VkDeviceSize used = 0;
+        uint32_t allocations = 0;
+    };
+    // Linear pools of every frame, there is one pool for every memory type used in the frame
+    std::vector<std::vector<LinearPool>> m_frame_pools;
+    uint32_t m_current_frame = 0;
+
+    struct HeapCounters {
+        VkDeviceSize reserved = 0;
+        VkDeviceSize used = 0;
+        uint32_t allocations = 0;
+        uint32_t device_allocations = 0;
+    };
+    std::array<HeapCounters, VK_MAX_MEMORY_HEAPS> m_heaps{};
+
+    VkPhysicalDeviceMemoryProperties m_memory_properties{};
+
+    mutable std::mutex m_mutex;
+
+    [[nodiscard]] VulkanAllocation allocate(const VkMemoryRequirements& requirements,
+                                            VkMemoryPropertyFlags properties,
+                                            ResourceKind kind,
+                                            bool dedicated,
+                                            const VkMemoryDedicatedAllocateInfo* dedicated_info);
+    [[nodiscard]] VulkanAllocation allocate_dedicated(VkDeviceSize size,
+                                                      uint32_t memory_type,
+                                                      const VkMemoryDedicatedAllocateInfo* dedicated_info);
+
+    [[nodiscard]] VkDeviceMemory allocate_memory(VkDeviceSize size,
+                                                 uint32_t memory_type,
+                                                 const void* next,
+                                                 void*& mapped);
+    void free_memory(VkDeviceMemory memory, VkDeviceSize size, uint32_t memory_type);
+
+    [[nodiscard]] uint32_t find_memory_type(uint32_t filter, VkMemoryPropertyFlags properties) const;
+    [[nodiscard]] VkDeviceSize block_size(uint32_t memory_type) const;
+    [[nodiscard]] HeapCounters& heap(uint32_t memory_type) {
+        return m_heaps[m_memory_properties.memoryTypes[memory_type].heapIndex];
+    }
+};
+
+} // namespace Phos
@@ -63,6 +63,7 @@ bool VulkanPhysicalDevice::is_suitable(const Requirements& requirements) const {
 
 VulkanPhysicalDevice::QueueFamilies VulkanPhysicalDevice::get_queue_families(const Requirements& requirements) const {
     QueueFamilies queue_families{};
+    bool found_transfer = false;
 
     const auto queue_family_properties = get_queue_family_properties();
 
@@ -75,8 +76,13 @@ VulkanPhysicalDevice::QueueFamilies VulkanPhysicalDevice::get_queue_families(con
         if (requirements.compute && (property.queueFlags & VK_QUEUE_COMPUTE_BIT))
             queue_families.compute = idx;
 
-        if (requirements.transfer && (property.queueFlags & VK_QUEUE_TRANSFER_BIT))
+        // Queues without graphics and compute support are usually backed by dedicated copy engines
+        const bool dedicated_transfer = (property.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+                                        !(property.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
+        if (requirements.transfer && dedicated_transfer) {
             queue_families.transfer = idx;
+            found_transfer = true;
+        }
 
         if (requirements.presentation) {
             VkBool32 presentation_supported;
@@ -88,6 +94,10 @@ VulkanPhysicalDevice::QueueFamilies VulkanPhysicalDevice::get_queue_families(con
         }
     }
 
+    // Graphics and compute queues can always be used for transfers
+    if (requirements.transfer && !found_transfer)
+        queue_families.transfer = requirements.graphics ? queue_families.graphics : queue_families.compute;
+
     return queue_families;
 }
 
@@ -140,4 +150,32 @@ VkPhysicalDeviceMemoryProperties VulkanPhysicalDevice::get_memory_properties() c
     return memory_properties;
 }
 
+VkPhysicalDeviceVulkan12Features VulkanPhysicalDevice::get_vulkan_12_features() const {
+    VkPhysicalDeviceVulkan12Features features_12{};
+    features_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &features_12;
+
+    vkGetPhysicalDeviceFeatures2(m_physical_device, &features);
+    features_12.pNext = nullptr;
+
+    return features_12;
+}
+
+VkPhysicalDeviceVulkan12Properties VulkanPhysicalDevice::get_vulkan_12_properties() const {
+    VkPhysicalDeviceVulkan12Properties properties_12{};
+    properties_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &properties_12;
+
+    vkGetPhysicalDeviceProperties2(m_physical_device, &properties);
+    properties_12.pNext = nullptr;
+
+    return properties_12;
+}
+
 } // namespace Phos
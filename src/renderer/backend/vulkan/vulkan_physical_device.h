@@ -39,6 +39,8 @@ class VulkanPhysicalDevice {
     [[nodiscard]] std::vector<VkQueueFamilyProperties> get_queue_family_properties() const;
     [[nodiscard]] VkPhysicalDeviceProperties get_properties() const;
     [[nodiscard]] VkPhysicalDeviceMemoryProperties get_memory_properties() const;
+    [[nodiscard]] VkPhysicalDeviceVulkan12Features get_vulkan_12_features() const;
+    [[nodiscard]] VkPhysicalDeviceVulkan12Properties get_vulkan_12_properties() const;
 
     [[nodiscard]] VkPhysicalDevice handle() const { return m_physical_device; }
 
@@ -0,0 +1,147 @@
+#include "vulkan_pipeline_cache.h"
+
+#include <fstream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#include "utility/logging.h"
+
+#include "vk_core.h"
+
+#include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_device.h"
+
+namespace Phos {
+
+constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x50484F53; // "PHOS"
+constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+VulkanPipelineCache::VulkanPipelineCache(std::filesystem::path path) : m_path(std::move(path)) {
+    std::vector<char> data;
+
+    std::ifstream file(m_path, std::ios::binary);
+    if (file) {
+        const auto expected = current_header();
+
+        Header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+
+        std::error_code error;
+        const auto file_size = std::filesystem::file_size(m_path, error);
+        const auto data_size = error || file_size < sizeof(Header) ? 0 : file_size - sizeof(Header);
+
+        // Only the first three fields are checked by the driver, the rest of the header is checked here
+        if (!file || header.magic != PIPELINE_CACHE_MAGIC || header.version != PIPELINE_CACHE_VERSION) {
+            PHOS_LOG_WARNING("Pipeline cache file '{}' is not valid, starting with an empty cache", m_path.string());
+        } else if (header.vendor_id != expected.vendor_id || header.device_id != expected.device_id
+                   || header.driver_version != expected.driver_version
+                   || std::memcmp(header.pipeline_cache_uuid, expected.pipeline_cache_uuid, VK_UUID_SIZE) != 0) {
+            PHOS_LOG_INFO("Pipeline cache file '{}' was created by a different device or driver, discarding it",
+                          m_path.string());
+        } else if (header.data_size != data_size) {
+            PHOS_LOG_WARNING("Pipeline cache file '{}' is truncated or corrupted, starting with an empty cache",
+                             m_path.string());
+        } else {
+            data.resize(header.data_size);
+            file.read(data.data(), static_cast<std::streamsize>(header.data_size));
+
+            if (!file) {
+                PHOS_LOG_WARNING("Pipeline cache file '{}' could not be read, starting with an empty cache",
+                                 m_path.string());
+                data.clear();
+            }
+        }
+    }
+
+    VkPipelineCacheCreateInfo create_info{};
+    create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    create_info.initialDataSize = data.size();
+    create_info.pInitialData = data.empty() ? nullptr : data.data();
+
+    VK_CHECK(vkCreatePipelineCache(VulkanContext::device->handle(), &create_info, nullptr, &m_cache));
+
+    if (!data.empty())
+        PHOS_LOG_INFO("Loaded pipeline cache from '{}' ({} bytes)", m_path.string(), data.size());
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+    vkDestroyPipelineCache(VulkanContext::device->handle(), m_cache, nullptr);
+}
+
+void VulkanPipelineCache::save() const {
+    const auto device = VulkanContext::device->handle();
+
+    size_t size;
+    VK_CHECK(vkGetPipelineCacheData(device, m_cache, &size, nullptr));
+
+    std::vector<char> data(size);
+    VK_CHECK(vkGetPipelineCacheData(device, m_cache, &size, data.data()));
+
+    std::error_code error;
+    if (m_path.has_parent_path())
+        std::filesystem::create_directories(m_path.parent_path(), error);
+
+    // Written to a temporary file first, so that a crash while saving does not leave a half written cache
+    auto temporary_path = m_path;
+    temporary_path += ".tmp";
+
+    {
+        auto header = current_header();
+        header.data_size = size;
+
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(data.data(), static_cast<std::streamsize>(size));
+
+        if (!file) {
+            PHOS_LOG_WARNING("Could not write pipeline cache file '{}'", temporary_path.string());
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporary_path, m_path, error);
+    if (error) {
+        PHOS_LOG_WARNING("Could not save pipeline cache to '{}': {}", m_path.string(), error.message());
+        return;
+    }
+
+    PHOS_LOG_INFO("Saved pipeline cache to '{}' ({} bytes)", m_path.string(), size);
+}
+
+std::filesystem::path VulkanPipelineCache::default_path() {
+    std::filesystem::path directory;
+
+#ifdef _WIN32
+    if (const char* local_app_data = std::getenv("LOCALAPPDATA"))
+        directory = local_app_data;
+#else
+    if (const char* xdg_cache_home = std::getenv("XDG_CACHE_HOME"))
+        directory = xdg_cache_home;
+    else if (const char* home = std::getenv("HOME"))
+        directory = std::filesystem::path(home) / ".cache";
+#endif
+
+    if (directory.empty()) {
+        std::error_code error;
+        directory = std::filesystem::temp_directory_path(error);
+    }
+
+    return directory / "phos" / "pipeline_cache.bin";
+}
+
+VulkanPipelineCache::Header VulkanPipelineCache::current_header() {
+    const auto properties = VulkanContext::device->physical_device().get_properties();
+
+    Header header{};
+    header.magic = PIPELINE_CACHE_MAGIC;
+    header.version = PIPELINE_CACHE_VERSION;
+    header.vendor_id = properties.vendorID;
+    header.device_id = properties.deviceID;
+    header.driver_version = properties.driverVersion;
+    std::memcpy(header.pipeline_cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    return header;
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <filesystem>
+#include <cstdint>
+
+namespace Phos {
+
+/// VkPipelineCache shared by every pipeline, persisted to disk so that pipelines compiled by the driver in previous
+/// runs do not need to be compiled again. The cache data is stored after a header with the device and driver it was
+/// created for, data written by a different device or driver version is discarded.
+class VulkanPipelineCache {
+  public:
+    /// Loads the cache from path, starts with an empty cache if the file does not exist or is not valid
+    explicit VulkanPipelineCache(std::filesystem::path path);
+    ~VulkanPipelineCache();
+
+    VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+    VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+    /// Writes the contents of the cache to the path it was loaded from
+    void save() const;
+
+    /// Path of the cache file in the cache directory of the user
+    [[nodiscard]] static std::filesystem::path default_path();
+
+    [[nodiscard]] VkPipelineCache handle() const { return m_cache; }
+
+  private:
+    VkPipelineCache m_cache{VK_NULL_HANDLE};
+    std::filesystem::path m_path;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vendor_id;
+        uint32_t device_id;
+        uint32_t driver_version;
+        uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+        uint64_t data_size;
+    };
+
+    [[nodiscard]] static Header current_header();
+};
+
+} // namespace Phos
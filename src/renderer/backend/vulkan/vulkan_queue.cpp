@@ -6,12 +6,47 @@
 
 #include "renderer/backend/vulkan/vulkan_command_buffer.h"
 #include "renderer/backend/vulkan/vulkan_swapchain.h"
+#include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_upload_manager.h"
 
 namespace Phos {
 
 VulkanQueue::VulkanQueue(VkQueue queue, uint32_t queue_family) : m_queue(queue), m_queue_family(queue_family) {}
 
-void VulkanQueue::submit(VkSubmitInfo info, VkFence fence) const {
+void VulkanQueue::submit(VkSubmitInfo info, VkFence fence, bool wait_for_uploads) const {
+    std::vector<VkSemaphore> wait_semaphores;
+    std::vector<VkPipelineStageFlags> wait_stages;
+    std::vector<uint64_t> wait_values;
+    VkTimelineSemaphoreSubmitInfo timeline_info{};
+
+    if (wait_for_uploads && VulkanContext::upload_manager != nullptr) {
+        const auto& upload_manager = VulkanContext::upload_manager;
+
+        // Uploads still in flight are waited for on the GPU, before any command that could read them
+        const auto ticket = upload_manager->flush();
+        if (!upload_manager->is_complete(ticket)) {
+            wait_semaphores.assign(info.pWaitSemaphores, info.pWaitSemaphores + info.waitSemaphoreCount);
+            wait_stages.assign(info.pWaitDstStageMask, info.pWaitDstStageMask + info.waitSemaphoreCount);
+            // Values of binary semaphores are ignored
+            wait_values.resize(info.waitSemaphoreCount, 0);
+
+            wait_semaphores.push_back(upload_manager->semaphore());
+            wait_stages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+            wait_values.push_back(ticket);
+
+            timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timeline_info.pNext = info.pNext;
+            timeline_info.waitSemaphoreValueCount = static_cast<uint32_t>(wait_values.size());
+            timeline_info.pWaitSemaphoreValues = wait_values.data();
+
+            info.pNext = &timeline_info;
+            info.waitSemaphoreCount = static_cast<uint32_t>(wait_semaphores.size());
+            info.pWaitSemaphores = wait_semaphores.data();
+            info.pWaitDstStageMask = wait_stages.data();
+        }
+    }
+
+    std::scoped_lock lock(m_mutex);
     VK_CHECK(vkQueueSubmit(m_queue, 1, &info, fence));
 }
 
@@ -29,6 +64,7 @@ VkResult VulkanQueue::submitKHR(const std::shared_ptr<VulkanSwapchain>& swapchai
     info.pSwapchains = swapchains.data();
     info.pImageIndices = &image_index;
 
+    std::scoped_lock lock(m_mutex);
     return vkQueuePresentKHR(m_queue, &info);
 }
 
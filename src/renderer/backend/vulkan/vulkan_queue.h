@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 #include <memory>
 #include <vector>
+#include <mutex>
 
 namespace Phos {
 
@@ -22,7 +23,9 @@ class VulkanQueue {
     explicit VulkanQueue(VkQueue queue, uint32_t queue_family);
     ~VulkanQueue() = default;
 
-    void submit(VkSubmitInfo info, VkFence fence) const;
+    /// The submission waits on the GPU for the uploads of VulkanUploadManager recorded before it, unless
+    /// wait_for_uploads is false. Submissions can be made from any thread.
+    void submit(VkSubmitInfo info, VkFence fence, bool wait_for_uploads = true) const;
 
     VkResult submitKHR(const std::shared_ptr<VulkanSwapchain>& swapchain,
                        uint32_t image_index,
@@ -34,6 +37,9 @@ class VulkanQueue {
   private:
     VkQueue m_queue;
     uint32_t m_queue_family;
+
+    // Queues are externally synchronized, and the same queue can be used for several types
+    mutable std::mutex m_mutex;
 };
 
 } // namespace Phos
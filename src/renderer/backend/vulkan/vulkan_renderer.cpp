@@ -1,5 +1,8 @@
 #include "vulkan_renderer.h"
 
+#include <bit>
+#include <cstring>
+
 #include "vk_core.h"
 
 #include "utility/profiling.h"
@@ -18,11 +21,14 @@
 #include "renderer/backend/vulkan/vulkan_framebuffer.h"
 #include "renderer/backend/vulkan/vulkan_queue.h"
 #include "renderer/backend/vulkan/vulkan_material.h"
+#include "renderer/backend/vulkan/vulkan_memory_allocator.h"
+#include "renderer/backend/vulkan/vulkan_upload_manager.h"
+#include "renderer/backend/vulkan/vulkan_bindless.h"
 
 namespace Phos {
 
 VulkanRenderer::VulkanRenderer(const RendererConfig& config) {
-    VulkanContext::init(config.window);
+    VulkanContext::init(config.window, config.pipeline_cache_path);
 
     m_graphics_queue = VulkanContext::device->get_graphics_queue();
 
@@ -41,11 +47,13 @@ VulkanRenderer::VulkanRenderer(const RendererConfig& config) {
 
     m_camera_ubos.resize(Renderer::config().num_frames);
     m_lights_ubos.resize(Renderer::config().num_frames);
+    m_instance_buffers.resize(Renderer::config().num_frames);
     m_frame_descriptor_sets.resize(Renderer::config().num_frames);
 
     for (uint32_t i = 0; i < Renderer::config().num_frames; ++i) {
         m_camera_ubos[i] = VulkanUniformBuffer::create<CameraUniformBuffer>();
         m_lights_ubos[i] = VulkanUniformBuffer::create<LightsUniformBuffer>();
+        m_instance_buffers[i] = create_instance_buffer(INITIAL_INSTANCE_CAPACITY);
 
         VkDescriptorBufferInfo camera_info{};
         camera_info.buffer = m_camera_ubos[i]->handle();
@@ -57,10 +65,16 @@ VulkanRenderer::VulkanRenderer(const RendererConfig& config) {
         lights_info.range = m_lights_ubos[i]->size();
         lights_info.offset = 0;
 
+        VkDescriptorBufferInfo instances_info{};
+        instances_info.buffer = m_instance_buffers[i].buffer->handle();
+        instances_info.range = VK_WHOLE_SIZE;
+        instances_info.offset = 0;
+
         [[maybe_unused]] const bool built =
             VulkanDescriptorBuilder::begin(VulkanContext::descriptor_layout_cache, m_allocator)
                 .bind_buffer(0, &camera_info, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
                 .bind_buffer(1, &lights_info, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .bind_buffer(2, &instances_info, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
                 .build(m_frame_descriptor_sets[i]);
 
         PHOS_ASSERT(built, "Error creating frame descriptor set");
@@ -90,6 +104,9 @@ VulkanRenderer::~VulkanRenderer() {
     m_camera_ubos.clear();
     m_lights_ubos.clear();
 
+    // Destroy instance buffers
+    m_instance_buffers.clear();
+
     // Destroy screen quads
     m_screen_quad_vertex.reset();
     m_screen_quad_index.reset();
@@ -111,6 +128,16 @@ void VulkanRenderer::begin_frame(const FrameInformation& info) {
     }
     vkResetFences(VulkanContext::device->handle(), 1, &m_in_flight_fences[m_current_frame]);
 
+    // Transient memory of the frame is no longer in use, the instance buffer is allocated again from it
+    VulkanContext::memory_allocator->begin_frame(m_current_frame);
+    set_instance_buffer(create_instance_buffer(m_instance_buffers[m_current_frame].capacity));
+
+    // Bindless textures and materials released while the frame was last recorded can be reused
+    VulkanContext::bindless->begin_frame(m_current_frame);
+
+    // Release the staging memory of finished uploads
+    VulkanContext::upload_manager->collect();
+
     //
     // Update frame descriptors
     //
@@ -179,6 +206,62 @@ void VulkanRenderer::submit_static_mesh(const std::shared_ptr<CommandBuffer>& co
     }
 }
 
+void VulkanRenderer::submit_static_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                                        const std::shared_ptr<StaticMesh>& mesh,
+                                        const std::shared_ptr<Material>& material,
+                                        std::span<const uint32_t> sub_meshes) {
+    const auto& native_command_buffer = std::dynamic_pointer_cast<VulkanCommandBuffer>(command_buffer);
+
+    const auto& native_material = std::dynamic_pointer_cast<VulkanMaterial>(material);
+    native_material->bind(native_command_buffer);
+
+    for (const auto sub_mesh_idx : sub_meshes) {
+        const auto& sub_mesh = mesh->sub_meshes()[sub_mesh_idx];
+
+        const auto& native_vertex = std::dynamic_pointer_cast<VulkanVertexBuffer>(sub_mesh->vertex_buffer());
+        const auto& native_index = std::dynamic_pointer_cast<VulkanIndexBuffer>(sub_mesh->index_buffer());
+
+        VulkanRendererAPI::draw_indexed(native_command_buffer, native_vertex, native_index);
+    }
+}
+
+void VulkanRenderer::bind_material(const std::shared_ptr<CommandBuffer>& command_buffer,
+                                   const std::shared_ptr<Material>& material) {
+    const auto& native_command_buffer = std::dynamic_pointer_cast<VulkanCommandBuffer>(command_buffer);
+    const auto& native_material = std::dynamic_pointer_cast<VulkanMaterial>(material);
+
+    native_material->bind(native_command_buffer);
+}
+
+void VulkanRenderer::bind_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                                   const std::shared_ptr<SubMesh>& sub_mesh) {
+    const auto& native_command_buffer = std::dynamic_pointer_cast<VulkanCommandBuffer>(command_buffer);
+
+    sub_mesh->vertex_buffer()->bind(native_command_buffer);
+    sub_mesh->index_buffer()->bind(native_command_buffer);
+}
+
+void VulkanRenderer::draw_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                                   const std::shared_ptr<SubMesh>& sub_mesh,
+                                   uint32_t first_instance,
+                                   uint32_t instance_count) {
+    const auto& native_command_buffer = std::dynamic_pointer_cast<VulkanCommandBuffer>(command_buffer);
+    vkCmdDrawIndexed(
+        native_command_buffer->handle(), sub_mesh->index_buffer()->count(), instance_count, 0, 0, first_instance);
+}
+
+void VulkanRenderer::update_instances(std::span<const InstanceData> instances) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanRenderer::update_instances");
+
+    // Keeps the grown capacity for the next frames, the previous buffer is released with the transient memory
+    if (instances.size() > m_instance_buffers[m_current_frame].capacity)
+        set_instance_buffer(create_instance_buffer(std::bit_ceil(static_cast<uint32_t>(instances.size()))));
+
+    const auto& instance_buffer = m_instance_buffers[m_current_frame];
+    if (!instances.empty())
+        memcpy(instance_buffer.memory, instances.data(), instances.size_bytes());
+}
+
 void VulkanRenderer::bind_graphics_pipeline(const std::shared_ptr<CommandBuffer>& command_buffer,
                                             const std::shared_ptr<GraphicsPipeline>& pipeline) {
     const auto& native_command_buffer = std::dynamic_pointer_cast<VulkanCommandBuffer>(command_buffer);
@@ -248,4 +331,42 @@ void VulkanRenderer::draw_screen_quad(const std::shared_ptr<CommandBuffer>& comm
     VulkanRendererAPI::draw_indexed(native_command_buffer, m_screen_quad_vertex, m_screen_quad_index);
 }
 
+std::vector<GpuMemoryHeapStatistics> VulkanRenderer::memory_statistics() {
+    return VulkanContext::memory_allocator->statistics();
+}
+
+void VulkanRenderer::set_instance_buffer(InstanceBuffer instance_buffer) {
+    m_instance_buffers[m_current_frame] = std::move(instance_buffer);
+
+    VkDescriptorBufferInfo instances_info{};
+    instances_info.buffer = m_instance_buffers[m_current_frame].buffer->handle();
+    instances_info.range = VK_WHOLE_SIZE;
+    instances_info.offset = 0;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = m_frame_descriptor_sets[m_current_frame];
+    write.dstBinding = 2;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &instances_info;
+
+    vkUpdateDescriptorSets(VulkanContext::device->handle(), 1, &write, 0, nullptr);
+}
+
+VulkanRenderer::InstanceBuffer VulkanRenderer::create_instance_buffer(uint32_t capacity) {
+    auto instance_buffer = InstanceBuffer{
+        .buffer = std::make_unique<VulkanBuffer>(capacity * sizeof(InstanceData),
+                                                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                 true),
+        .memory = nullptr,
+        .capacity = capacity,
+    };
+    instance_buffer.buffer->map_memory(instance_buffer.memory);
+
+    return instance_buffer;
+}
+
 } // namespace Phos
\ No newline at end of file
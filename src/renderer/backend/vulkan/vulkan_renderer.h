@@ -15,6 +15,7 @@ class VulkanIndexBuffer;
 class VulkanSwapchain;
 class VulkanQueue;
 class VulkanDescriptorAllocator;
+class VulkanBuffer;
 
 class VulkanRenderer : public INativeRenderer {
   public:
@@ -32,6 +33,22 @@ class VulkanRenderer : public INativeRenderer {
                             const std::shared_ptr<StaticMesh>& mesh,
                             const std::shared_ptr<Material>& material) override;
 
+    void submit_static_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                            const std::shared_ptr<StaticMesh>& mesh,
+                            const std::shared_ptr<Material>& material,
+                            std::span<const uint32_t> sub_meshes) override;
+
+    void bind_material(const std::shared_ptr<CommandBuffer>& command_buffer,
+                       const std::shared_ptr<Material>& material) override;
+    void bind_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                       const std::shared_ptr<SubMesh>& sub_mesh) override;
+    void draw_sub_mesh(const std::shared_ptr<CommandBuffer>& command_buffer,
+                       const std::shared_ptr<SubMesh>& sub_mesh,
+                       uint32_t first_instance,
+                       uint32_t instance_count) override;
+
+    void update_instances(std::span<const InstanceData> instances) override;
+
     void begin_render_pass(const std::shared_ptr<CommandBuffer>& command_buffer,
                            const std::shared_ptr<RenderPass>& render_pass) override;
 
@@ -43,6 +60,7 @@ class VulkanRenderer : public INativeRenderer {
     void draw_screen_quad(const std::shared_ptr<CommandBuffer>& command_buffer) override;
 
     [[nodiscard]] uint32_t current_frame() override { return m_current_frame; }
+    [[nodiscard]] std::vector<GpuMemoryHeapStatistics> memory_statistics() override;
 
   private:
     std::shared_ptr<VulkanQueue> m_graphics_queue;
@@ -89,6 +107,17 @@ class VulkanRenderer : public INativeRenderer {
     std::vector<std::shared_ptr<VulkanUniformBuffer>> m_camera_ubos;
     std::vector<std::shared_ptr<VulkanUniformBuffer>> m_lights_ubos;
 
+    // Storage buffer with the InstanceData of the frame, allocated from the transient memory of the frame in every
+    // begin_frame. Its capacity grows when a frame needs more instances.
+    struct InstanceBuffer {
+        std::unique_ptr<VulkanBuffer> buffer;
+        void* memory = nullptr;
+        uint32_t capacity = 0;
+    };
+    std::vector<InstanceBuffer> m_instance_buffers;
+
+    static constexpr uint32_t INITIAL_INSTANCE_CAPACITY = 1024;
+
     std::vector<VkDescriptorSet> m_frame_descriptor_sets;
 
     // Screen quad info
@@ -99,6 +128,10 @@ class VulkanRenderer : public INativeRenderer {
 
     std::shared_ptr<VulkanVertexBuffer> m_screen_quad_vertex;
     std::shared_ptr<VulkanIndexBuffer> m_screen_quad_index;
+
+    // Replaces the instance buffer of the current frame and points the frame descriptor set to it
+    void set_instance_buffer(InstanceBuffer instance_buffer);
+    [[nodiscard]] static InstanceBuffer create_instance_buffer(uint32_t capacity);
 };
 
 } // namespace Phos
\ No newline at end of file
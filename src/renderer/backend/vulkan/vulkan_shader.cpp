@@ -14,6 +14,7 @@
 #include "renderer/backend/vulkan/vulkan_utils.h"
 #include "renderer/backend/vulkan/vulkan_descriptors.h"
 #include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_bindless.h"
 
 namespace Phos {
 
@@ -154,15 +155,26 @@ std::optional<VulkanPushConstantInfo> VulkanShader::push_constant_info(std::stri
 std::vector<ShaderProperty> VulkanShader::get_shader_properties() const {
     std::vector<ShaderProperty> properties;
 
-    const auto& descriptors = descriptors_in_set(2);
+    // Bindless materials only have the material buffer, with textures referenced by index
+    const auto material_set = m_bindless ? VulkanBindlessResources::BINDLESS_DESCRIPTOR_SET : 2;
+
+    const auto& descriptors = descriptors_in_set(material_set);
     for (const auto& info : descriptors) {
-        if (info.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
+        if (info.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER && !m_bindless) {
             properties.push_back({
                 .type = ShaderProperty::Type::Texture,
                 .name = info.name,
             });
-        } else if (info.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+        } else if (info.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || info.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
             for (const auto& member : info.members) {
+                if (member.texture_index) {
+                    properties.push_back({
+                        .type = ShaderProperty::Type::Texture,
+                        .name = member.name,
+                    });
+                    continue;
+                }
+
                 ShaderProperty::Type type;
                 if (member.size == sizeof(float))
                     type = ShaderProperty::Type::Float;
@@ -265,21 +277,7 @@ void VulkanShader::retrieve_descriptor_sets_info(const SpvReflectShaderModule& v
     retrieve_set_bindings(vertex_descriptor_sets, VK_SHADER_STAGE_VERTEX_BIT, set_bindings);
     retrieve_set_bindings(fragment_descriptor_sets, VK_SHADER_STAGE_FRAGMENT_BIT, set_bindings);
 
-    // Create descriptor set create info
-    for (uint32_t i = 0; i < MAX_DESCRIPTOR_SET; ++i) {
-        const auto bindings = set_bindings[i];
-
-        VkDescriptorSetLayoutCreateInfo descriptor_set_create_info{};
-        descriptor_set_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        descriptor_set_create_info.bindingCount = static_cast<uint32_t>(bindings.size());
-        descriptor_set_create_info.pBindings = bindings.data();
-
-        const auto layout =
-            VulkanContext::descriptor_layout_cache->create_descriptor_layout(descriptor_set_create_info);
-        PHOS_ASSERT(layout != VK_NULL_HANDLE, "Layout has null");
-
-        m_descriptor_set_layouts.push_back(layout);
-    }
+    create_descriptor_set_layouts(set_bindings);
 }
 
 void VulkanShader::retrieve_descriptor_sets_info(const SpvReflectShaderModule& reflect_module) {
@@ -295,10 +293,20 @@ void VulkanShader::retrieve_descriptor_sets_info(const SpvReflectShaderModule& r
     retrieve_set_bindings(
         descriptor_sets, static_cast<VkShaderStageFlagBits>(reflect_module.shader_stage), set_bindings);
 
-    // Create descriptor set create info
+    create_descriptor_set_layouts(set_bindings);
+}
+
+void VulkanShader::create_descriptor_set_layouts(
+    const std::vector<std::vector<VkDescriptorSetLayoutBinding>>& set_bindings) {
     for (uint32_t i = 0; i < MAX_DESCRIPTOR_SET; ++i) {
         const auto bindings = set_bindings[i];
 
+        // Every bindless shader shares the same layout, which is not created from reflection
+        if (i == VulkanBindlessResources::BINDLESS_DESCRIPTOR_SET && !bindings.empty()) {
+            m_descriptor_set_layouts.push_back(VulkanContext::bindless->descriptor_set_layout());
+            continue;
+        }
+
         VkDescriptorSetLayoutCreateInfo descriptor_set_create_info{};
         descriptor_set_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         descriptor_set_create_info.bindingCount = static_cast<uint32_t>(bindings.size());
@@ -350,6 +358,36 @@ void VulkanShader::retrieve_set_bindings(const std::vector<SpvReflectDescriptorS
             descriptor_info.size = set_binding->block.size;
             descriptor_info.count = set_binding->count;
 
+            if (set_info->set == VulkanBindlessResources::BINDLESS_DESCRIPTOR_SET) {
+                m_bindless = true;
+
+                // The material buffer holds an array of material structs, described by its only member
+                if (descriptor_info.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
+                    PHOS_ASSERT(set_binding->binding == VulkanBindlessResources::MATERIALS_BINDING &&
+                                    set_binding->block.member_count == 1,
+                                "Bindless material buffer {} is not valid",
+                                descriptor_info.name);
+
+                    const auto& materials = set_binding->block.members[0];
+                    descriptor_info.size = materials.array.stride;
+
+                    for (uint32_t j = 0; j < materials.member_count; ++j) {
+                        const auto& mem = materials.members[j];
+
+                        const VulkanUniformBufferMember member = {
+                            .name = mem.name,
+                            .size = mem.size,
+                            .offset = mem.offset,
+                            .texture_index = (mem.type_description->type_flags & SPV_REFLECT_TYPE_FLAG_INT) != 0,
+                        };
+                        descriptor_info.members.push_back(member);
+                    }
+                }
+
+                m_descriptor_info.insert({descriptor_info.name, descriptor_info});
+                continue;
+            }
+
             for (uint32_t j = 0; j < set_binding->block.member_count; ++j) {
                 const auto mem = set_binding->block.members[j];
 
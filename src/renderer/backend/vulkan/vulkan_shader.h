@@ -21,6 +21,8 @@ struct VulkanUniformBufferMember {
     std::string name;
     uint32_t size;
     uint32_t offset;
+    // uint member of a bindless material, holds the index of a texture in the bindless texture array
+    bool texture_index = false;
 };
 
 struct VulkanDescriptorInfo {
@@ -65,6 +67,9 @@ class VulkanShader : public Shader {
 
     [[nodiscard]] VkPipelineLayout get_pipeline_layout() const { return m_pipeline_layout; }
 
+    /// Whether the shader reads its material from the bindless descriptor set
+    [[nodiscard]] bool is_bindless() const { return m_bindless; }
+
     [[nodiscard]] std::vector<ShaderProperty> get_shader_properties() const override;
 
   private:
@@ -76,6 +81,7 @@ class VulkanShader : public Shader {
     std::vector<VkPushConstantRange> m_push_constant_ranges;
 
     VkPipelineLayout m_pipeline_layout{};
+    bool m_bindless = false;
 
     std::unordered_map<std::string, VulkanDescriptorInfo> m_descriptor_info;
     std::unordered_map<std::string, VulkanPushConstantInfo> m_push_constant_info;
@@ -90,6 +96,7 @@ class VulkanShader : public Shader {
     void retrieve_descriptor_sets_info(const SpvReflectShaderModule& vertex_module,
                                        const SpvReflectShaderModule& fragment_module);
     void retrieve_descriptor_sets_info(const SpvReflectShaderModule& reflect_module);
+    void create_descriptor_set_layouts(const std::vector<std::vector<VkDescriptorSetLayoutBinding>>& set_bindings);
     void retrieve_set_bindings(const std::vector<SpvReflectDescriptorSet*>& descriptor_sets,
                                VkShaderStageFlags stage,
                                std::vector<std::vector<VkDescriptorSetLayoutBinding>>& set_bindings);
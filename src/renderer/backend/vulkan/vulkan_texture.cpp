@@ -7,9 +7,9 @@
 #include "utility/logging.h"
 
 #include "renderer/backend/vulkan/vulkan_device.h"
-#include "renderer/backend/vulkan/vulkan_buffer.h"
 #include "renderer/backend/vulkan/vulkan_image.h"
 #include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_upload_manager.h"
 
 namespace Phos {
 
@@ -36,16 +36,6 @@ VulkanTexture::VulkanTexture(const std::string& path) {
 
     const auto image_size = static_cast<uint32_t>(width * height * 4 * type_size);
 
-    const auto staging_buffer = VulkanBuffer{
-        image_size,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-    };
-
-    staging_buffer.copy_data(pixels);
-
-    stbi_image_free(pixels);
-
     // Create image
     const auto description = VulkanImage::Description{
         .width = static_cast<uint32_t>(width),
@@ -56,14 +46,10 @@ VulkanTexture::VulkanTexture(const std::string& path) {
     };
     m_image = std::make_shared<VulkanImage>(description);
 
-    // Transition image layout for copying
-    m_image->transition_layout(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    // Copy staging buffer to image
-    staging_buffer.copy_to_image(*m_image);
+    // Upload pixels, the image is left ready for shader access
+    VulkanContext::upload_manager->upload_image(*m_image, pixels, image_size);
 
-    // Transition image layout for shader access
-    m_image->transition_layout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    stbi_image_free(pixels);
 
     // Create sampler
     VkSamplerCreateInfo sampler_info{};
@@ -129,14 +115,6 @@ VulkanTexture::VulkanTexture(const std::vector<char>& data, uint32_t width, uint
     if (image_size != data.size())
         PHOS_LOG_WARNING("Size of data is not the same as the provided image size (width * height * 4)");
 
-    const auto staging_buffer = VulkanBuffer{
-        image_size,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-    };
-
-    staging_buffer.copy_data(data.data());
-
     // Create image
     const auto description = VulkanImage::Description{
         .width = width,
@@ -147,14 +125,8 @@ VulkanTexture::VulkanTexture(const std::vector<char>& data, uint32_t width, uint
     };
     m_image = std::make_shared<VulkanImage>(description);
 
-    // Transition image layout for copying
-    m_image->transition_layout(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    // Copy staging buffer to image
-    staging_buffer.copy_to_image(*m_image);
-
-    // Transition image layout for shader access
-    m_image->transition_layout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // Upload data, the image is left ready for shader access
+    VulkanContext::upload_manager->upload_image(*m_image, data.data(), image_size);
 
     // Create sampler
     VkSamplerCreateInfo sampler_info{};
@@ -0,0 +1,340 @@
+#include "vulkan_upload_manager.h"
+
+#include <cstring>
+
+#include "utility/logging.h"
+#include "utility/profiling.h"
+
+#include "vk_core.h"
+
+#include "renderer/backend/vulkan/vulkan_context.h"
+#include "renderer/backend/vulkan/vulkan_device.h"
+#include "renderer/backend/vulkan/vulkan_queue.h"
+#include "renderer/backend/vulkan/vulkan_command_pool.h"
+#include "renderer/backend/vulkan/vulkan_buffer.h"
+#include "renderer/backend/vulkan/vulkan_image.h"
+
+namespace Phos {
+
+VulkanUploadManager::VulkanUploadManager() {
+    m_queue = VulkanContext::device->get_transfer_queue();
+    m_command_pool = std::make_unique<VulkanCommandPool>(VulkanContext::device->handle(), m_queue->family());
+
+    // Timeline semaphore
+    VkSemaphoreTypeCreateInfo type_info{};
+    type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    type_info.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphore_info{};
+    semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphore_info.pNext = &type_info;
+
+    VK_CHECK(vkCreateSemaphore(VulkanContext::device->handle(), &semaphore_info, nullptr, &m_semaphore));
+
+    // Staging ring
+    m_ring = std::make_unique<VulkanBuffer>(STAGING_RING_SIZE,
+                                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    void* ring_memory;
+    m_ring->map_memory(ring_memory);
+    m_ring_memory = static_cast<char*>(ring_memory);
+}
+
+VulkanUploadManager::~VulkanUploadManager() {
+    wait(flush());
+
+    {
+        std::scoped_lock lock(m_mutex);
+        while (!m_in_flight.empty())
+            retire_oldest(true);
+    }
+
+    // Command buffers are freed with the pool
+    m_command_pool.reset();
+    m_ring.reset();
+
+    vkDestroySemaphore(VulkanContext::device->handle(), m_semaphore, nullptr);
+}
+
+VulkanUploadManager::Ticket VulkanUploadManager::upload_buffer(const VulkanBuffer& buffer,
+                                                               const void* data,
+                                                               VkDeviceSize size,
+                                                               VkDeviceSize offset) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanUploadManager::upload_buffer");
+
+    std::scoped_lock lock(m_mutex);
+
+    const auto staging = stage(data, size, 16);
+
+    VkBufferCopy copy{};
+    copy.srcOffset = staging.offset;
+    copy.dstOffset = offset;
+    copy.size = size;
+
+    vkCmdCopyBuffer(m_recording.command_buffer, staging.buffer, buffer.handle(), 1, &copy);
+
+    return end_upload(size);
+}
+
+VulkanUploadManager::Ticket VulkanUploadManager::upload_image(const VulkanImage& image,
+                                                              const void* data,
+                                                              VkDeviceSize size) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanUploadManager::upload_image");
+
+    std::scoped_lock lock(m_mutex);
+
+    // Multiple of the size of every color format
+    const auto staging = stage(data, size, 16);
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.handle();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = image.num_mips();
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = image.num_layers();
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(m_recording.command_buffer,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &barrier);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = staging.offset;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = image.num_layers();
+
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {image.width(), image.height(), 1};
+
+    vkCmdCopyBufferToImage(m_recording.command_buffer,
+                           staging.buffer,
+                           image.handle(),
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1,
+                           &region);
+
+    // Shader stages might not be supported by the transfer queue, the writes are made visible to the queues that use
+    // the image by waiting for the semaphore
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+
+    vkCmdPipelineBarrier(m_recording.command_buffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &barrier);
+
+    return end_upload(size);
+}
+
+VulkanUploadManager::Ticket VulkanUploadManager::flush() {
+    std::scoped_lock lock(m_mutex);
+
+    if (m_recording.command_buffer != VK_NULL_HANDLE)
+        submit_batch();
+
+    return m_last_submitted;
+}
+
+void VulkanUploadManager::collect() {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanUploadManager::collect");
+
+    std::scoped_lock lock(m_mutex);
+    while (!m_in_flight.empty() && retire_oldest(false)) {}
+}
+
+bool VulkanUploadManager::is_complete(Ticket ticket) const {
+    return completed_value() >= ticket;
+}
+
+void VulkanUploadManager::wait(Ticket ticket) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanUploadManager::wait");
+
+    {
+        std::scoped_lock lock(m_mutex);
+        if (ticket > m_last_submitted && m_recording.command_buffer != VK_NULL_HANDLE)
+            submit_batch();
+
+        PHOS_ASSERT(ticket <= m_last_submitted, "Ticket {} does not belong to any upload", ticket);
+    }
+
+    VkSemaphoreWaitInfo wait_info{};
+    wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    wait_info.semaphoreCount = 1;
+    wait_info.pSemaphores = &m_semaphore;
+    wait_info.pValues = &ticket;
+
+    VK_CHECK(vkWaitSemaphores(VulkanContext::device->handle(), &wait_info, UINT64_MAX));
+}
+
+VulkanUploadManager::StagingRange VulkanUploadManager::stage(const void* data,
+                                                             VkDeviceSize size,
+                                                             VkDeviceSize alignment) {
+    if (m_recording.command_buffer == VK_NULL_HANDLE)
+        begin_batch();
+
+    // Big uploads would make every other upload wait for the ring
+    if (size > STAGING_RING_SIZE / 4) {
+        auto staging_buffer = std::make_unique<VulkanBuffer>(
+            size,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        staging_buffer->copy_data(data);
+
+        const auto handle = staging_buffer->handle();
+        m_recording.staging_buffers.push_back(std::move(staging_buffer));
+
+        return StagingRange{.buffer = handle, .offset = 0};
+    }
+
+    while (true) {
+        if (m_ring_used == 0)
+            m_ring_head = 0;
+
+        // Ranges never wrap around, the end of the ring is skipped instead
+        auto offset = (m_ring_head + alignment - 1) & ~(alignment - 1);
+        if (offset + size > STAGING_RING_SIZE)
+            offset = 0;
+
+        const auto padding = offset >= m_ring_head ? offset - m_ring_head : STAGING_RING_SIZE - m_ring_head;
+        const auto needed = padding + size;
+
+        if (m_ring_used + needed <= STAGING_RING_SIZE) {
+            memcpy(m_ring_memory + offset, data, size);
+
+            m_ring_head = offset + size;
+            m_ring_used += needed;
+            m_recording.ring_bytes += needed;
+
+            return StagingRange{.buffer = m_ring->handle(), .offset = offset};
+        }
+
+        // The ring is full, so the oldest batch has to finish. If every byte is used by the recording batch, it is
+        // submitted and the upload continues in a new one.
+        PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanUploadManager::stage::ringFull");
+
+        if (m_in_flight.empty()) {
+            submit_batch();
+            begin_batch();
+        }
+
+        retire_oldest(true);
+    }
+}
+
+VulkanUploadManager::Ticket VulkanUploadManager::end_upload(VkDeviceSize size) {
+    const auto ticket = m_recording.ticket;
+
+    m_recording.upload_bytes += size;
+    if (m_recording.upload_bytes >= MAX_BATCH_SIZE)
+        submit_batch();
+
+    return ticket;
+}
+
+void VulkanUploadManager::begin_batch() {
+    VkCommandBuffer command_buffer;
+    if (m_free_command_buffers.empty()) {
+        command_buffer = m_command_pool->allocate(1)[0];
+    } else {
+        command_buffer = m_free_command_buffers.back();
+        m_free_command_buffers.pop_back();
+    }
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    // Begin implicitly resets the command buffer
+    VK_CHECK(vkBeginCommandBuffer(command_buffer, &begin_info));
+
+    m_recording = Batch{
+        .command_buffer = command_buffer,
+        .ticket = m_last_submitted + 1,
+    };
+}
+
+void VulkanUploadManager::submit_batch() {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("VulkanUploadManager::submit_batch");
+
+    VK_CHECK(vkEndCommandBuffer(m_recording.command_buffer));
+
+    VkTimelineSemaphoreSubmitInfo timeline_info{};
+    timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timeline_info.signalSemaphoreValueCount = 1;
+    timeline_info.pSignalSemaphoreValues = &m_recording.ticket;
+
+    VkSubmitInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    info.pNext = &timeline_info;
+    info.commandBufferCount = 1;
+    info.pCommandBuffers = &m_recording.command_buffer;
+    info.signalSemaphoreCount = 1;
+    info.pSignalSemaphores = &m_semaphore;
+
+    m_queue->submit(info, VK_NULL_HANDLE, false);
+
+    m_last_submitted = m_recording.ticket;
+    m_in_flight.push_back(std::move(m_recording));
+    m_recording = Batch{};
+}
+
+bool VulkanUploadManager::retire_oldest(bool block) {
+    auto& batch = m_in_flight.front();
+
+    if (block) {
+        VkSemaphoreWaitInfo wait_info{};
+        wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.semaphoreCount = 1;
+        wait_info.pSemaphores = &m_semaphore;
+        wait_info.pValues = &batch.ticket;
+
+        VK_CHECK(vkWaitSemaphores(VulkanContext::device->handle(), &wait_info, UINT64_MAX));
+    } else if (completed_value() < batch.ticket) {
+        return false;
+    }
+
+    // Batches finish in order, so the staging memory of the oldest batch is always right after the free space
+    m_ring_used -= batch.ring_bytes;
+    m_free_command_buffers.push_back(batch.command_buffer);
+
+    m_in_flight.pop_front();
+    return true;
+}
+
+VulkanUploadManager::Ticket VulkanUploadManager::completed_value() const {
+    uint64_t value;
+    VK_CHECK(vkGetSemaphoreCounterValue(VulkanContext::device->handle(), m_semaphore, &value));
+
+    return value;
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstdint>
+
+namespace Phos {
+
+// Forward declarations
+class VulkanBuffer;
+class VulkanImage;
+class VulkanQueue;
+class VulkanCommandPool;
+
+/// Copies data to device local buffers and images without stalling the calling thread. Data is written to a
+/// persistently mapped staging ring and the copies are recorded in batches, which are submitted to the transfer queue
+/// (a dedicated one if the device has it) when they grow big enough or when another queue submits work. Every batch
+/// signals a timeline semaphore with its ticket, which VulkanQueue::submit waits for on the GPU, so that uploaded
+/// resources can be used right away. The CPU only waits when the staging ring is full.
+class VulkanUploadManager {
+  public:
+    /// Value of the timeline semaphore signaled when an upload has finished
+    using Ticket = uint64_t;
+
+    static constexpr VkDeviceSize STAGING_RING_SIZE = 64ull * 1024 * 1024;
+    // Batches are submitted once their uploads reach this size, so that copies start while the next ones are recorded
+    static constexpr VkDeviceSize MAX_BATCH_SIZE = 16ull * 1024 * 1024;
+
+    VulkanUploadManager();
+    ~VulkanUploadManager();
+
+    VulkanUploadManager(const VulkanUploadManager&) = delete;
+    VulkanUploadManager& operator=(const VulkanUploadManager&) = delete;
+
+    /// Copies size bytes of data into buffer at offset. The buffer must have been created with
+    /// VK_BUFFER_USAGE_TRANSFER_DST_BIT and must outlive the upload.
+    Ticket upload_buffer(const VulkanBuffer& buffer, const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+    /// Copies data into the first mip of every layer of image, which is left in SHADER_READ_ONLY_OPTIMAL layout. The
+    /// image must have been created with transfer enabled and must outlive the upload.
+    Ticket upload_image(const VulkanImage& image, const void* data, VkDeviceSize size);
+
+    /// Submits the uploads recorded so far, returns the ticket of the last submitted batch
+    Ticket flush();
+    /// Releases the staging memory of the batches that have finished, to be called regularly (once per frame)
+    void collect();
+
+    [[nodiscard]] bool is_complete(Ticket ticket) const;
+    /// Blocks until ticket has finished, submitting its batch if needed
+    void wait(Ticket ticket);
+
+    [[nodiscard]] VkSemaphore semaphore() const { return m_semaphore; }
+
+  private:
+    std::shared_ptr<VulkanQueue> m_queue;
+    std::unique_ptr<VulkanCommandPool> m_command_pool;
+
+    VkSemaphore m_semaphore{VK_NULL_HANDLE};
+
+    // Staging ring, the m_ring_used bytes before m_ring_head (wrapping around) are in use by batches
+    std::unique_ptr<VulkanBuffer> m_ring;
+    char* m_ring_memory = nullptr;
+    VkDeviceSize m_ring_head = 0;
+    VkDeviceSize m_ring_used = 0;
+
+    struct Batch {
+        VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+        Ticket ticket = 0;
+
+        // Bytes of the ring used by the batch, including the padding
+        VkDeviceSize ring_bytes = 0;
+        VkDeviceSize upload_bytes = 0;
+
+        // Uploads that do not fit in the ring get their own staging buffer
+        std::vector<std::unique_ptr<VulkanBuffer>> staging_buffers;
+    };
+
+    // Batch being recorded, its command buffer is VK_NULL_HANDLE if it has no uploads yet
+    Batch m_recording;
+    // Submitted batches, from oldest to newest
+    std::deque<Batch> m_in_flight;
+    std::vector<VkCommandBuffer> m_free_command_buffers;
+
+    Ticket m_last_submitted = 0;
+
+    mutable std::mutex m_mutex;
+
+    struct StagingRange {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+    };
+    // Copies data to staging memory for the recording batch, which is started if needed
+    [[nodiscard]] StagingRange stage(const void* data, VkDeviceSize size, VkDeviceSize alignment);
+    // Accounts for an upload recorded in the recording batch and returns its ticket
+    Ticket end_upload(VkDeviceSize size);
+
+    void begin_batch();
+    void submit_batch();
+    // Retires the oldest batch in flight, waiting for it if block is true. Returns false if it has not finished.
+    bool retire_oldest(bool block);
+
+    [[nodiscard]] Ticket completed_value() const;
+};
+
+} // namespace Phos
@@ -3,25 +3,13 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "renderer/frustum_culling.h"
+
 namespace Phos {
 
 // Forward declarations
 struct AABB;
 
-struct Plane {
-    glm::vec3 normal = glm::vec3(0.0f);
-    float distance = 0.0f;
-};
-
-struct Frustum {
-    Plane top;
-    Plane bottom;
-    Plane left;
-    Plane right;
-    Plane near;
-    Plane far;
-};
-
 class Camera {
   public:
     enum class Type {
@@ -43,10 +31,12 @@ class Camera {
 
     [[nodiscard]] const glm::mat4& view_matrix() const { return m_view; }
     [[nodiscard]] const glm::mat4& projection_matrix() const { return m_projection; }
+    [[nodiscard]] const Frustum& frustum() const { return m_frustum; }
 
   protected:
     glm::mat4 m_projection{};
     glm::mat4 m_view{};
+    Frustum m_frustum{};
 
     glm::vec3 m_position{0.0f, 0.0f, 0.0f};
     glm::quat m_rotation{1.0f, 0.0f, 0.0f, 0.0f};
@@ -70,7 +60,6 @@ class PerspectiveCamera : public Camera {
 
   private:
     float m_fov, m_aspect, m_znear, m_zfar;
-    Frustum m_frustum;
 
     void recalculate_projection_matrix();
     void recalculate_frustum() override;
@@ -1,9 +1,7 @@
 #include "deferred_renderer.h"
 
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtx/rotate_vector.hpp>
 #include <utility>
-#include <stack>
 
 #include "core/window.h"
 
@@ -13,9 +11,14 @@
 #include "managers/shader_manager.h"
 
 #include "scene/scene.h"
+#include "scene/transform_system.h"
+#include "scene/spatial_index_system.h"
 
 #include "renderer/mesh.h"
 #include "renderer/camera.h"
+#include "renderer/frustum_culling.h"
+#include "renderer/occlusion_culling.h"
+#include "renderer/render_queue.h"
 #include "renderer/light.h"
 #include "renderer/primitive_factory.h"
 
@@ -32,6 +35,24 @@
 
 namespace Phos {
 
+static GraphicsPipeline::Description shadow_map_pipeline_description(std::shared_ptr<Framebuffer> framebuffer) {
+    return GraphicsPipeline::Description{
+        .shader = Renderer::shader_manager()->get_builtin_shader("ShadowMap"),
+        .target_framebuffer = std::move(framebuffer),
+        .depth_write = true,
+    };
+}
+
+static GraphicsPipeline::Description skybox_pipeline_description(std::shared_ptr<Framebuffer> framebuffer) {
+    return GraphicsPipeline::Description{
+        .shader = Renderer::shader_manager()->get_builtin_shader("Skybox"),
+        .target_framebuffer = std::move(framebuffer),
+
+        .front_face = FrontFace::Clockwise,
+        .depth_compare_op = DepthCompareOp::LessEq,
+    };
+}
+
 DeferredRenderer::DeferredRenderer(std::shared_ptr<Scene> scene, SceneRendererConfig config)
       : m_scene(std::move(scene)), m_config(std::move(config)) {
     for (uint32_t i = 0; i < Renderer::config().num_frames; ++i)
@@ -42,6 +63,8 @@ DeferredRenderer::DeferredRenderer(std::shared_ptr<Scene> scene, SceneRendererCo
     [[maybe_unused]] const auto shadow_map_material_baked = m_shadow_map_material->bake();
     PHOS_ASSERT(shadow_map_material_baked, "Failed to bake Shadow Map material");
 
+    m_occlusion_buffer = std::make_unique<OcclusionBuffer>();
+
     m_cube_mesh = PrimitiveFactory::get_cube();
     m_cube_material = Material::create(Renderer::shader_manager()->get_builtin_shader("Skybox"), "SkyboxMaterial");
     [[maybe_unused]] const auto cube_material_baked = m_cube_material->bake();
@@ -58,6 +81,9 @@ DeferredRenderer::~DeferredRenderer() {
 void DeferredRenderer::render(const std::shared_ptr<Camera>& camera) {
     PHOS_PROFILE_ZONE_SCOPED_NAMED("DeferredRenderer::render");
 
+    TransformSystem::update(*m_scene);
+    SpatialIndexSystem::update(*m_scene);
+
     const FrameInformation frame_info = {
         .camera = camera,
         .lights = get_light_info(),
@@ -67,23 +93,25 @@ void DeferredRenderer::render(const std::shared_ptr<Camera>& camera) {
 
     const auto command_buffer = m_command_buffers[Renderer::current_frame()];
 
-    const auto renderable_entities = get_renderable_entities();
+    m_statistics.renderables = static_cast<uint32_t>(m_scene->spatial_index().size());
 
     command_buffer->record([&]() {
+        // Render queue
+        // ============
+        m_render_queue.clear();
+        m_render_queue.set_instancing(m_config.rendering_config.gpu_instancing);
+
+        const auto light_space_matrices = queue_shadow_casters(frame_info.lights);
+        queue_visible_entities(*camera);
+
+        m_render_queue.sort();
+        Renderer::update_instances(m_render_queue.instances());
+
         // ShadowMapping pass
         // ==================
         {
-            std::vector<std::shared_ptr<DirectionalLight>> directional_lights;
-            for (const auto& light : frame_info.lights) {
-                if (light->type() == Light::Type::Directional && light->shadow_type != Light::ShadowType::None)
-                    directional_lights.push_back(std::dynamic_pointer_cast<DirectionalLight>(light));
-
-                if (directional_lights.size() >= MAX_DIRECTIONAL_LIGHTS)
-                    break;
-            }
-
             auto shadow_mapping_info = ShadowMappingInfo{};
-            shadow_mapping_info.number_directional_shadow_maps = static_cast<uint32_t>(directional_lights.size());
+            shadow_mapping_info.number_directional_shadow_maps = static_cast<uint32_t>(light_space_matrices.size());
 
             Renderer::begin_render_pass(command_buffer, m_directional_shadow_map_pass);
 
@@ -93,35 +121,21 @@ void DeferredRenderer::render(const std::shared_ptr<Camera>& camera) {
             viewport.width = static_cast<float>(m_config.rendering_config.shadow_map_resolution);
             viewport.height = static_cast<float>(m_config.rendering_config.shadow_map_resolution);
 
-            for (std::size_t i = 0; i < directional_lights.size(); ++i) {
+            for (std::size_t i = 0; i < light_space_matrices.size(); ++i) {
                 viewport.x = static_cast<float>(i * m_config.rendering_config.shadow_map_resolution);
 
                 m_directional_shadow_map_pipeline->set_viewport(command_buffer, viewport);
 
-                const auto directional_light = directional_lights[i];
-
-                // Prepare light space matrix
-                constexpr float znear = 0.01f, zfar = 40.0f;
-                constexpr float size = 10.0f;
-                const auto light_view = glm::lookAt(directional_light->position,
-                                                    directional_light->position + directional_light->direction,
-                                                    glm::vec3(0.0f, 1.0f, 0.0f));
-                const auto light_projection = glm::ortho(-size, size, size, -size, znear, zfar);
-
-                const auto light_space_matrix = light_projection * light_view;
+                const auto light_space_matrix = light_space_matrices[i];
                 shadow_mapping_info.light_space_matrices[i] = light_space_matrix;
 
-                // Render models
-                for (const auto& entity : renderable_entities) {
-                    const auto constants = ShadowMappingPushConstants{
-                        .light_space_matrix = light_space_matrix,
-                        .model = entity.model,
-                    };
-
-                    m_directional_shadow_map_pipeline->bind_push_constants(command_buffer, "uShadowMapInfo", constants);
+                const auto constants = ShadowMappingPushConstants{
+                    .light_space_matrix = light_space_matrix,
+                };
+                m_directional_shadow_map_pipeline->bind_push_constants(command_buffer, "uShadowMapInfo", constants);
 
-                    Renderer::submit_static_mesh(command_buffer, entity.mesh, m_shadow_map_material);
-                }
+                // Render models
+                m_render_queue.replay(command_buffer, static_cast<uint32_t>(i));
             }
 
             Renderer::end_render_pass(command_buffer, m_directional_shadow_map_pass);
@@ -134,30 +148,18 @@ void DeferredRenderer::render(const std::shared_ptr<Camera>& camera) {
         {
             Renderer::begin_render_pass(command_buffer, m_geometry_pass);
 
-            // Draw models
-            Renderer::bind_graphics_pipeline(command_buffer, m_geometry_pipeline);
-
-            for (const auto& entity : renderable_entities) {
-                auto aabb = entity.mesh->bounding_box();
-                aabb.min = entity.model * glm::vec4(aabb.min, 1.0);
-                aabb.max = entity.model * glm::vec4(aabb.max, 1.0);
-
-                if (!camera->is_inside_frustum(aabb)) {
-                    continue;
-                }
-
-                auto constants = ModelInfoPushConstant{
-                    .model = entity.model,
-                    .color = glm::vec4(1.0f),
-                };
-
-                m_geometry_pipeline->bind_push_constants(command_buffer, "uModelInfo", constants);
-                Renderer::submit_static_mesh(command_buffer, entity.mesh, entity.material);
-            }
+            // Draw models, the geometry pipeline is bound by the first batch
+            m_render_queue.replay(command_buffer, GEOMETRY_PASS);
 
             Renderer::end_render_pass(command_buffer, m_geometry_pass);
         }
 
+        const auto& queue_statistics = m_render_queue.statistics();
+        m_statistics.draw_calls = queue_statistics.draws;
+        m_statistics.instances = queue_statistics.instances;
+        m_statistics.material_binds = queue_statistics.material_binds;
+        m_statistics.mesh_binds = queue_statistics.mesh_binds;
+
         // Lighting pass
         // ==========================
         {
@@ -171,16 +173,6 @@ void DeferredRenderer::render(const std::shared_ptr<Camera>& camera) {
             // Draw skybox
             if (m_skybox_enabled) {
                 Renderer::bind_graphics_pipeline(command_buffer, m_skybox_pipeline);
-
-                glm::mat4 model{1.0f};
-                model = glm::scale(model, glm::vec3(1.0f));
-
-                const auto constants = ModelInfoPushConstant{
-                    .model = model,
-                    .color = glm::vec4{1.0f},
-                };
-                m_skybox_pipeline->bind_push_constants(command_buffer, "uModelInfo", constants);
-
                 Renderer::submit_static_mesh(command_buffer, m_cube_mesh, m_cube_material);
             }
 
@@ -257,7 +249,7 @@ void DeferredRenderer::init(uint32_t width, uint32_t height) {
     // Shadow mapping pass
     {
         m_shadow_mapping_info = UniformBuffer::create<ShadowMappingInfo>();
-        init_shadow_map_pipeline(m_config.rendering_config.shadow_map_resolution);
+        init_shadow_map_framebuffer(m_config.rendering_config.shadow_map_resolution);
     }
 
     const auto depth_image = Image::create({
@@ -357,11 +349,6 @@ void DeferredRenderer::init(uint32_t width, uint32_t height) {
                             depth_attachment},
         });
 
-        m_geometry_pipeline = GraphicsPipeline::create(GraphicsPipeline::Description{
-            .shader = Renderer::shader_manager()->get_builtin_shader("PBR.Geometry.Deferred"),
-            .target_framebuffer = m_geometry_framebuffer,
-        });
-
         m_geometry_pass = RenderPass::create(RenderPass::Description{
             .debug_name = "Deferred-Geometry",
             .target_framebuffer = m_geometry_framebuffer,
@@ -394,31 +381,12 @@ void DeferredRenderer::init(uint32_t width, uint32_t height) {
         };
         m_lighting_framebuffer = Framebuffer::create({.attachments = {lighting_attachment, depth_attachment}});
 
-        m_lighting_pipeline = GraphicsPipeline::create(GraphicsPipeline::Description{
-            .shader = Renderer::shader_manager()->get_builtin_shader("PBR.Lighting.Deferred"),
-            .target_framebuffer = m_lighting_framebuffer,
-
-            .depth_write = false,
-        });
-
-        m_lighting_pipeline->add_input("uPositionMap", m_position_texture);
-        m_lighting_pipeline->add_input("uNormalMap", m_normal_texture);
-        m_lighting_pipeline->add_input("uAlbedoMap", m_albedo_texture);
-        m_lighting_pipeline->add_input("uMetallicRoughnessAOMap", m_metallic_roughness_ao_texture);
-        m_lighting_pipeline->add_input("uEmissionMap", m_emission_texture);
-        m_lighting_pipeline->add_input("uShadowMappingInfo", m_shadow_mapping_info);
-        m_lighting_pipeline->add_input("uDirectionalShadowMaps", m_directional_shadow_map_texture);
-        PHOS_ASSERT(m_lighting_pipeline->bake(), "Failed to bake Lighting Pipeline");
-
         m_lighting_pass = RenderPass::create(RenderPass::Description{
             .debug_name = "Deferred-Lighting",
             .target_framebuffer = m_lighting_framebuffer,
         });
     }
 
-    // Skybox pass
-    init_skybox_pipeline(m_config.environment_config);
-
     // Bloom pass
     {
         m_bloom_downsample_texture = Texture::create(Image::create({
@@ -465,23 +433,74 @@ void DeferredRenderer::init(uint32_t width, uint32_t height) {
             .attachments = {tone_mapping_attachment},
         });
 
-        m_tone_mapping_pipeline = GraphicsPipeline::create({
-            .shader = Renderer::shader_manager()->get_builtin_shader("ToneMapping"),
+        m_tone_mapping_pass = RenderPass::create({
+            .debug_name = "ToneMappingPass",
             .target_framebuffer = m_tone_mapping_framebuffer,
         });
+    }
+
+    // Graphics pipelines, every pipeline of the renderer is known at this point so they are created together
+    {
+        constexpr std::size_t SHADOW_MAP_PIPELINE_IDX = 0;
+        constexpr std::size_t GEOMETRY_PIPELINE_IDX = 1;
+        constexpr std::size_t LIGHTING_PIPELINE_IDX = 2;
+        constexpr std::size_t TONE_MAPPING_PIPELINE_IDX = 3;
+        constexpr std::size_t SKYBOX_PIPELINE_IDX = 4;
+
+        std::vector<GraphicsPipeline::Description> descriptions = {
+            shadow_map_pipeline_description(m_directional_shadow_map_framebuffer),
+            GraphicsPipeline::Description{
+                .shader = Renderer::shader_manager()->get_builtin_shader("PBR.Geometry.Deferred"),
+                .target_framebuffer = m_geometry_framebuffer,
+            },
+            GraphicsPipeline::Description{
+                .shader = Renderer::shader_manager()->get_builtin_shader("PBR.Lighting.Deferred"),
+                .target_framebuffer = m_lighting_framebuffer,
+
+                .depth_write = false,
+            },
+            GraphicsPipeline::Description{
+                .shader = Renderer::shader_manager()->get_builtin_shader("ToneMapping"),
+                .target_framebuffer = m_tone_mapping_framebuffer,
+            },
+        };
+
+        if (m_config.environment_config.skybox != nullptr)
+            descriptions.push_back(skybox_pipeline_description(m_lighting_framebuffer));
+
+        const auto pipelines = GraphicsPipeline::create_batch(descriptions);
+
+        m_directional_shadow_map_pipeline = pipelines[SHADOW_MAP_PIPELINE_IDX];
+        m_geometry_pipeline = pipelines[GEOMETRY_PIPELINE_IDX];
+
+        m_lighting_pipeline = pipelines[LIGHTING_PIPELINE_IDX];
+        m_lighting_pipeline->add_input("uPositionMap", m_position_texture);
+        m_lighting_pipeline->add_input("uNormalMap", m_normal_texture);
+        m_lighting_pipeline->add_input("uAlbedoMap", m_albedo_texture);
+        m_lighting_pipeline->add_input("uMetallicRoughnessAOMap", m_metallic_roughness_ao_texture);
+        m_lighting_pipeline->add_input("uEmissionMap", m_emission_texture);
+        m_lighting_pipeline->add_input("uShadowMappingInfo", m_shadow_mapping_info);
+        m_lighting_pipeline->add_input("uDirectionalShadowMaps", m_directional_shadow_map_texture);
+        PHOS_ASSERT(m_lighting_pipeline->bake(), "Failed to bake Lighting Pipeline");
 
+        m_tone_mapping_pipeline = pipelines[TONE_MAPPING_PIPELINE_IDX];
         m_tone_mapping_pipeline->add_input("uResultTexture", m_lighting_texture);
         m_tone_mapping_pipeline->add_input("uBloomTexture", m_bloom_upsample_texture);
         PHOS_ASSERT(m_tone_mapping_pipeline->bake(), "Could not bake ToneMapping pipeline");
 
-        m_tone_mapping_pass = RenderPass::create({
-            .debug_name = "ToneMappingPass",
-            .target_framebuffer = m_tone_mapping_framebuffer,
-        });
+        // Skybox pass
+        init_skybox_pipeline(m_config.environment_config,
+                             pipelines.size() > SKYBOX_PIPELINE_IDX ? pipelines[SKYBOX_PIPELINE_IDX] : nullptr);
     }
 }
 
 void DeferredRenderer::init_shadow_map_pipeline(uint32_t shadow_map_resolution) {
+    init_shadow_map_framebuffer(shadow_map_resolution);
+    m_directional_shadow_map_pipeline =
+        GraphicsPipeline::create(shadow_map_pipeline_description(m_directional_shadow_map_framebuffer));
+}
+
+void DeferredRenderer::init_shadow_map_framebuffer(uint32_t shadow_map_resolution) {
     // Texture laid out horizontally, all shadow maps saved next to each other
     m_directional_shadow_map_texture = Texture::create(Image::create({
         .width = shadow_map_resolution * MAX_DIRECTIONAL_LIGHTS,
@@ -505,12 +524,6 @@ void DeferredRenderer::init_shadow_map_pipeline(uint32_t shadow_map_resolution)
         .attachments = {directional_shadow_map_attachment},
     });
 
-    m_directional_shadow_map_pipeline = GraphicsPipeline::create({
-        .shader = Renderer::shader_manager()->get_builtin_shader("ShadowMap"),
-        .target_framebuffer = m_directional_shadow_map_framebuffer,
-        .depth_write = true,
-    });
-
     m_directional_shadow_map_pass = RenderPass::create({
         .debug_name = "Shadow Mapping pass",
         .target_framebuffer = m_directional_shadow_map_framebuffer,
@@ -601,7 +614,8 @@ void DeferredRenderer::init_bloom_pipeline(const BloomConfig& config) {
     }
 }
 
-void DeferredRenderer::init_skybox_pipeline(const EnvironmentConfig& config) {
+void DeferredRenderer::init_skybox_pipeline(const EnvironmentConfig& config,
+                                            std::shared_ptr<GraphicsPipeline> pipeline) {
     if (config.skybox == nullptr) {
         m_skybox_enabled = false;
         m_skybox_pipeline.reset();
@@ -610,39 +624,29 @@ void DeferredRenderer::init_skybox_pipeline(const EnvironmentConfig& config) {
 
     m_skybox_enabled = true;
 
-    m_skybox_pipeline = GraphicsPipeline::create(GraphicsPipeline::Description{
-        .shader = Renderer::shader_manager()->get_builtin_shader("Skybox"),
-        .target_framebuffer = m_lighting_framebuffer,
+    // Unless it was already created with the rest of the pipelines in init
+    if (pipeline == nullptr)
+        pipeline = GraphicsPipeline::create(skybox_pipeline_description(m_lighting_framebuffer));
 
-        .front_face = FrontFace::Clockwise,
-        .depth_compare_op = DepthCompareOp::LessEq,
-    });
+    m_skybox_pipeline = std::move(pipeline);
 
     m_skybox_pipeline->add_input("uSkybox", config.skybox);
     PHOS_ASSERT(m_skybox_pipeline->bake(), "Failed to bake Cubemap Pipeline");
 }
 
 std::vector<std::shared_ptr<Light>> DeferredRenderer::get_light_info() const {
-    const auto light_entities = m_scene->get_entities_with<LightComponent>();
-
     std::vector<std::shared_ptr<Light>> lights;
-    for (const auto& entity : light_entities) {
-        const auto transform = entity.get_component<TransformComponent>();
-        const auto light_component = entity.get_component<LightComponent>();
-
+    for (const auto& [_, light_component, transform] : m_scene->view<LightComponent, WorldTransformComponent>()) {
         if (light_component.type == Light::Type::Point) {
             auto light =
-                std::make_shared<PointLight>(transform.position, light_component.color, light_component.intensity);
+                std::make_shared<PointLight>(transform.position(), light_component.color, light_component.intensity);
             lights.push_back(light);
         } else if (light_component.type == Light::Type::Directional) {
-            auto direction = glm::vec3(0.0f, 0.0f, 1.0f); // Z+
-            direction = glm::rotate(direction, transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-            direction = glm::rotate(direction, transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-            direction = glm::rotate(direction, transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
-            direction = glm::normalize(direction);
+            // Z+ rotated by the world transform
+            const auto direction = glm::normalize(glm::vec3(transform.world * glm::vec4(0.0f, 0.0f, 1.0f, 0.0f)));
 
             auto light = std::make_shared<DirectionalLight>(
-                transform.position, direction, light_component.color, light_component.intensity);
+                transform.position(), direction, light_component.color, light_component.intensity);
             light->shadow_type = light_component.shadow_type;
 
             lights.push_back(light);
@@ -652,46 +656,194 @@ std::vector<std::shared_ptr<Light>> DeferredRenderer::get_light_info() const {
     return lights;
 }
 
-std::vector<DeferredRenderer::RenderableEntity> DeferredRenderer::get_renderable_entities() const {
-    const auto apply_transform = [](const TransformComponent& transform, glm::mat4& model) {
-        const auto quat_rotation = glm::quat(transform.rotation);
+std::vector<glm::mat4> DeferredRenderer::queue_shadow_casters(const std::vector<std::shared_ptr<Light>>& lights) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("DeferredRenderer::queue_shadow_casters");
 
-        model = glm::translate(model, transform.position);
-        model = model * glm::mat4_cast(quat_rotation);
-        model = glm::scale(model, transform.scale);
-    };
+    std::vector<std::shared_ptr<DirectionalLight>> directional_lights;
+    for (const auto& light : lights) {
+        if (light->type() == Light::Type::Directional && light->shadow_type != Light::ShadowType::None)
+            directional_lights.push_back(std::dynamic_pointer_cast<DirectionalLight>(light));
+
+        if (directional_lights.size() >= MAX_DIRECTIONAL_LIGHTS)
+            break;
+    }
+
+    std::vector<glm::mat4> light_space_matrices;
+    m_statistics.shadow_casters.assign(directional_lights.size(), 0);
+
+    for (std::size_t i = 0; i < directional_lights.size(); ++i) {
+        const auto& directional_light = directional_lights[i];
+
+        // Prepare light space matrix
+        constexpr float znear = 0.01f, zfar = 40.0f;
+        constexpr float size = 10.0f;
+        const auto light_view = glm::lookAt(directional_light->position,
+                                            directional_light->position + directional_light->direction,
+                                            glm::vec3(0.0f, 1.0f, 0.0f));
+        const auto light_projection = glm::ortho(-size, size, size, -size, znear, zfar);
+
+        const auto light_space_matrix = light_projection * light_view;
+        light_space_matrices.push_back(light_space_matrix);
+
+        // Casters between the light and the near plane still shadow the receivers inside of the light volume.
+        // ShadowMap.vert clamps their depth to the near plane, so the culling volume is extended to the light.
+        const auto light_frustum = Frustum::from_view_projection(light_space_matrix).extended_to_viewer();
+        const auto shadow_casters = get_renderable_entities(light_frustum);
+        m_statistics.shadow_casters[i] = static_cast<uint32_t>(shadow_casters.size());
+
+        // Every caster uses the same material, so packets are grouped by mesh
+        for (const auto& entity : shadow_casters) {
+            for (const auto sub_mesh_idx : entity.sub_meshes) {
+                const auto& sub_mesh = entity.mesh->sub_meshes()[sub_mesh_idx];
+
+                const auto packet = RenderPacket{
+                    .model = entity.model,
+                    .sub_mesh = sub_mesh,
+                    .material = m_shadow_map_material,
+                    .pipeline = nullptr,
+                };
+                m_render_queue.push(static_cast<uint32_t>(i),
+                                    packet,
+                                    distance_to(directional_light->position, sub_mesh->bounding_box(), entity.model));
+            }
+        }
+    }
+
+    return light_space_matrices;
+}
+
+void DeferredRenderer::queue_visible_entities(const Camera& camera) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("DeferredRenderer::queue_visible_entities");
+
+    auto visible_entities = get_renderable_entities(camera.frustum());
+
+    m_statistics.occluded_sub_meshes = 0;
+    m_statistics.occluder_triangles = 0;
+    if (m_config.rendering_config.occlusion_culling)
+        cull_occluded(visible_entities, camera);
+
+    m_statistics.visible_renderables = static_cast<uint32_t>(visible_entities.size());
+    m_statistics.visible_sub_meshes = 0;
+
+    const auto camera_position = camera.position();
+
+    for (const auto& entity : visible_entities) {
+        m_statistics.visible_sub_meshes += static_cast<uint32_t>(entity.sub_meshes.size());
+
+        for (const auto sub_mesh_idx : entity.sub_meshes) {
+            const auto& sub_mesh = entity.mesh->sub_meshes()[sub_mesh_idx];
+
+            const auto packet = RenderPacket{
+                .model = entity.model,
+                .sub_mesh = sub_mesh,
+                .material = entity.material,
+                .pipeline = m_geometry_pipeline,
+            };
+            m_render_queue.push(
+                GEOMETRY_PASS, packet, distance_to(camera_position, sub_mesh->bounding_box(), entity.model));
+        }
+    }
+}
+
+float DeferredRenderer::distance_to(const glm::vec3& position, const AABB& bounds, const glm::mat4& model) {
+    const auto center = glm::vec3(model * glm::vec4((bounds.min + bounds.max) * 0.5f, 1.0f));
+    return glm::length(center - position);
+}
+
+std::vector<DeferredRenderer::RenderableEntity> DeferredRenderer::get_renderable_entities(
+    const Frustum& frustum) const {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("DeferredRenderer::get_renderable_entities");
+
+    std::vector<EntityHandle> handles;
+    m_scene->spatial_index().query(frustum, handles);
 
     std::vector<RenderableEntity> entities;
-    for (const auto& entity : m_scene->get_entities_with<MeshRendererComponent>()) {
-        const auto& [mesh, material] = entity.get_component<MeshRendererComponent>();
+    entities.reserve(handles.size());
+
+    // The sub meshes of every entity are culled in a single batch, starting at first_bounds[entity_idx]. Meshes with
+    // a single sub mesh already passed the test of the entity, so they are not added.
+    BoundsArrays sub_mesh_bounds;
+    std::vector<std::size_t> first_bounds;
+    first_bounds.reserve(handles.size());
+
+    for (const auto handle : handles) {
+        const auto entity = m_scene->get_entity(handle);
+
+        const auto& [mesh, material, occluder] = entity.get_component<MeshRendererComponent>();
         if (mesh == nullptr || material == nullptr)
             continue;
 
-        // Resolve transform in a parent-first manner
-        auto transforms = std::stack<TransformComponent>();
+        const auto& model = entity.get_component<WorldTransformComponent>().world;
+        entities.push_back(RenderableEntity{.model = model, .mesh = mesh, .material = material, .occluder = occluder});
 
-        auto current_entity_uuid = std::optional<UUID>(entity.get_component<UUIDComponent>().uuid);
-        while (current_entity_uuid) {
-            const auto& current_entity = m_scene->get_entity_with_uuid(*current_entity_uuid);
+        first_bounds.push_back(sub_mesh_bounds.size());
+        if (mesh->sub_meshes().size() > 1) {
+            for (const auto& sub_mesh : mesh->sub_meshes())
+                sub_mesh_bounds.push_back(sub_mesh->bounding_box(), model);
+        }
+    }
 
-            const auto& transform = current_entity.get_component<TransformComponent>();
-            transforms.push(transform);
+    VisibilityMask visibility;
+    FrustumCulling::cull(frustum, sub_mesh_bounds, visibility);
 
-            current_entity_uuid = current_entity.get_component<RelationshipComponent>().parent;
-        }
+    for (std::size_t entity_idx = 0; entity_idx < entities.size(); ++entity_idx) {
+        auto& entity = entities[entity_idx];
 
-        // Apply transforms
-        glm::mat4 model{1.0f};
-        while (!transforms.empty()) {
-            const auto& transform = transforms.top();
-            apply_transform(transform, model);
-            transforms.pop();
+        const auto num_sub_meshes = static_cast<uint32_t>(entity.mesh->sub_meshes().size());
+        if (num_sub_meshes == 1) {
+            entity.sub_meshes.push_back(0);
+            continue;
         }
 
-        entities.emplace_back(model, mesh, material);
+        for (uint32_t sub_mesh_idx = 0; sub_mesh_idx < num_sub_meshes; ++sub_mesh_idx) {
+            if (FrustumCulling::is_visible(visibility, first_bounds[entity_idx] + sub_mesh_idx))
+                entity.sub_meshes.push_back(sub_mesh_idx);
+        }
     }
 
+    // The bounds of the mesh can intersect the frustum while none of its parts do
+    std::erase_if(entities, [](const RenderableEntity& entity) { return entity.sub_meshes.empty(); });
+
     return entities;
 }
 
+void DeferredRenderer::cull_occluded(std::vector<RenderableEntity>& entities, const Camera& camera) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("DeferredRenderer::cull_occluded");
+
+    m_occlusion_buffer->begin(camera.projection_matrix() * camera.view_matrix());
+
+    for (const auto& entity : entities) {
+        if (!entity.occluder)
+            continue;
+
+        const auto& geometry = entity.mesh->occluder_geometry();
+        if (geometry.empty())
+            continue;
+
+        for (const auto sub_mesh_idx : entity.sub_meshes) {
+            const auto& [positions, indices] = geometry[sub_mesh_idx];
+            m_occlusion_buffer->add_occluder(positions, indices, entity.model);
+        }
+    }
+
+    // Nothing can be hidden without occluders
+    if (m_occlusion_buffer->statistics().occluder_triangles == 0)
+        return;
+
+    m_occlusion_buffer->rasterize();
+
+    for (auto& entity : entities) {
+        // Occluders are tested too, as they can be hidden by other occluders
+        std::erase_if(entity.sub_meshes, [&](uint32_t sub_mesh_idx) {
+            const auto& sub_mesh = entity.mesh->sub_meshes()[sub_mesh_idx];
+            return !m_occlusion_buffer->is_visible(FrustumCulling::transform(sub_mesh->bounding_box(), entity.model));
+        });
+    }
+
+    std::erase_if(entities, [](const RenderableEntity& entity) { return entity.sub_meshes.empty(); });
+
+    m_statistics.occluded_sub_meshes = m_occlusion_buffer->statistics().occluded;
+    m_statistics.occluder_triangles = m_occlusion_buffer->statistics().occluder_triangles;
+}
+
 } // namespace Phos
@@ -5,6 +5,7 @@
 #include <array>
 #include <glm/glm.hpp>
 
+#include "renderer/render_queue.h"
 #include "renderer/backend/renderer.h"
 #include "scene/scene_renderer.h"
 
@@ -26,11 +27,9 @@ class Light;
 class Cubemap;
 class Event;
 class Entity;
-
-struct ModelInfoPushConstant {
-    glm::mat4 model;
-    glm::vec4 color;
-};
+class OcclusionBuffer;
+struct Frustum;
+struct AABB;
 
 class DeferredRenderer : public ISceneRenderer {
   public:
@@ -45,12 +44,23 @@ class DeferredRenderer : public ISceneRenderer {
 
     void window_resized(uint32_t width, uint32_t height) override;
 
+    [[nodiscard]] const RendererStatistics& statistics() const override { return m_statistics; }
+
   private:
     std::shared_ptr<Scene> m_scene;
     SceneRendererConfig m_config;
+    RendererStatistics m_statistics;
 
     std::vector<std::shared_ptr<CommandBuffer>> m_command_buffers;
 
+    // Draws of the shadow mapping and geometry passes. The shadow map of directional light i uses pass i.
+    RenderQueue m_render_queue;
+    static constexpr uint32_t GEOMETRY_PASS = MAX_DIRECTIONAL_LIGHTS;
+    static_assert(GEOMETRY_PASS < RenderQueue::MAX_PASSES);
+
+    // Occlusion culling
+    std::unique_ptr<OcclusionBuffer> m_occlusion_buffer;
+
     // Shadow mapping pass
     std::shared_ptr<Texture> m_directional_shadow_map_texture;
     std::shared_ptr<Framebuffer> m_directional_shadow_map_framebuffer;
@@ -61,7 +71,6 @@ class DeferredRenderer : public ISceneRenderer {
 
     struct ShadowMappingPushConstants {
         glm::mat4 light_space_matrix;
-        glm::mat4 model;
     };
 
     struct ShadowMappingInfo {
@@ -114,8 +123,10 @@ class DeferredRenderer : public ISceneRenderer {
 
     void init(uint32_t width, uint32_t height);
     void init_shadow_map_pipeline(uint32_t shadow_map_resolution);
+    void init_shadow_map_framebuffer(uint32_t shadow_map_resolution);
     void init_bloom_pipeline(const BloomConfig& config);
-    void init_skybox_pipeline(const EnvironmentConfig& config);
+    // Creates the skybox pipeline unless it is given
+    void init_skybox_pipeline(const EnvironmentConfig& config, std::shared_ptr<GraphicsPipeline> pipeline = nullptr);
 
     [[nodiscard]] std::vector<std::shared_ptr<Light>> get_light_info() const;
 
@@ -123,8 +134,25 @@ class DeferredRenderer : public ISceneRenderer {
         glm::mat4 model;
         std::shared_ptr<StaticMesh> mesh;
         std::shared_ptr<Material> material;
+        // Indices of the sub meshes that passed culling
+        std::vector<uint32_t> sub_meshes;
+        bool occluder;
     };
-    [[nodiscard]] std::vector<RenderableEntity> get_renderable_entities() const;
+    /// Entities with a mesh and material whose bounds are not outside of the frustum, found with the spatial index
+    /// of the scene. Their sub meshes are culled individually.
+    [[nodiscard]] std::vector<RenderableEntity> get_renderable_entities(const Frustum& frustum) const;
+
+    /// Rasterizes the occluders among entities and removes the sub meshes hidden behind them
+    void cull_occluded(std::vector<RenderableEntity>& entities, const Camera& camera);
+
+    /// Pushes the shadow casters of every directional light with shadows into the render queue, and returns the light
+    /// space matrix of every shadow map
+    std::vector<glm::mat4> queue_shadow_casters(const std::vector<std::shared_ptr<Light>>& lights);
+    /// Pushes the sub meshes visible from camera into the render queue
+    void queue_visible_entities(const Camera& camera);
+
+    /// Distance from position to the center of bounds transformed by model, used to sort draws front to back
+    [[nodiscard]] static float distance_to(const glm::vec3& position, const AABB& bounds, const glm::mat4& model);
 };
 
 } // namespace Phos
@@ -0,0 +1,180 @@
+#include "frustum_culling.h"
+
+#include <bit>
+#include <numeric>
+
+#include "utility/logging.h"
+#include "utility/profiling.h"
+
+#include "renderer/mesh.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PHOS_FRUSTUM_CULLING_X86
+#endif
+
+namespace Phos {
+
+//
+// Frustum
+//
+
+Frustum Frustum::from_view_projection(const glm::mat4& view_projection) {
+    // Frustum creation from: https://gdbooks.gitbooks.io/legacyopengl/content/Chapter8/frustum.html
+    const auto row = [&](int i) {
+        return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+    };
+
+    const auto row1 = row(0);
+    const auto row2 = row(1);
+    const auto row3 = row(2);
+    const auto row4 = row(3);
+
+    const auto make_plane = [](const glm::vec4& p) {
+        return Plane{.normal = glm::vec3(p.x, p.y, p.z), .distance = p.w};
+    };
+
+#ifdef GLM_FORCE_DEPTH_ZERO_TO_ONE
+    // Clip space depth goes from 0 to w instead of from -w to w
+    const auto near = make_plane(row3);
+#else
+    const auto near = make_plane(row4 + row3);
+#endif
+
+    return Frustum{
+        .top = make_plane(row4 - row2),
+        .bottom = make_plane(row4 + row2),
+        .left = make_plane(row4 + row1),
+        .right = make_plane(row4 - row1),
+        .near = near,
+        .far = make_plane(row4 - row3),
+    };
+}
+
+Frustum Frustum::extended_to_viewer() const {
+    // Testing the far plane twice keeps the culling kernels free of special cases
+    auto frustum = *this;
+    frustum.near = far;
+    return frustum;
+}
+
+//
+// BoundsArrays
+//
+
+void BoundsArrays::clear() {
+    for (int axis = 0; axis < 3; ++axis) {
+        center[axis].clear();
+        extent[axis].clear();
+    }
+}
+
+void BoundsArrays::reserve(std::size_t count) {
+    for (int axis = 0; axis < 3; ++axis) {
+        center[axis].reserve(count);
+        extent[axis].reserve(count);
+    }
+}
+
+void BoundsArrays::push_back(const AABB& aabb) {
+    const auto c = (aabb.min + aabb.max) * 0.5f;
+    const auto e = (aabb.max - aabb.min) * 0.5f;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        center[axis].push_back(c[axis]);
+        extent[axis].push_back(e[axis]);
+    }
+}
+
+void BoundsArrays::push_back(const AABB& aabb, const glm::mat4& model) {
+    push_back(FrustumCulling::transform(aabb, model));
+}
+
+//
+// FrustumCulling
+//
+
+AABB FrustumCulling::transform(const AABB& aabb, const glm::mat4& model) {
+    // Every row of the result takes the smaller (min) and larger (max) product of each matrix element with the
+    // bounds of the corresponding axis
+    auto min = glm::vec3(model[3]);
+    auto max = glm::vec3(model[3]);
+
+    for (int column = 0; column < 3; ++column) {
+        for (int row = 0; row < 3; ++row) {
+            const auto a = model[column][row] * aabb.min[column];
+            const auto b = model[column][row] * aabb.max[column];
+
+            min[row] += glm::min(a, b);
+            max[row] += glm::max(a, b);
+        }
+    }
+
+    return AABB{.min = min, .max = max};
+}
+
+bool FrustumCulling::is_visible(const Frustum& frustum, const AABB& aabb) {
+    const auto center = (aabb.min + aabb.max) * 0.5f;
+    const auto extent = (aabb.max - aabb.min) * 0.5f;
+
+    for (const auto& plane : frustum.planes()) {
+        const auto distance = glm::dot(plane.normal, center) + plane.distance;
+        if (distance < -glm::dot(glm::abs(plane.normal), extent))
+            return false;
+    }
+
+    return true;
+}
+
+void FrustumCulling::cull(const Frustum& frustum, const BoundsArrays& bounds, VisibilityMask& visibility) {
+    cull(CpuFeatures::best_simd_backend(), frustum, bounds, visibility);
+}
+
+void FrustumCulling::cull(SimdBackend backend,
+                          const Frustum& frustum,
+                          const BoundsArrays& bounds,
+                          VisibilityMask& visibility) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("FrustumCulling::cull");
+
+    const auto count = bounds.size();
+    visibility.assign((count + 63) / 64, 0);
+
+    CullFunc func = cull_scalar;
+#ifdef PHOS_FRUSTUM_CULLING_X86
+    if (backend == SimdBackend::AVX2)
+        func = cull_avx2;
+    else if (backend == SimdBackend::SSE4)
+        func = cull_sse4;
+#else
+    PHOS_ASSERT(backend == SimdBackend::Scalar, "Backend not supported on this architecture");
+#endif
+
+    func(frustum.planes(), bounds, visibility.data(), 0, count);
+}
+
+std::size_t FrustumCulling::count_visible(const VisibilityMask& visibility) {
+    return std::accumulate(visibility.begin(), visibility.end(), std::size_t{0}, [](std::size_t sum, uint64_t word) {
+        return sum + static_cast<std::size_t>(std::popcount(word));
+    });
+}
+
+void FrustumCulling::cull_scalar(const std::array<Plane, 6>& planes,
+                                 const BoundsArrays& bounds,
+                                 uint64_t* visibility,
+                                 std::size_t begin,
+                                 std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+        const auto center = glm::vec3(bounds.center[0][i], bounds.center[1][i], bounds.center[2][i]);
+        const auto extent = glm::vec3(bounds.extent[0][i], bounds.extent[1][i], bounds.extent[2][i]);
+
+        bool visible = true;
+        for (const auto& plane : planes) {
+            const auto distance = glm::dot(plane.normal, center) + plane.distance;
+            visible = visible && distance >= -glm::dot(glm::abs(plane.normal), extent);
+        }
+
+        if (visible)
+            visibility[i / 64] |= uint64_t{1} << (i % 64);
+    }
+}
+
+} // namespace Phos
\ No newline at end of file
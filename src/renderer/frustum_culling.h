@@ -0,0 +1,105 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "core/cpu_features.h"
+
+namespace Phos {
+
+// Forward declarations
+struct AABB;
+
+struct Plane {
+    glm::vec3 normal = glm::vec3(0.0f);
+    float distance = 0.0f;
+};
+
+struct Frustum {
+    Plane top;
+    Plane bottom;
+    Plane left;
+    Plane right;
+    Plane near;
+    Plane far;
+
+    /// Extracts the planes of the volume clipped by view_projection. The planes point inwards and are not normalized.
+    [[nodiscard]] static Frustum from_view_projection(const glm::mat4& view_projection);
+
+    /// Copy of the frustum without a near plane, so that it also contains everything between the viewer and the near
+    /// plane. Used to cull shadow casters, whose depth is clamped to the near plane when drawn.
+    [[nodiscard]] Frustum extended_to_viewer() const;
+
+    [[nodiscard]] std::array<Plane, 6> planes() const { return {top, bottom, left, right, near, far}; }
+};
+
+/// World space bounding boxes stored as centers and half extents, one array per axis, as consumed by FrustumCulling
+struct BoundsArrays {
+    std::array<std::vector<float>, 3> center;
+    std::array<std::vector<float>, 3> extent;
+
+    void clear();
+    void reserve(std::size_t count);
+
+    void push_back(const AABB& aabb);
+    /// Adds the bounding box of aabb after being transformed by model
+    void push_back(const AABB& aabb, const glm::mat4& model);
+
+    [[nodiscard]] std::size_t size() const { return center[0].size(); }
+};
+
+/// One bit per bounding box, set when the box is visible
+using VisibilityMask = std::vector<uint64_t>;
+
+/// Tests bounding boxes against the six planes of a frustum, 4 (SSE4.1) or 8 (AVX2) boxes at a time.
+/// A box is culled when it is completely behind any of the planes, so boxes crossing the corners of the frustum are
+/// conservatively kept.
+class FrustumCulling {
+  public:
+    /// Axis aligned box enclosing aabb transformed by model (Arvo, Graphics Gems 1990). Transforming only the corners
+    /// min and max is not enough when model contains a rotation.
+    [[nodiscard]] static AABB transform(const AABB& aabb, const glm::mat4& model);
+
+    [[nodiscard]] static bool is_visible(const Frustum& frustum, const AABB& aabb);
+
+    /// Fills visibility with one bit per box in bounds
+    static void cull(const Frustum& frustum, const BoundsArrays& bounds, VisibilityMask& visibility);
+
+    /// Same as cull, with a specific backend. Used to compare backends, the backend must be supported.
+    static void cull(SimdBackend backend,
+                     const Frustum& frustum,
+                     const BoundsArrays& bounds,
+                     VisibilityMask& visibility);
+
+    [[nodiscard]] static bool is_visible(const VisibilityMask& visibility, std::size_t index) {
+        return (visibility[index / 64] >> (index % 64)) & 1;
+    }
+
+    [[nodiscard]] static std::size_t count_visible(const VisibilityMask& visibility);
+
+  private:
+    // Each backend writes the bits of the boxes in [begin, end), begin being a multiple of 64. The mask words are
+    // cleared beforehand, so the backends only need to set bits.
+    using CullFunc = void (*)(const std::array<Plane, 6>&, const BoundsArrays&, uint64_t*, std::size_t, std::size_t);
+
+    static void cull_scalar(const std::array<Plane, 6>& planes,
+                            const BoundsArrays& bounds,
+                            uint64_t* visibility,
+                            std::size_t begin,
+                            std::size_t end);
+    static void cull_sse4(const std::array<Plane, 6>& planes,
+                          const BoundsArrays& bounds,
+                          uint64_t* visibility,
+                          std::size_t begin,
+                          std::size_t end);
+    static void cull_avx2(const std::array<Plane, 6>& planes,
+                          const BoundsArrays& bounds,
+                          uint64_t* visibility,
+                          std::size_t begin,
+                          std::size_t end);
+};
+
+} // namespace Phos
@@ -0,0 +1,21 @@
+#include "frustum_culling.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include "utility/simd.h"
+#include "renderer/frustum_culling_simd.h"
+
+namespace Phos {
+
+void FrustumCulling::cull_avx2(const std::array<Plane, 6>& planes,
+                               const BoundsArrays& bounds,
+                               uint64_t* visibility,
+                               std::size_t begin,
+                               std::size_t end) {
+    const auto remaining = FrustumCullingSimd::cull<SimdAvx2>(planes, bounds, visibility, begin, end);
+    cull_scalar(planes, bounds, visibility, remaining, end);
+}
+
+} // namespace Phos
+
+#endif
\ No newline at end of file
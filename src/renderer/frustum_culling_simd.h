@@ -0,0 +1,64 @@
+#pragma once
+
+#include "renderer/frustum_culling.h"
+
+// Shared implementation of the SIMD frustum culling kernels, see scene/transform_kernels_simd.h.
+// Only meant to be included by frustum_culling_*.cpp.
+
+namespace Phos::FrustumCullingSimd {
+
+/// Culls the boxes in [begin, end) Simd::WIDTH at a time, and returns the index of the first box that was not processed
+/// because it did not fill a whole batch. begin must be a multiple of 64, so that every batch sets bits of one word.
+template <typename Simd>
+inline std::size_t cull(const std::array<Plane, 6>& planes,
+                        const BoundsArrays& bounds,
+                        uint64_t* visibility,
+                        std::size_t begin,
+                        std::size_t end) {
+    using Float = typename Simd::Float;
+    constexpr auto WIDTH = Simd::WIDTH;
+
+    // n . c + d + |n| . e >= 0 for every plane, broadcast once
+    Float normal[6][3], abs_normal[6][3], distance[6];
+    for (std::size_t p = 0; p < planes.size(); ++p) {
+        for (int axis = 0; axis < 3; ++axis) {
+            normal[p][axis] = Simd::set1(planes[p].normal[axis]);
+            abs_normal[p][axis] = Simd::set1(planes[p].normal[axis] < 0.0f ? -planes[p].normal[axis]
+                                                                            : planes[p].normal[axis]);
+        }
+        distance[p] = Simd::set1(planes[p].distance);
+    }
+
+    const Float zero = Simd::set1(0.0f);
+
+    auto i = begin;
+    for (; i + WIDTH <= end; i += WIDTH) {
+        const Float cx = Simd::load(bounds.center[0].data() + i);
+        const Float cy = Simd::load(bounds.center[1].data() + i);
+        const Float cz = Simd::load(bounds.center[2].data() + i);
+
+        const Float ex = Simd::load(bounds.extent[0].data() + i);
+        const Float ey = Simd::load(bounds.extent[1].data() + i);
+        const Float ez = Simd::load(bounds.extent[2].data() + i);
+
+        // Sign bit set in every lane that is outside of any plane
+        Float outside = zero;
+        for (std::size_t p = 0; p < planes.size(); ++p) {
+            Float d = Simd::fmadd(normal[p][0], cx, distance[p]);
+            d = Simd::fmadd(normal[p][1], cy, d);
+            d = Simd::fmadd(normal[p][2], cz, d);
+            d = Simd::fmadd(abs_normal[p][0], ex, d);
+            d = Simd::fmadd(abs_normal[p][1], ey, d);
+            d = Simd::fmadd(abs_normal[p][2], ez, d);
+
+            outside = Simd::bit_or(outside, Simd::cmp_lt(d, zero));
+        }
+
+        const auto visible = static_cast<uint64_t>(~Simd::movemask(outside) & ((1 << WIDTH) - 1));
+        visibility[i / 64] |= visible << (i % 64);
+    }
+
+    return i;
+}
+
+} // namespace Phos::FrustumCullingSimd
@@ -1,5 +1,7 @@
 #include "mesh.h"
 
+#include "utility/logging.h"
+
 #include "renderer/backend/buffers.h"
 
 namespace Phos {
@@ -27,7 +29,9 @@ SubMesh::SubMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t
 // StaticMesh
 //
 
-StaticMesh::StaticMesh(std::vector<std::shared_ptr<SubMesh>> sub_meshes) : m_sub_meshes(std::move(sub_meshes)) {
+StaticMesh::StaticMesh(std::vector<std::shared_ptr<SubMesh>> sub_meshes,
+                       OccluderGeometryLoader occluder_geometry_loader)
+      : m_sub_meshes(std::move(sub_meshes)), m_occluder_geometry_loader(std::move(occluder_geometry_loader)) {
     m_aabb = AABB{
         .min = glm::vec3(std::numeric_limits<float>::infinity()),
         .max = glm::vec3(-std::numeric_limits<float>::infinity()),
@@ -39,4 +43,21 @@ StaticMesh::StaticMesh(std::vector<std::shared_ptr<SubMesh>> sub_meshes) : m_sub
     }
 }
 
+const std::vector<OccluderGeometry>& StaticMesh::occluder_geometry() const {
+    std::call_once(m_occluder_geometry_flag, [&] {
+        if (!m_occluder_geometry_loader)
+            return;
+
+        m_occluder_geometry = m_occluder_geometry_loader();
+        if (m_occluder_geometry.size() != m_sub_meshes.size()) {
+            PHOS_LOG_WARNING("Occluder geometry has {} sub meshes instead of {}, the mesh will not occlude",
+                             m_occluder_geometry.size(),
+                             m_sub_meshes.size());
+            m_occluder_geometry.clear();
+        }
+    });
+
+    return m_occluder_geometry;
+}
+
 } // namespace Phos
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <mutex>
 #include <memory>
 #include <vector>
+#include <functional>
 #include <glm/glm.hpp>
 
 #include "asset/asset.h"
@@ -41,9 +43,19 @@ class SubMesh {
     AABB m_aabb{};
 };
 
+/// Geometry of a sub mesh kept on the CPU, used to rasterize occluders
+struct OccluderGeometry {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+};
+
 class StaticMesh : public IAsset {
   public:
-    explicit StaticMesh(std::vector<std::shared_ptr<SubMesh>> sub_meshes);
+    /// Returns the geometry of every sub mesh, in the same order as the sub meshes
+    using OccluderGeometryLoader = std::function<std::vector<OccluderGeometry>()>;
+
+    explicit StaticMesh(std::vector<std::shared_ptr<SubMesh>> sub_meshes,
+                        OccluderGeometryLoader occluder_geometry_loader = {});
     ~StaticMesh() override = default;
 
     [[nodiscard]] AssetType asset_type() override { return AssetType::StaticMesh; }
@@ -51,9 +63,17 @@ class StaticMesh : public IAsset {
     [[nodiscard]] const std::vector<std::shared_ptr<SubMesh>>& sub_meshes() const { return m_sub_meshes; }
     [[nodiscard]] AABB bounding_box() const { return m_aabb; }
 
+    /// Geometry of every sub mesh on the CPU. Loaded the first time the mesh is used as an occluder, so meshes that
+    /// are never occluders do not keep a copy. Empty if the mesh can not provide it.
+    [[nodiscard]] const std::vector<OccluderGeometry>& occluder_geometry() const;
+
   private:
     std::vector<std::shared_ptr<SubMesh>> m_sub_meshes;
     AABB m_aabb{};
+
+    OccluderGeometryLoader m_occluder_geometry_loader;
+    mutable std::once_flag m_occluder_geometry_flag;
+    mutable std::vector<OccluderGeometry> m_occluder_geometry;
 };
 
 } // namespace Phos
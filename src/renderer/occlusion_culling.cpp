@@ -0,0 +1,356 @@
+#include "occlusion_culling.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "utility/logging.h"
+#include "utility/profiling.h"
+
+#include "core/job_system.h"
+#include "renderer/mesh.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PHOS_OCCLUSION_CULLING_X86
+#endif
+
+namespace Phos {
+
+// Vertices closer than this to the plane of the camera can not be projected
+constexpr float MIN_CLIP_W = 1e-5f;
+
+// Tests of boxes covering more texels than this at a level are not refined at the level below
+constexpr uint32_t MAX_REFINE_TEXELS = 8;
+
+OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height) {
+    PHOS_ASSERT(width > 0 && height > 0, "Occlusion buffer can not be empty");
+
+    m_tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_width = m_tiles_x * TILE_SIZE;
+    m_height = m_tiles_y * TILE_SIZE;
+
+    m_depth.assign(static_cast<std::size_t>(m_width) * m_height, 1.0f);
+    m_tile_triangles.resize(static_cast<std::size_t>(m_tiles_x) * m_tiles_y);
+
+    auto level_width = m_width, level_height = m_height;
+    while (level_width > 1 || level_height > 1) {
+        level_width = std::max(1u, (level_width + 1) / 2);
+        level_height = std::max(1u, (level_height + 1) / 2);
+
+        const auto size = static_cast<std::size_t>(level_width) * level_height;
+        m_levels.push_back(Level{
+            .width = level_width,
+            .height = level_height,
+            .min = std::vector<float>(size, 1.0f),
+            .max = std::vector<float>(size, 1.0f),
+        });
+    }
+}
+
+void OcclusionBuffer::begin(const glm::mat4& view_projection) {
+    m_view_projection = view_projection;
+    m_statistics = {};
+
+    m_triangles.clear();
+    for (auto& tile : m_tile_triangles)
+        tile.clear();
+}
+
+void OcclusionBuffer::add_occluder(std::span<const glm::vec3> positions,
+                                   std::span<const uint32_t> indices,
+                                   const glm::mat4& model) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("OcclusionBuffer::add_occluder");
+
+    const auto model_view_projection = m_view_projection * model;
+
+    // Screen space position and depth of every vertex, w is negative for vertices that can not be projected
+    std::vector<glm::vec4> screen(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        const auto clip = model_view_projection * glm::vec4(positions[i], 1.0f);
+        if (clip.w < MIN_CLIP_W) {
+            screen[i].w = -1.0f;
+            continue;
+        }
+
+        const auto inverse_w = 1.0f / clip.w;
+        screen[i] = glm::vec4((clip.x * inverse_w * 0.5f + 0.5f) * static_cast<float>(m_width),
+                              (clip.y * inverse_w * 0.5f + 0.5f) * static_cast<float>(m_height),
+                              clip.z * inverse_w,
+                              1.0f);
+    }
+
+    const auto max_x = static_cast<float>(m_width - 1);
+    const auto max_y = static_cast<float>(m_height - 1);
+
+    ++m_statistics.occluders;
+
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const auto& v0 = screen[indices[i]];
+        const auto& v1 = screen[indices[i + 1]];
+        const auto& v2 = screen[indices[i + 2]];
+
+        // Clipping is not worth it for occluders, dropping the triangle is conservative
+        if (v0.w < 0.0f || v1.w < 0.0f || v2.w < 0.0f)
+            continue;
+        if (v0.z < 0.0f || v1.z < 0.0f || v2.z < 0.0f)
+            continue;
+        if (v0.z > 1.0f && v1.z > 1.0f && v2.z > 1.0f)
+            continue;
+
+        // Pixels whose center can be inside of the triangle
+        const auto min_x = std::floor(std::min({v0.x, v1.x, v2.x}));
+        const auto min_y = std::floor(std::min({v0.y, v1.y, v2.y}));
+        const auto max_xf = std::floor(std::max({v0.x, v1.x, v2.x}));
+        const auto max_yf = std::floor(std::max({v0.y, v1.y, v2.y}));
+        if (max_xf < 0.0f || max_yf < 0.0f || min_x > max_x || min_y > max_y)
+            continue;
+
+        // Edge function of the edge from a to b, it is zero on the edge and positive on the left side of it
+        const auto edge = [](const glm::vec4& a, const glm::vec4& b) {
+            return glm::vec3(a.y - b.y, b.x - a.x, a.x * b.y - b.x * a.y);
+        };
+
+        // Edges opposite to v0, v1 and v2, so that they are the barycentric weights of the vertices
+        auto e0 = edge(v1, v2);
+        auto e1 = edge(v2, v0);
+        auto e2 = edge(v0, v1);
+
+        auto area = e0.x * v0.x + e0.y * v0.y + e0.z;
+        if (std::abs(area) < 1e-6f)
+            continue;
+
+        // Both windings are rasterized, the closest depth wins anyway
+        if (area < 0.0f) {
+            e0 = -e0;
+            e1 = -e1;
+            e2 = -e2;
+            area = -area;
+        }
+
+        const auto inverse_area = 1.0f / area;
+
+        auto triangle = OcclusionTriangle{
+            .edge_a = {e0.x, e1.x, e2.x},
+            .edge_b = {e0.y, e1.y, e2.y},
+            .edge_c = {e0.z, e1.z, e2.z},
+            .depth_a = (e0.x * v0.z + e1.x * v1.z + e2.x * v2.z) * inverse_area,
+            .depth_b = (e0.y * v0.z + e1.y * v1.z + e2.y * v2.z) * inverse_area,
+            .depth_c = (e0.z * v0.z + e1.z * v1.z + e2.z * v2.z) * inverse_area,
+            .min_x = static_cast<int32_t>(std::max(min_x, 0.0f)),
+            .min_y = static_cast<int32_t>(std::max(min_y, 0.0f)),
+            .max_x = static_cast<int32_t>(std::min(max_xf, max_x)),
+            .max_y = static_cast<int32_t>(std::min(max_yf, max_y)),
+        };
+
+        const auto triangle_idx = static_cast<uint32_t>(m_triangles.size());
+        m_triangles.push_back(triangle);
+        ++m_statistics.occluder_triangles;
+
+        // Bin the triangle into every tile overlapped by its bounds
+        const auto first_tile_x = static_cast<uint32_t>(triangle.min_x) / TILE_SIZE;
+        const auto last_tile_x = static_cast<uint32_t>(triangle.max_x) / TILE_SIZE;
+        const auto first_tile_y = static_cast<uint32_t>(triangle.min_y) / TILE_SIZE;
+        const auto last_tile_y = static_cast<uint32_t>(triangle.max_y) / TILE_SIZE;
+
+        for (auto tile_y = first_tile_y; tile_y <= last_tile_y; ++tile_y) {
+            for (auto tile_x = first_tile_x; tile_x <= last_tile_x; ++tile_x)
+                m_tile_triangles[tile_y * m_tiles_x + tile_x].push_back(triangle_idx);
+        }
+    }
+}
+
+void OcclusionBuffer::rasterize() {
+    rasterize(CpuFeatures::best_simd_backend());
+}
+
+void OcclusionBuffer::rasterize(SimdBackend backend) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("OcclusionBuffer::rasterize");
+
+    RasterizeFunc func = rasterize_scalar;
+#ifdef PHOS_OCCLUSION_CULLING_X86
+    if (backend == SimdBackend::AVX2)
+        func = rasterize_avx2;
+    else if (backend == SimdBackend::SSE4)
+        func = rasterize_sse4;
+#else
+    PHOS_ASSERT(backend == SimdBackend::Scalar, "Backend not supported on this architecture");
+#endif
+
+    // Every tile is cleared and rasterized by a single job, so no two jobs write the same pixel
+    JobSystem::parallel_for(m_tile_triangles.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (auto tile_idx = begin; tile_idx < end; ++tile_idx) {
+            const auto x0 = static_cast<uint32_t>(tile_idx % m_tiles_x) * TILE_SIZE;
+            const auto y0 = static_cast<uint32_t>(tile_idx / m_tiles_x) * TILE_SIZE;
+
+            for (auto y = y0; y < y0 + TILE_SIZE; ++y) {
+                auto* row = m_depth.data() + static_cast<std::size_t>(y) * m_width + x0;
+                std::fill(row, row + TILE_SIZE, 1.0f);
+            }
+
+            func(m_triangles.data(), m_tile_triangles[tile_idx], m_depth.data(), m_width, x0, y0, x0 + TILE_SIZE,
+                 y0 + TILE_SIZE);
+        }
+    });
+
+    build_hierarchy();
+}
+
+void OcclusionBuffer::build_hierarchy() {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("OcclusionBuffer::build_hierarchy");
+
+    for (uint32_t level_idx = 0; level_idx < m_levels.size(); ++level_idx) {
+        const auto source_level = level_idx;
+        const auto source_width = level_width(source_level);
+        const auto source_height = level_height(source_level);
+
+        auto& level = m_levels[level_idx];
+        for (uint32_t y = 0; y < level.height; ++y) {
+            for (uint32_t x = 0; x < level.width; ++x) {
+                // Odd sizes repeat the last row or column of the level above
+                const auto x0 = std::min(2 * x, source_width - 1), x1 = std::min(2 * x + 1, source_width - 1);
+                const auto y0 = std::min(2 * y, source_height - 1), y1 = std::min(2 * y + 1, source_height - 1);
+
+                const auto index = y * level.width + x;
+                level.min[index] = std::min({min_depth(source_level, x0, y0),
+                                             min_depth(source_level, x1, y0),
+                                             min_depth(source_level, x0, y1),
+                                             min_depth(source_level, x1, y1)});
+                level.max[index] = std::max({max_depth(source_level, x0, y0),
+                                             max_depth(source_level, x1, y0),
+                                             max_depth(source_level, x0, y1),
+                                             max_depth(source_level, x1, y1)});
+            }
+        }
+    }
+}
+
+float OcclusionBuffer::min_depth(uint32_t level, uint32_t x, uint32_t y) const {
+    if (level == 0)
+        return depth(x, y);
+
+    const auto& hierarchy_level = m_levels[level - 1];
+    return hierarchy_level.min[y * hierarchy_level.width + x];
+}
+
+float OcclusionBuffer::max_depth(uint32_t level, uint32_t x, uint32_t y) const {
+    if (level == 0)
+        return depth(x, y);
+
+    const auto& hierarchy_level = m_levels[level - 1];
+    return hierarchy_level.max[y * hierarchy_level.width + x];
+}
+
+bool OcclusionBuffer::is_visible(const AABB& world_bounds) {
+    ++m_statistics.tested;
+
+    auto min_screen = glm::vec2(std::numeric_limits<float>::max());
+    auto max_screen = glm::vec2(std::numeric_limits<float>::lowest());
+    auto closest_depth = std::numeric_limits<float>::max();
+
+    for (int corner = 0; corner < 8; ++corner) {
+        const auto position = glm::vec3((corner & 1) ? world_bounds.max.x : world_bounds.min.x,
+                                        (corner & 2) ? world_bounds.max.y : world_bounds.min.y,
+                                        (corner & 4) ? world_bounds.max.z : world_bounds.min.z);
+
+        const auto clip = m_view_projection * glm::vec4(position, 1.0f);
+        if (clip.w < MIN_CLIP_W)
+            return true;
+
+        const auto inverse_w = 1.0f / clip.w;
+        const auto screen = glm::vec2((clip.x * inverse_w * 0.5f + 0.5f) * static_cast<float>(m_width),
+                                      (clip.y * inverse_w * 0.5f + 0.5f) * static_cast<float>(m_height));
+
+        min_screen = glm::min(min_screen, screen);
+        max_screen = glm::max(max_screen, screen);
+        closest_depth = std::min(closest_depth, clip.z * inverse_w);
+    }
+
+    if (closest_depth < 0.0f)
+        return true;
+
+    // Pixels touched by the box, clamped to the buffer
+    const auto min_x = std::max(std::floor(min_screen.x), 0.0f);
+    const auto min_y = std::max(std::floor(min_screen.y), 0.0f);
+    const auto max_x = std::min(std::floor(max_screen.x), static_cast<float>(m_width - 1));
+    const auto max_y = std::min(std::floor(max_screen.y), static_cast<float>(m_height - 1));
+    if (min_x > max_x || min_y > max_y)
+        return true;
+
+    const auto x0 = static_cast<uint32_t>(min_x), y0 = static_cast<uint32_t>(min_y);
+    const auto x1 = static_cast<uint32_t>(max_x), y1 = static_cast<uint32_t>(max_y);
+
+    // Start at the finest level where the box covers at most 2x2 texels
+    auto level = 0u;
+    while (level + 1 < number_levels() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+        ++level;
+
+    while (true) {
+        auto region_min = std::numeric_limits<float>::max();
+        auto region_max = std::numeric_limits<float>::lowest();
+
+        for (auto y = y0 >> level; y <= (y1 >> level); ++y) {
+            for (auto x = x0 >> level; x <= (x1 >> level); ++x) {
+                region_min = std::min(region_min, min_depth(level, x, y));
+                region_max = std::max(region_max, max_depth(level, x, y));
+            }
+        }
+
+        // Every texel has an occluder in front of the box
+        if (closest_depth > region_max) {
+            ++m_statistics.occluded;
+            return false;
+        }
+
+        // The box is in front of everything in the region, the levels below can not prove otherwise
+        if (closest_depth <= region_min || level == 0)
+            return true;
+
+        // Refine at the level below while the number of texels to read stays small
+        --level;
+        if ((x1 >> level) - (x0 >> level) >= MAX_REFINE_TEXELS || (y1 >> level) - (y0 >> level) >= MAX_REFINE_TEXELS)
+            return true;
+    }
+}
+
+void OcclusionBuffer::rasterize_scalar(const OcclusionTriangle* triangles,
+                                       std::span<const uint32_t> tile_triangles,
+                                       float* depth,
+                                       uint32_t stride,
+                                       uint32_t x0,
+                                       uint32_t y0,
+                                       uint32_t x1,
+                                       uint32_t y1) {
+    for (const auto triangle_idx : tile_triangles) {
+        const auto& triangle = triangles[triangle_idx];
+
+        const auto begin_x = std::max(triangle.min_x, static_cast<int32_t>(x0));
+        const auto end_x = std::min(triangle.max_x + 1, static_cast<int32_t>(x1));
+        const auto begin_y = std::max(triangle.min_y, static_cast<int32_t>(y0));
+        const auto end_y = std::min(triangle.max_y + 1, static_cast<int32_t>(y1));
+
+        for (auto y = begin_y; y < end_y; ++y) {
+            const auto center_y = static_cast<float>(y) + 0.5f;
+            float* row_depth = depth + static_cast<std::size_t>(y) * stride;
+
+            for (auto x = begin_x; x < end_x; ++x) {
+                const auto center_x = static_cast<float>(x) + 0.5f;
+
+                bool inside = true;
+                for (int edge = 0; edge < 3; ++edge) {
+                    const auto value =
+                        triangle.edge_a[edge] * center_x + (triangle.edge_b[edge] * center_y + triangle.edge_c[edge]);
+                    inside = inside && value >= 0.0f;
+                }
+
+                if (inside) {
+                    const auto z =
+                        triangle.depth_a * center_x + (triangle.depth_b * center_y + triangle.depth_c);
+                    row_depth[x] = std::min(row_depth[x], z);
+                }
+            }
+        }
+    }
+}
+
+} // namespace Phos
\ No newline at end of file
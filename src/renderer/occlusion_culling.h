@@ -0,0 +1,152 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "core/cpu_features.h"
+
+namespace Phos {
+
+// Forward declarations
+struct AABB;
+
+/// Occluder triangle in screen space, prepared by OcclusionBuffer::add_occluder. The edge functions are positive
+/// inside of the triangle, and evaluated at pixel centers.
+struct OcclusionTriangle {
+    float edge_a[3];
+    float edge_b[3];
+    float edge_c[3];
+    // depth = depth_a * x + depth_b * y + depth_c
+    float depth_a;
+    float depth_b;
+    float depth_c;
+    // Inclusive bounds in pixels, clamped to the buffer
+    int32_t min_x;
+    int32_t min_y;
+    int32_t max_x;
+    int32_t max_y;
+};
+
+/// Counters of the frame since the last OcclusionBuffer::begin
+struct OcclusionStatistics {
+    uint32_t occluders = 0;
+    uint32_t occluder_triangles = 0;
+    uint32_t tested = 0;
+    uint32_t occluded = 0;
+};
+
+/// Low resolution depth buffer rasterized on the CPU from a small set of occluders, used to reject the renderables
+/// hidden behind them before they are submitted. Triangles are binned into tiles that are rasterized in parallel with
+/// the JobSystem, 4 (SSE4.1) or 8 (AVX2) pixels at a time. A hierarchy of the minimum and maximum depth of every 2x2
+/// block is then built, so that boxes can be tested with a few reads whatever their size on screen.
+/// Depth goes from 0 (near) to 1 (far), as with GLM_FORCE_DEPTH_ZERO_TO_ONE.
+class OcclusionBuffer {
+  public:
+    static constexpr uint32_t DEFAULT_WIDTH = 256;
+    static constexpr uint32_t DEFAULT_HEIGHT = 128;
+    static constexpr uint32_t TILE_SIZE = 32;
+
+    /// Width and height are rounded up to a multiple of TILE_SIZE
+    explicit OcclusionBuffer(uint32_t width = DEFAULT_WIDTH, uint32_t height = DEFAULT_HEIGHT);
+    ~OcclusionBuffer() = default;
+
+    /// Removes the occluders and resets the statistics. view_projection is used until the next call.
+    void begin(const glm::mat4& view_projection);
+
+    /// Adds the triangles of a mesh. Triangles crossing the near plane are skipped, so occluders never hide more than
+    /// they cover.
+    void add_occluder(std::span<const glm::vec3> positions, std::span<const uint32_t> indices, const glm::mat4& model);
+
+    /// Rasterizes the occluders added since begin and builds the depth hierarchy, must be called before is_visible
+    void rasterize();
+    /// Same as rasterize, with a specific backend. Used to compare backends, the backend must be supported.
+    void rasterize(SimdBackend backend);
+
+    /// Returns false if every pixel covered by the box has an occluder closer than the closest point of the box.
+    /// Boxes crossing the near plane or outside of the screen are reported as visible.
+    [[nodiscard]] bool is_visible(const AABB& world_bounds);
+
+    [[nodiscard]] uint32_t width() const { return m_width; }
+    [[nodiscard]] uint32_t height() const { return m_height; }
+    [[nodiscard]] float depth(uint32_t x, uint32_t y) const { return m_depth[y * m_width + x]; }
+
+    /// Level 0 is the depth buffer, every level halves the size of the previous one down to a single texel
+    [[nodiscard]] uint32_t number_levels() const { return static_cast<uint32_t>(m_levels.size()) + 1; }
+    [[nodiscard]] float min_depth(uint32_t level, uint32_t x, uint32_t y) const;
+    [[nodiscard]] float max_depth(uint32_t level, uint32_t x, uint32_t y) const;
+
+    [[nodiscard]] const OcclusionStatistics& statistics() const { return m_statistics; }
+
+  private:
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_tiles_x;
+    uint32_t m_tiles_y;
+
+    glm::mat4 m_view_projection{1.0f};
+
+    std::vector<float> m_depth;
+
+    struct Level {
+        uint32_t width;
+        uint32_t height;
+        std::vector<float> min;
+        std::vector<float> max;
+    };
+    // Levels 1 and above
+    std::vector<Level> m_levels;
+
+    std::vector<OcclusionTriangle> m_triangles;
+    // Indices of the triangles overlapping every tile
+    std::vector<std::vector<uint32_t>> m_tile_triangles;
+
+    OcclusionStatistics m_statistics;
+
+    void build_hierarchy();
+
+    [[nodiscard]] uint32_t level_width(uint32_t level) const {
+        return level == 0 ? m_width : m_levels[level - 1].width;
+    }
+    [[nodiscard]] uint32_t level_height(uint32_t level) const {
+        return level == 0 ? m_height : m_levels[level - 1].height;
+    }
+
+    // Rasterizes the triangles into the tile [x0, x1) x [y0, y1), x0 and x1 being multiples of TILE_SIZE
+    using RasterizeFunc = void (*)(const OcclusionTriangle*,
+                                   std::span<const uint32_t>,
+                                   float*,
+                                   uint32_t,
+                                   uint32_t,
+                                   uint32_t,
+                                   uint32_t,
+                                   uint32_t);
+
+    static void rasterize_scalar(const OcclusionTriangle* triangles,
+                                 std::span<const uint32_t> tile_triangles,
+                                 float* depth,
+                                 uint32_t stride,
+                                 uint32_t x0,
+                                 uint32_t y0,
+                                 uint32_t x1,
+                                 uint32_t y1);
+    static void rasterize_sse4(const OcclusionTriangle* triangles,
+                               std::span<const uint32_t> tile_triangles,
+                               float* depth,
+                               uint32_t stride,
+                               uint32_t x0,
+                               uint32_t y0,
+                               uint32_t x1,
+                               uint32_t y1);
+    static void rasterize_avx2(const OcclusionTriangle* triangles,
+                               std::span<const uint32_t> tile_triangles,
+                               float* depth,
+                               uint32_t stride,
+                               uint32_t x0,
+                               uint32_t y0,
+                               uint32_t x1,
+                               uint32_t y1);
+};
+
+} // namespace Phos
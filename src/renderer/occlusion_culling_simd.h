@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+
+#include "renderer/occlusion_culling.h"
+
+// Shared implementation of the SIMD occlusion rasterizer, compiled once per instruction set by
+// occlusion_culling_*.cpp, which provide a Simd type with the operations used below.
+
+namespace Phos::OcclusionCullingSimd {
+
+/// Rasterizes the triangles into the tile [x0, x1) x [y0, y1), keeping the closest depth of every pixel.
+/// The tile width must be a multiple of Simd::WIDTH.
+template <typename Simd>
+inline void rasterize(const OcclusionTriangle* triangles,
+                      std::span<const uint32_t> tile_triangles,
+                      float* depth,
+                      uint32_t stride,
+                      uint32_t x0,
+                      uint32_t y0,
+                      uint32_t x1,
+                      uint32_t y1) {
+    using Float = typename Simd::Float;
+    constexpr auto WIDTH = static_cast<int32_t>(Simd::WIDTH);
+
+    // Pixel centers of the lanes, relative to the first pixel of the batch
+    constexpr float LANE_OFFSETS[8] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+    const Float lane_offsets = Simd::load(LANE_OFFSETS);
+    const Float zero = Simd::set1(0.0f);
+
+    const auto tile_x0 = static_cast<int32_t>(x0);
+
+    for (const auto triangle_idx : tile_triangles) {
+        const auto& triangle = triangles[triangle_idx];
+
+        // Batches start at a multiple of WIDTH from the tile, so they never cross its right edge
+        const auto begin_x = tile_x0 + (std::max(triangle.min_x, tile_x0) - tile_x0) / WIDTH * WIDTH;
+        const auto end_x = std::min(triangle.max_x + 1, static_cast<int32_t>(x1));
+        const auto begin_y = std::max(triangle.min_y, static_cast<int32_t>(y0));
+        const auto end_y = std::min(triangle.max_y + 1, static_cast<int32_t>(y1));
+
+        Float edge_a[3];
+        for (int edge = 0; edge < 3; ++edge)
+            edge_a[edge] = Simd::set1(triangle.edge_a[edge]);
+        const Float depth_a = Simd::set1(triangle.depth_a);
+
+        for (auto y = begin_y; y < end_y; ++y) {
+            const auto center_y = static_cast<float>(y) + 0.5f;
+
+            // Terms of the edge and depth functions that only depend on the row
+            Float edge_row[3];
+            for (int edge = 0; edge < 3; ++edge)
+                edge_row[edge] = Simd::set1(triangle.edge_b[edge] * center_y + triangle.edge_c[edge]);
+            const Float depth_row = Simd::set1(triangle.depth_b * center_y + triangle.depth_c);
+
+            float* row_depth = depth + static_cast<std::size_t>(y) * stride;
+
+            for (auto x = begin_x; x < end_x; x += WIDTH) {
+                // Evaluated from the pixel position instead of stepped, so that long rows do not accumulate errors
+                const Float center_x = Simd::add(Simd::set1(static_cast<float>(x)), lane_offsets);
+
+                Float inside = Simd::cmp_ge(Simd::fmadd(edge_a[0], center_x, edge_row[0]), zero);
+                inside = Simd::bit_and(inside, Simd::cmp_ge(Simd::fmadd(edge_a[1], center_x, edge_row[1]), zero));
+                inside = Simd::bit_and(inside, Simd::cmp_ge(Simd::fmadd(edge_a[2], center_x, edge_row[2]), zero));
+
+                if (Simd::movemask(inside) == 0)
+                    continue;
+
+                const Float z = Simd::fmadd(depth_a, center_x, depth_row);
+                const Float current = Simd::load(row_depth + x);
+                Simd::store(row_depth + x, Simd::blend(current, Simd::min(current, z), inside));
+            }
+        }
+    }
+}
+
+} // namespace Phos::OcclusionCullingSimd
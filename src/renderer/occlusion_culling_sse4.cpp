@@ -0,0 +1,23 @@
+#include "occlusion_culling.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include "utility/simd.h"
+#include "renderer/occlusion_culling_simd.h"
+
+namespace Phos {
+
+void OcclusionBuffer::rasterize_sse4(const OcclusionTriangle* triangles,
+                                     std::span<const uint32_t> tile_triangles,
+                                     float* depth,
+                                     uint32_t stride,
+                                     uint32_t x0,
+                                     uint32_t y0,
+                                     uint32_t x1,
+                                     uint32_t y1) {
+    OcclusionCullingSimd::rasterize<SimdSse4>(triangles, tile_triangles, depth, stride, x0, y0, x1, y1);
+}
+
+} // namespace Phos
+
+#endif
\ No newline at end of file
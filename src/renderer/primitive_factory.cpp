@@ -70,7 +70,14 @@ std::shared_ptr<StaticMesh> PrimitiveFactory::get_cube() {
         // clang-format on
 
         const auto sub_mesh = std::make_shared<SubMesh>(vertices, indices);
-        m_cube = std::make_shared<StaticMesh>(std::vector<std::shared_ptr<SubMesh>>{sub_mesh});
+
+        // The cube is small enough to keep its occluder geometry around
+        OccluderGeometry geometry{.indices = indices};
+        for (const auto& vertex : vertices)
+            geometry.positions.push_back(vertex.position);
+
+        m_cube = std::make_shared<StaticMesh>(std::vector<std::shared_ptr<SubMesh>>{sub_mesh},
+                                              [geometry] { return std::vector{geometry}; });
     }
 
     return m_cube;
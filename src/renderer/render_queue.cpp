@@ -0,0 +1,141 @@
+#include "render_queue.h"
+
+#include <array>
+#include <bit>
+
+#include "utility/profiling.h"
+
+#include "renderer/backend/renderer.h"
+
+namespace Phos {
+
+void RenderQueue::clear() {
+    m_packets.clear();
+    m_entries.clear();
+    m_instances.clear();
+
+    m_pipeline_ids.clear();
+    m_material_ids.clear();
+    m_mesh_ids.clear();
+
+    m_sorted = true;
+    m_statistics = {};
+}
+
+void RenderQueue::push(uint32_t pass, RenderPacket packet, float depth) {
+    PHOS_ASSERT(pass < MAX_PASSES, "Pass {} does not fit in the sort key", pass);
+
+    const auto pipeline = get_id(m_pipeline_ids, packet.pipeline.get());
+    const auto material = get_id(m_material_ids, packet.material.get());
+    const auto mesh = get_id(m_mesh_ids, packet.sub_mesh.get());
+
+    m_entries.push_back(SortEntry{
+        .key = make_sort_key(pass, pipeline, material, mesh, depth),
+        .packet_idx = static_cast<uint32_t>(m_packets.size()),
+    });
+    m_packets.push_back(std::move(packet));
+
+    m_sorted = false;
+}
+
+void RenderQueue::sort() {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("RenderQueue::sort");
+
+    radix_sort(m_entries, m_scratch);
+
+    m_instances.clear();
+    m_instances.reserve(m_entries.size());
+    for (const auto& entry : m_entries) {
+        const auto& packet = m_packets[entry.packet_idx];
+        m_instances.push_back(InstanceData{.model = packet.model, .color = packet.color});
+    }
+
+    m_sorted = true;
+}
+
+void RenderQueue::replay(const std::shared_ptr<CommandBuffer>& command_buffer, uint32_t pass) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("RenderQueue::replay");
+
+    for_each(pass, [&](const RenderBatch& batch, StateChanges changes) {
+        const auto& packet = *batch.packet;
+
+        if (changes.pipeline) {
+            Renderer::bind_graphics_pipeline(command_buffer, packet.pipeline);
+            ++m_statistics.pipeline_binds;
+        }
+
+        if (changes.material) {
+            Renderer::bind_material(command_buffer, packet.material);
+            ++m_statistics.material_binds;
+        }
+
+        if (changes.mesh) {
+            Renderer::bind_sub_mesh(command_buffer, packet.sub_mesh);
+            ++m_statistics.mesh_binds;
+        }
+
+        Renderer::draw_sub_mesh(command_buffer, packet.sub_mesh, batch.first_instance, batch.instance_count);
+        ++m_statistics.draws;
+        m_statistics.instances += batch.instance_count;
+    });
+}
+
+uint64_t RenderQueue::make_sort_key(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+    constexpr auto mask = [](uint32_t bits) { return (uint64_t{1} << bits) - 1; };
+
+    // The bits of positive floats are ordered like their values, so the most significant ones can be used directly
+    const auto depth_bits = std::bit_cast<uint32_t>(std::max(depth, 0.0f)) >> (31 - DEPTH_BITS);
+
+    uint64_t key = pass & mask(PASS_BITS);
+    key = (key << PIPELINE_BITS) | (pipeline & mask(PIPELINE_BITS));
+    key = (key << MATERIAL_BITS) | (material & mask(MATERIAL_BITS));
+    key = (key << MESH_BITS) | (mesh & mask(MESH_BITS));
+    key = (key << DEPTH_BITS) | (depth_bits & mask(DEPTH_BITS));
+
+    return key;
+}
+
+void RenderQueue::radix_sort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch) {
+    constexpr uint32_t DIGIT_BITS = 8;
+    constexpr uint32_t NUM_DIGITS = 64 / DIGIT_BITS;
+    constexpr uint32_t NUM_BUCKETS = 1u << DIGIT_BITS;
+
+    if (entries.empty())
+        return;
+
+    // Histograms of every digit, computed in a single pass over the keys
+    std::array<std::array<uint32_t, NUM_BUCKETS>, NUM_DIGITS> histograms{};
+    for (const auto& entry : entries) {
+        for (uint32_t digit = 0; digit < NUM_DIGITS; ++digit)
+            ++histograms[digit][(entry.key >> (digit * DIGIT_BITS)) & (NUM_BUCKETS - 1)];
+    }
+
+    scratch.resize(entries.size());
+
+    for (uint32_t digit = 0; digit < NUM_DIGITS; ++digit) {
+        auto& histogram = histograms[digit];
+
+        // Every key has the same digit, the order would not change
+        if (histogram[(entries[0].key >> (digit * DIGIT_BITS)) & (NUM_BUCKETS - 1)] == entries.size())
+            continue;
+
+        uint32_t offset = 0;
+        for (auto& count : histogram) {
+            const auto bucket_count = count;
+            count = offset;
+            offset += bucket_count;
+        }
+
+        for (const auto& entry : entries)
+            scratch[histogram[(entry.key >> (digit * DIGIT_BITS)) & (NUM_BUCKETS - 1)]++] = entry;
+
+        entries.swap(scratch);
+    }
+}
+
+uint32_t RenderQueue::get_id(std::unordered_map<const void*, uint32_t>& ids, const void* ptr) {
+    const auto [it, _] = ids.try_emplace(ptr, static_cast<uint32_t>(ids.size()));
+    return it->second;
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "utility/logging.h"
+#include "renderer/backend/renderer.h"
+
+namespace Phos {
+
+// Forward declarations
+class CommandBuffer;
+class GraphicsPipeline;
+class Material;
+class SubMesh;
+
+/// Single instance of a sub mesh recorded in a RenderQueue
+struct RenderPacket {
+    glm::mat4 model{1.0f};
+    glm::vec4 color{1.0f};
+    std::shared_ptr<SubMesh> sub_mesh;
+    std::shared_ptr<Material> material;
+    // nullptr keeps the pipeline bound when the pass is replayed
+    std::shared_ptr<GraphicsPipeline> pipeline;
+};
+
+/// Number of draws and state changes recorded by RenderQueue::replay
+struct RenderQueueStatistics {
+    uint32_t draws = 0;
+    uint32_t instances = 0;
+    uint32_t pipeline_binds = 0;
+    uint32_t material_binds = 0;
+    uint32_t mesh_binds = 0;
+};
+
+/// Draws of a frame, sorted so that draws sharing state are recorded together. Every packet gets a 64 bit key
+/// (from most to least significant: pass, pipeline, material, mesh and depth) that is radix sorted, and the packets
+/// of a pass are then replayed binding only the state that differs from the previous draw. Consecutive packets with
+/// the same state are merged into a single instanced draw, reading their InstanceData with gl_InstanceIndex.
+class RenderQueue {
+  public:
+    static constexpr uint32_t PASS_BITS = 4;
+    static constexpr uint32_t PIPELINE_BITS = 8;
+    static constexpr uint32_t MATERIAL_BITS = 16;
+    static constexpr uint32_t MESH_BITS = 16;
+    static constexpr uint32_t DEPTH_BITS = 20;
+    static_assert(PASS_BITS + PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS == 64);
+
+    static constexpr uint32_t MAX_PASSES = 1u << PASS_BITS;
+
+    struct SortEntry {
+        uint64_t key;
+        uint32_t packet_idx;
+    };
+
+    /// Whether the state of a batch differs from the previous batch of the pass
+    struct StateChanges {
+        bool pipeline;
+        bool material;
+        bool mesh;
+    };
+
+    /// Packets drawn with a single instanced draw, their instances are [first_instance, first_instance + count)
+    struct RenderBatch {
+        const RenderPacket* packet;
+        uint32_t first_instance;
+        uint32_t instance_count;
+    };
+
+    RenderQueue() = default;
+    ~RenderQueue() = default;
+
+    /// Removes every packet, to be called at the start of the frame
+    void clear();
+
+    /// depth is the distance to the viewer, packets with the same state are drawn front to back
+    void push(uint32_t pass, RenderPacket packet, float depth);
+
+    /// Sorts the packets by key and fills the instance data in sort order, must be called after the last push and
+    /// before replaying. The instance data must then be uploaded with Renderer::update_instances.
+    void sort();
+
+    /// Records the batches of pass in sort order
+    void replay(const std::shared_ptr<CommandBuffer>& command_buffer, uint32_t pass);
+
+    /// Calls func(batch, changes) for the batches of pass in sort order
+    template <typename Func>
+    void for_each(uint32_t pass, Func&& func) const;
+
+    /// When disabled, every packet is drawn on its own with a single instance
+    void set_instancing(bool enabled) { m_instancing = enabled; }
+    [[nodiscard]] bool instancing() const { return m_instancing; }
+
+    [[nodiscard]] std::size_t size() const { return m_packets.size(); }
+    [[nodiscard]] const std::vector<InstanceData>& instances() const { return m_instances; }
+    [[nodiscard]] const RenderQueueStatistics& statistics() const { return m_statistics; }
+
+    /// Ids are truncated to their number of bits, which only affects how well draws are grouped. Negative depths are
+    /// clamped to 0.
+    [[nodiscard]] static uint64_t make_sort_key(uint32_t pass,
+                                                uint32_t pipeline,
+                                                uint32_t material,
+                                                uint32_t mesh,
+                                                float depth);
+
+    /// Stable least significant digit radix sort on the keys, 8 bits per pass. Passes where every key has the same
+    /// digit are skipped. scratch is used as temporary storage.
+    static void radix_sort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+
+  private:
+    std::vector<RenderPacket> m_packets;
+    std::vector<SortEntry> m_entries;
+    std::vector<SortEntry> m_scratch;
+    std::vector<InstanceData> m_instances;
+
+    // Small ids given to the state of the frame in order of appearance, so that they fit in the key
+    std::unordered_map<const void*, uint32_t> m_pipeline_ids;
+    std::unordered_map<const void*, uint32_t> m_material_ids;
+    std::unordered_map<const void*, uint32_t> m_mesh_ids;
+
+    bool m_sorted = true;
+    bool m_instancing = true;
+    RenderQueueStatistics m_statistics;
+
+    [[nodiscard]] static uint32_t get_id(std::unordered_map<const void*, uint32_t>& ids, const void* ptr);
+
+    [[nodiscard]] static uint32_t key_pass(uint64_t key) { return static_cast<uint32_t>(key >> (64 - PASS_BITS)); }
+};
+
+template <typename Func>
+void RenderQueue::for_each(uint32_t pass, Func&& func) const {
+    PHOS_ASSERT(m_sorted, "RenderQueue must be sorted before replaying a pass");
+
+    const auto same_state = [](const RenderPacket& a, const RenderPacket& b) {
+        return a.pipeline == b.pipeline && a.material == b.material && a.sub_mesh == b.sub_mesh;
+    };
+
+    // Packets of a pass are contiguous once sorted
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), pass, [](const SortEntry& entry, uint32_t value) {
+        return key_pass(entry.key) < value;
+    });
+
+    const RenderPacket* previous = nullptr;
+    while (it != m_entries.end() && key_pass(it->key) == pass) {
+        const auto& packet = m_packets[it->packet_idx];
+
+        // Instances are stored in sort order, so the packets of a batch have consecutive instances
+        auto batch = RenderBatch{
+            .packet = &packet,
+            .first_instance = static_cast<uint32_t>(it - m_entries.begin()),
+            .instance_count = 1,
+        };
+
+        ++it;
+        while (m_instancing && it != m_entries.end() && key_pass(it->key) == pass &&
+               same_state(packet, m_packets[it->packet_idx])) {
+            ++batch.instance_count;
+            ++it;
+        }
+
+        StateChanges changes{};
+        changes.pipeline = packet.pipeline != nullptr && (previous == nullptr || packet.pipeline != previous->pipeline);
+        // Descriptor sets are bound with the layout of the pipeline, so they are bound again with a new pipeline
+        changes.material = changes.pipeline || previous == nullptr || packet.material != previous->material;
+        changes.mesh = previous == nullptr || packet.sub_mesh != previous->sub_mesh;
+
+        func(batch, changes);
+        previous = &packet;
+    }
+}
+
+} // namespace Phos
@@ -0,0 +1,278 @@
+#include "archetype_storage.h"
+
+#include <cstring>
+
+namespace Phos {
+
+static std::size_t align_up(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+//
+// Archetype
+//
+
+Archetype::Archetype(std::vector<const ComponentInfo*> components) : m_components(std::move(components)) {
+    std::size_t row_size = sizeof(EntityHandle);
+    std::size_t max_type_id = 0;
+    for (const auto* info : m_components) {
+        row_size += info->size;
+        max_type_id = std::max(max_type_id, info->type_id);
+    }
+
+    // Compute the layout of the columns for a given capacity, returns the number of bytes needed
+    const auto compute_layout = [&](uint32_t capacity) {
+        std::size_t offset = sizeof(EntityHandle) * capacity;
+        for (const auto* info : m_components) {
+            offset = align_up(offset, info->alignment);
+            m_column_offsets[info->type_id] = offset;
+            offset += info->size * capacity;
+        }
+        return offset;
+    };
+
+    m_column_offsets.resize(max_type_id + 1, INVALID_OFFSET);
+    m_changed_ticks.resize(max_type_id + 1);
+
+    m_chunk_capacity = std::max(static_cast<uint32_t>(ARCHETYPE_CHUNK_SIZE / row_size), 1u);
+    while (m_chunk_capacity > 1 && compute_layout(m_chunk_capacity) > m_chunk_bytes)
+        --m_chunk_capacity;
+
+    // Only happens when a single row does not fit in a chunk
+    m_chunk_bytes = std::max(m_chunk_bytes, align_up(compute_layout(m_chunk_capacity), ARCHETYPE_CHUNK_ALIGNMENT));
+}
+
+Archetype::~Archetype() {
+    for (uint32_t row = 0; row < m_size; ++row) {
+        for (const auto* info : m_components)
+            info->destroy(component(row, info));
+    }
+
+    for (auto* chunk : m_chunks)
+        ::operator delete(chunk, std::align_val_t{ARCHETYPE_CHUNK_ALIGNMENT});
+}
+
+uint32_t Archetype::push_back(EntityHandle handle) {
+    if (m_size == m_chunks.size() * m_chunk_capacity) {
+        auto* memory = ::operator new(m_chunk_bytes, std::align_val_t{ARCHETYPE_CHUNK_ALIGNMENT});
+        m_chunks.push_back(static_cast<std::byte*>(memory));
+    }
+
+    const auto row = m_size++;
+    new (&entity(row)) EntityHandle(handle);
+
+    for (const auto* info : m_components)
+        m_changed_ticks[info->type_id].push_back(0);
+
+    return row;
+}
+
+EntityHandle Archetype::swap_remove(uint32_t row) {
+    const auto last_row = m_size - 1;
+
+    EntityHandle moved_entity{};
+    if (row != last_row) {
+        for (const auto* info : m_components)
+            info->move_construct(component(row, info), component(last_row, info));
+
+        moved_entity = entity(last_row);
+        entity(row) = moved_entity;
+    }
+
+    for (const auto* info : m_components) {
+        auto& ticks = m_changed_ticks[info->type_id];
+        ticks[row] = ticks.back();
+        ticks.pop_back();
+    }
+
+    --m_size;
+
+    // Keep one spare chunk around to avoid allocating again when entities move back and forth
+    if (m_chunks.size() > number_chunks() + 1) {
+        ::operator delete(m_chunks.back(), std::align_val_t{ARCHETYPE_CHUNK_ALIGNMENT});
+        m_chunks.pop_back();
+    }
+
+    return moved_entity;
+}
+
+//
+// ArchetypeStorage
+//
+
+void ArchetypeStorage::entity_destroyed(EntityHandle entity) {
+    if (entity.index() >= m_locations.size())
+        return;
+
+    const auto& location = m_locations[entity.index()];
+    if (location.archetype != nullptr && location.archetype->entity(location.row) == entity)
+        move_entity(entity, nullptr);
+}
+
+std::unique_ptr<ArchetypeStorage> ArchetypeStorage::clone() const {
+    auto copy = std::make_unique<ArchetypeStorage>();
+
+    std::unordered_map<const Archetype*, Archetype*> archetype_map;
+    archetype_map.reserve(m_archetypes.size());
+
+    for (const auto& archetype : m_archetypes) {
+        auto* archetype_copy = copy->get_or_create_archetype(archetype->components());
+        archetype_map[archetype.get()] = archetype_copy;
+
+        for (std::size_t chunk_idx = 0; chunk_idx < archetype->number_chunks(); ++chunk_idx) {
+            const auto rows = archetype->chunk_size(chunk_idx);
+            const auto first_row = static_cast<uint32_t>(chunk_idx) * archetype->chunk_capacity();
+
+            // Allocates the chunk, entity handles are written by push_back
+            for (uint32_t row = 0; row < rows; ++row)
+                (void)archetype_copy->push_back(archetype->entity(first_row + row));
+
+            const auto* src_chunk = archetype->chunk(chunk_idx);
+            auto* dst_chunk = archetype_copy->chunk(chunk_idx);
+
+            for (const auto* info : archetype->components()) {
+                const auto offset = archetype->column_offset(info->type_id);
+
+                if (info->trivially_copyable) {
+                    std::memcpy(dst_chunk + offset, src_chunk + offset, rows * info->size);
+                    continue;
+                }
+
+                PHOS_ASSERT(
+                    info->copy_construct != nullptr, "Component with type id {} can not be copied", info->type_id);
+                for (uint32_t row = 0; row < rows; ++row)
+                    info->copy_construct(dst_chunk + offset + row * info->size, src_chunk + offset + row * info->size);
+            }
+        }
+
+        archetype_copy->m_changed_ticks = archetype->m_changed_ticks;
+    }
+
+    copy->m_locations.reserve(m_locations.size());
+    for (const auto& location : m_locations) {
+        auto* archetype = location.archetype != nullptr ? archetype_map[location.archetype] : nullptr;
+        copy->m_locations.push_back({.archetype = archetype, .row = location.row});
+    }
+
+    return copy;
+}
+
+bool ArchetypeStorage::has_component(EntityHandle entity, std::size_t type_id) const {
+    if (entity.index() >= m_locations.size())
+        return false;
+
+    const auto& [archetype, row] = m_locations[entity.index()];
+    return archetype != nullptr && archetype->contains(type_id) && archetype->entity(row) == entity;
+}
+
+void* ArchetypeStorage::add_component(EntityHandle entity, const ComponentInfo* info) {
+    if (entity.index() >= m_locations.size())
+        m_locations.resize(entity.index() + 1);
+
+    auto* source = m_locations[entity.index()].archetype;
+
+    Archetype* destination;
+    if (source != nullptr && source->m_add_edges.contains(info->type_id)) {
+        destination = source->m_add_edges[info->type_id];
+    } else {
+        auto components = source != nullptr ? source->components() : std::vector<const ComponentInfo*>{};
+        components.push_back(info);
+        std::ranges::sort(components, {}, &ComponentInfo::type_id);
+
+        destination = get_or_create_archetype(std::move(components));
+
+        if (source != nullptr) {
+            source->m_add_edges[info->type_id] = destination;
+            destination->m_remove_edges[info->type_id] = source;
+        }
+    }
+
+    move_entity(entity, destination);
+    return destination->component(m_locations[entity.index()].row, info);
+}
+
+void ArchetypeStorage::remove_component(EntityHandle entity, const ComponentInfo* info) {
+    if (find_component(entity, info) == nullptr) {
+        PHOS_LOG_ERROR("Entity {} does not have component with type id {}", entity.index(), info->type_id);
+        return;
+    }
+
+    auto* source = m_locations[entity.index()].archetype;
+
+    Archetype* destination = nullptr;
+    if (source->m_remove_edges.contains(info->type_id)) {
+        destination = source->m_remove_edges[info->type_id];
+    } else if (source->components().size() > 1) {
+        auto components = source->components();
+        std::erase(components, info);
+
+        destination = get_or_create_archetype(std::move(components));
+
+        source->m_remove_edges[info->type_id] = destination;
+        destination->m_add_edges[info->type_id] = source;
+    }
+
+    move_entity(entity, destination);
+}
+
+void* ArchetypeStorage::find_component(EntityHandle entity, const ComponentInfo* info) const {
+    if (entity.index() >= m_locations.size())
+        return nullptr;
+
+    const auto& [archetype, row] = m_locations[entity.index()];
+    if (archetype == nullptr || !archetype->contains(info->type_id) || archetype->entity(row) != entity)
+        return nullptr;
+
+    return archetype->component(row, info);
+}
+
+uint64_t& ArchetypeStorage::changed_tick(EntityHandle entity, std::size_t type_id) {
+    const auto& [archetype, row] = m_locations[entity.index()];
+    return archetype->m_changed_ticks[type_id][row];
+}
+
+Archetype* ArchetypeStorage::get_or_create_archetype(std::vector<const ComponentInfo*> components) {
+    std::vector<std::size_t> signature;
+    signature.reserve(components.size());
+    for (const auto* info : components)
+        signature.push_back(info->type_id);
+
+    const auto it = m_signature_to_archetype.find(signature);
+    if (it != m_signature_to_archetype.end())
+        return it->second;
+
+    auto* archetype = m_archetypes.emplace_back(std::make_unique<Archetype>(std::move(components))).get();
+    m_signature_to_archetype.insert({std::move(signature), archetype});
+
+    return archetype;
+}
+
+void ArchetypeStorage::move_entity(EntityHandle entity, Archetype* destination) {
+    auto& location = m_locations[entity.index()];
+    auto* source = location.archetype;
+
+    const auto new_row = destination != nullptr ? destination->push_back(entity) : 0;
+
+    if (source != nullptr) {
+        // Move components shared by both archetypes, destroy the ones not present in the destination
+        for (const auto* info : source->components()) {
+            auto* component = source->component(location.row, info);
+
+            if (destination != nullptr && destination->contains(info->type_id)) {
+                info->move_construct(destination->component(new_row, info), component);
+                const auto tick = source->m_changed_ticks[info->type_id][location.row];
+                destination->m_changed_ticks[info->type_id][new_row] = tick;
+            } else {
+                info->destroy(component);
+            }
+        }
+
+        const auto moved_entity = source->swap_remove(location.row);
+        if (moved_entity != EntityHandle{})
+            m_locations[moved_entity.index()].row = location.row;
+    }
+
+    location = {.archetype = destination, .row = new_row};
+}
+
+} // namespace Phos
\ No newline at end of file
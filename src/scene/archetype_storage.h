@@ -0,0 +1,229 @@
+#pragma once
+
+#include <map>
+#include <span>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstddef>
+#include <type_traits>
+#include <algorithm>
+#include <unordered_map>
+
+#include "utility/logging.h"
+#include "scene/scene_constants.h"
+#include "scene/entity_handle.h"
+#include "scene/component_type.h"
+
+namespace Phos {
+
+/// Type erased information needed to move and destroy components stored in archetype chunks
+struct ComponentInfo {
+    std::size_t type_id;
+    std::size_t size;
+    std::size_t alignment;
+
+    bool trivially_copyable;
+
+    void (*move_construct)(void* dst, void* src); // Moves src into uninitialized dst, and destroys src
+    void (*copy_construct)(void* dst, const void* src); // nullptr if the component can not be copied
+    void (*destroy)(void* ptr);
+
+    template <typename T>
+    [[nodiscard]] static const ComponentInfo* get() {
+        static_assert(alignof(T) <= ARCHETYPE_CHUNK_ALIGNMENT, "Component alignment is bigger than chunk alignment");
+
+        static const ComponentInfo info = {
+            .type_id = ComponentType::id<T>(),
+            .size = sizeof(T),
+            .alignment = alignof(T),
+            .trivially_copyable = std::is_trivially_copyable_v<T>,
+            .move_construct =
+                [](void* dst, void* src) {
+                    auto* src_component = static_cast<T*>(src);
+                    new (dst) T(std::move(*src_component));
+                    src_component->~T();
+                },
+            .copy_construct = copy_construct_func<T>(),
+            .destroy = [](void* ptr) { static_cast<T*>(ptr)->~T(); },
+        };
+
+        return &info;
+    }
+
+  private:
+    template <typename T>
+    static constexpr auto copy_construct_func() -> void (*)(void*, const void*) {
+        if constexpr (std::is_copy_constructible_v<T>)
+            return [](void* dst, const void* src) { new (dst) T(*static_cast<const T*>(src)); };
+        else
+            return nullptr;
+    }
+};
+
+/// Set of entities that have exactly the same components. Entities are stored in fixed size chunks, where each
+/// component is laid out as a separate array (SoA), after the array of entity handles.
+class Archetype {
+  public:
+    explicit Archetype(std::vector<const ComponentInfo*> components);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    [[nodiscard]] bool contains(std::size_t type_id) const {
+        return type_id < m_column_offsets.size() && m_column_offsets[type_id] != INVALID_OFFSET;
+    }
+
+    /// Components of the archetype, sorted by type id
+    [[nodiscard]] const std::vector<const ComponentInfo*>& components() const { return m_components; }
+
+    [[nodiscard]] uint32_t size() const { return m_size; }
+    [[nodiscard]] uint32_t chunk_capacity() const { return m_chunk_capacity; }
+
+    [[nodiscard]] std::size_t number_chunks() const {
+        return (m_size + m_chunk_capacity - 1) / m_chunk_capacity;
+    }
+    [[nodiscard]] std::byte* chunk(std::size_t idx) const { return m_chunks[idx]; }
+    [[nodiscard]] uint32_t chunk_size(std::size_t idx) const {
+        return std::min(m_chunk_capacity, m_size - static_cast<uint32_t>(idx) * m_chunk_capacity);
+    }
+
+    /// Byte offset, inside every chunk, of the array of components of the given type
+    [[nodiscard]] std::size_t column_offset(std::size_t type_id) const { return m_column_offsets[type_id]; }
+
+    [[nodiscard]] EntityHandle& entity(uint32_t row) const {
+        return reinterpret_cast<EntityHandle*>(m_chunks[row / m_chunk_capacity])[row % m_chunk_capacity];
+    }
+
+    [[nodiscard]] void* component(uint32_t row, const ComponentInfo* info) const {
+        const auto slot = row % m_chunk_capacity;
+        return m_chunks[row / m_chunk_capacity] + m_column_offsets[info->type_id] + slot * info->size;
+    }
+
+    /// Tick in which each row last added or changed the component of the given type
+    [[nodiscard]] std::span<uint64_t> changed_ticks(std::size_t type_id) { return m_changed_ticks[type_id]; }
+
+    /// Adds a row for the entity, leaving its components uninitialized
+    [[nodiscard]] uint32_t push_back(EntityHandle handle);
+
+    /// Removes a row whose components have already been moved out or destroyed, by moving the last row into it.
+    /// Returns the entity that now occupies the row, or an invalid handle if the removed row was the last one.
+    EntityHandle swap_remove(uint32_t row);
+
+  private:
+    static constexpr std::size_t INVALID_OFFSET = std::numeric_limits<std::size_t>::max();
+
+    std::vector<const ComponentInfo*> m_components;
+    std::vector<std::size_t> m_column_offsets; // Indexed by type id
+    std::vector<std::vector<uint64_t>> m_changed_ticks; // Indexed by type id, then row
+
+    std::size_t m_chunk_bytes = ARCHETYPE_CHUNK_SIZE;
+    uint32_t m_chunk_capacity = 0;
+    std::vector<std::byte*> m_chunks;
+
+    uint32_t m_size = 0;
+
+    // Cached transitions to other archetypes when adding or removing a component type
+    std::unordered_map<std::size_t, Archetype*> m_add_edges;
+    std::unordered_map<std::size_t, Archetype*> m_remove_edges;
+
+    friend class ArchetypeStorage;
+};
+
+/// Component storage that groups entities by their component signature, so that entities with the same
+/// components are iterated linearly chunk by chunk. Adding or removing a component moves the entity to another
+/// archetype, so it is intended for scenes whose component sets are mostly stable.
+class ArchetypeStorage {
+  public:
+    ArchetypeStorage() = default;
+    ~ArchetypeStorage() = default;
+
+    /// Copy with the same archetypes and entity locations. Columns of trivially copyable components are copied with
+    /// memcpy, the rest are copy constructed element by element.
+    [[nodiscard]] std::unique_ptr<ArchetypeStorage> clone() const;
+
+    template <typename T>
+    void add_component(EntityHandle entity, T component, uint64_t tick = 0) {
+        const auto* info = ComponentInfo::get<T>();
+        if (find_component(entity, info) != nullptr) {
+            PHOS_LOG_ERROR("Component added to entity {} more than once", entity.index());
+            return;
+        }
+
+        new (add_component(entity, info)) T(std::move(component));
+        changed_tick(entity, info->type_id) = tick;
+    }
+
+    template <typename T>
+    void remove_component(EntityHandle entity) {
+        remove_component(entity, ComponentInfo::get<T>());
+    }
+
+    template <typename T>
+    [[nodiscard]] T& get_component(EntityHandle entity) const {
+        auto* component = find_component(entity, ComponentInfo::get<T>());
+        PHOS_ASSERT(
+            component != nullptr, "Entity {} does not have the component {}", entity.index(), typeid(T).name());
+
+        return *static_cast<T*>(component);
+    }
+
+    template <typename T>
+    [[nodiscard]] bool has_component(EntityHandle entity) const {
+        return find_component(entity, ComponentInfo::get<T>()) != nullptr;
+    }
+
+    [[nodiscard]] bool has_component(EntityHandle entity, std::size_t type_id) const;
+
+    template <typename T>
+    [[nodiscard]] uint64_t& changed_tick(EntityHandle entity) {
+        PHOS_ASSERT(
+            has_component<T>(entity), "Entity {} does not have the component {}", entity.index(), typeid(T).name());
+        return changed_tick(entity, ComponentType::id<T>());
+    }
+
+    /// Calls func(entity, component) for the components added or changed after the given tick
+    template <typename T, typename Func>
+    void for_each_changed(uint64_t since_tick, Func&& func) {
+        const auto type_id = ComponentType::id<T>();
+
+        for (const auto& archetype : m_archetypes) {
+            if (!archetype->contains(type_id))
+                continue;
+
+            const auto ticks = archetype->changed_ticks(type_id);
+            for (uint32_t row = 0; row < archetype->size(); ++row) {
+                if (ticks[row] <= since_tick)
+                    continue;
+
+                auto* component = archetype->component(row, ComponentInfo::get<T>());
+                func(archetype->entity(row), *static_cast<T*>(component));
+            }
+        }
+    }
+
+    void entity_destroyed(EntityHandle entity);
+
+    [[nodiscard]] const std::vector<std::unique_ptr<Archetype>>& archetypes() const { return m_archetypes; }
+
+  private:
+    struct EntityLocation {
+        Archetype* archetype = nullptr;
+        uint32_t row = 0;
+    };
+    std::vector<EntityLocation> m_locations; // Indexed by EntityHandle::index
+
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;
+    std::map<std::vector<std::size_t>, Archetype*> m_signature_to_archetype;
+
+    [[nodiscard]] void* add_component(EntityHandle entity, const ComponentInfo* info);
+    void remove_component(EntityHandle entity, const ComponentInfo* info);
+    [[nodiscard]] void* find_component(EntityHandle entity, const ComponentInfo* info) const;
+    [[nodiscard]] uint64_t& changed_tick(EntityHandle entity, std::size_t type_id);
+
+    [[nodiscard]] Archetype* get_or_create_archetype(std::vector<const ComponentInfo*> components);
+    void move_entity(EntityHandle entity, Archetype* destination);
+};
+
+} // namespace Phos
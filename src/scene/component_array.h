@@ -1,89 +1,159 @@
 #pragma once
 
 #include <array>
+#include <span>
+#include <vector>
+#include <memory>
+#include <limits>
 
 #include "utility/logging.h"
+#include "scene/scene_constants.h"
+#include "scene/entity_handle.h"
 
 namespace Phos {
 
 class IComponentArray {
   public:
     virtual ~IComponentArray() = default;
-    virtual void entity_destroyed(std::size_t entity_destroyed) = 0;
+    [[nodiscard]] virtual std::unique_ptr<IComponentArray> clone() const = 0;
+    [[nodiscard]] virtual bool entity_has_component(EntityHandle entity) const = 0;
+    virtual void entity_destroyed(EntityHandle entity) = 0;
 };
 
+/// Paged sparse set. The sparse array maps an entity index to the index of its component in the dense arrays, and is
+/// split into fixed size pages allocated on demand. Components and their entities are kept tightly packed, and the
+/// dense entity handles are used to reject handles of destroyed entities that reuse the same index.
+/// Every component also stores the registry tick in which it was last added or changed.
 template <typename T>
-class ComponentArray : public IComponentArray {
+class ComponentArray final : public IComponentArray {
   public:
     ComponentArray() = default;
     ~ComponentArray() override = default;
 
-    void insert_data(std::size_t entity_id, T component) {
-        if (m_entity_to_idx.contains(entity_id)) {
-            PHOS_LOG_ERROR("Component added to entity {} more than once", entity_id);
-            return;
+    /// Copies the dense arrays wholesale (a memcpy for trivially copyable components) and the sparse pages as they are
+    [[nodiscard]] std::unique_ptr<IComponentArray> clone() const override {
+        auto copy = std::make_unique<ComponentArray<T>>();
+
+        copy->m_sparse_pages.resize(m_sparse_pages.size());
+        for (std::size_t i = 0; i < m_sparse_pages.size(); ++i) {
+            if (m_sparse_pages[i] != nullptr)
+                copy->m_sparse_pages[i] = std::make_unique<SparsePage>(*m_sparse_pages[i]);
         }
 
-        const auto new_idx = m_size;
-        m_entity_to_idx[entity_id] = new_idx;
-        m_idx_to_entity[new_idx] = entity_id;
-        m_components[new_idx] = component;
+        copy->m_components = m_components;
+        copy->m_entities = m_entities;
+        copy->m_changed_ticks = m_changed_ticks;
+
+        return copy;
+    }
+
+    void insert_data(EntityHandle entity, T component, uint64_t tick = 0) {
+        if (entity_has_component(entity)) {
+            PHOS_LOG_ERROR("Component added to entity {} more than once", entity.index());
+            return;
+        }
 
-        ++m_size;
+        sparse_index(entity) = static_cast<uint32_t>(m_components.size());
+        m_components.push_back(std::move(component));
+        m_entities.push_back(entity);
+        m_changed_ticks.push_back(tick);
     }
 
-    void remove_data(std::size_t entity_id) {
-        if (!m_entity_to_idx.contains(entity_id)) {
-            PHOS_LOG_ERROR("Entity {} does not have component {}", entity_id, m_name);
+    void remove_data(EntityHandle entity) {
+        if (!entity_has_component(entity)) {
+            PHOS_LOG_ERROR("Entity {} does not have component {}", entity.index(), typeid(T).name());
             return;
         }
 
-        const auto idx_removed = m_entity_to_idx[entity_id];
-        const auto idx_last_element = m_size - 1;
-        m_components[idx_removed] = m_components[idx_last_element];
+        auto& idx_removed = sparse_index(entity);
+        const auto last_element_entity = m_entities.back();
 
-        const auto last_element_entity_id = m_idx_to_entity[idx_last_element];
-        m_entity_to_idx[last_element_entity_id] = idx_removed;
-        m_idx_to_entity[idx_removed] = last_element_entity_id;
+        m_components[idx_removed] = std::move(m_components.back());
+        m_entities[idx_removed] = last_element_entity;
+        m_changed_ticks[idx_removed] = m_changed_ticks.back();
+        sparse_index(last_element_entity) = idx_removed;
 
-        m_entity_to_idx.erase(entity_id);
-        m_idx_to_entity.erase(idx_last_element);
+        idx_removed = INVALID_INDEX;
 
-        --m_size;
+        m_components.pop_back();
+        m_entities.pop_back();
+        m_changed_ticks.pop_back();
     }
 
-    [[nodiscard]] T& get_data(std::size_t entity_id) {
-        const auto it = m_entity_to_idx.find(entity_id);
-        PHOS_ASSERT(it != m_entity_to_idx.end(), "Entity {} does not have the component {}", entity_id, m_name);
+    [[nodiscard]] T& get_data(EntityHandle entity) {
+        PHOS_ASSERT(entity_has_component(entity),
+                    "Entity {} does not have the component {}",
+                    entity.index(),
+                    typeid(T).name());
 
-        return m_components[it->second];
+        return m_components[sparse_index(entity)];
     }
 
-    [[nodiscard]] bool entity_has_component(std::size_t entity_id) const { return m_entity_to_idx.contains(entity_id); }
+    [[nodiscard]] bool entity_has_component(EntityHandle entity) const override {
+        const auto page = entity.index() / COMPONENT_ARRAY_PAGE_SIZE;
+        if (page >= m_sparse_pages.size() || m_sparse_pages[page] == nullptr)
+            return false;
 
-    [[nodiscard]] std::vector<std::size_t> get_entities() const {
-        std::vector<std::size_t> entities;
-        entities.reserve(m_entity_to_idx.size());
+        const auto idx = (*m_sparse_pages[page])[entity.index() % COMPONENT_ARRAY_PAGE_SIZE];
+        return idx != INVALID_INDEX && m_entities[idx] == entity;
+    }
+
+    /// Makes room for the given number of components without reallocating
+    void reserve(std::size_t capacity) {
+        m_components.reserve(capacity);
+        m_entities.reserve(capacity);
+        m_changed_ticks.reserve(capacity);
+    }
 
-        for (const auto& [entity, _] : m_entity_to_idx)
-            entities.push_back(entity);
+    /// Entities with this component, tightly packed in the same order as the component data
+    [[nodiscard]] std::span<const EntityHandle> entities() const { return m_entities; }
+    [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(m_components.size()); }
 
-        return entities;
+    [[nodiscard]] uint64_t& changed_tick(EntityHandle entity) {
+        PHOS_ASSERT(entity_has_component(entity),
+                    "Entity {} does not have the component {}",
+                    entity.index(),
+                    typeid(T).name());
+
+        return m_changed_ticks[sparse_index(entity)];
     }
 
-    void entity_destroyed(std::size_t entity_id) override {
-        if (m_entity_to_idx.contains(entity_id))
-            remove_data(entity_id);
+    /// Calls func(entity, component) for the components added or changed after the given tick
+    template <typename Func>
+    void for_each_changed(uint64_t since_tick, Func&& func) {
+        for (std::size_t i = 0; i < m_changed_ticks.size(); ++i) {
+            if (m_changed_ticks[i] > since_tick)
+                func(m_entities[i], m_components[i]);
+        }
+    }
+
+    void entity_destroyed(EntityHandle entity) override {
+        if (entity_has_component(entity))
+            remove_data(entity);
     }
 
   private:
-    std::array<T, MAX_NUM_ENTITIES> m_components;
-    uint32_t m_size = 0;
+    static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+    using SparsePage = std::array<uint32_t, COMPONENT_ARRAY_PAGE_SIZE>;
+
+    std::vector<std::unique_ptr<SparsePage>> m_sparse_pages;
 
-    std::string m_name = typeid(T).name();
+    std::vector<T> m_components;
+    std::vector<EntityHandle> m_entities;
+    std::vector<uint64_t> m_changed_ticks;
 
-    std::unordered_map<std::size_t, uint32_t> m_entity_to_idx;
-    std::unordered_map<uint32_t, std::size_t> m_idx_to_entity;
+    uint32_t& sparse_index(EntityHandle entity) {
+        const auto page = entity.index() / COMPONENT_ARRAY_PAGE_SIZE;
+        if (page >= m_sparse_pages.size())
+            m_sparse_pages.resize(page + 1);
+
+        if (m_sparse_pages[page] == nullptr) {
+            m_sparse_pages[page] = std::make_unique<SparsePage>();
+            m_sparse_pages[page]->fill(INVALID_INDEX);
+        }
+
+        return (*m_sparse_pages[page])[entity.index() % COMPONENT_ARRAY_PAGE_SIZE];
+    }
 };
 
 } // namespace Phos
@@ -1,73 +1,99 @@
 #pragma once
 
-#include <unordered_map>
+#include <vector>
+#include <memory>
 
 #include "utility/logging.h"
+#include "scene/component_type.h"
 #include "scene/component_array.h"
 
 namespace Phos {
 
 class ComponentManager {
   public:
+    /// Copy of every component array, with the same entities and component data
+    [[nodiscard]] std::unique_ptr<ComponentManager> clone() const {
+        auto copy = std::make_unique<ComponentManager>();
+
+        copy->m_component_arrays.resize(m_component_arrays.size());
+        for (std::size_t i = 0; i < m_component_arrays.size(); ++i) {
+            if (m_component_arrays[i] != nullptr)
+                copy->m_component_arrays[i] = m_component_arrays[i]->clone();
+        }
+
+        return copy;
+    }
+
     template <typename T>
     void register_component() {
-        const std::string type_name = typeid(T).name();
+        const auto type_id = ComponentType::id<T>();
+
+        if (type_id >= m_component_arrays.size())
+            m_component_arrays.resize(type_id + 1);
 
-        if (m_component_arrays.contains(type_name)) {
-            PHOS_LOG_ERROR("Component {} is already registered", type_name);
+        if (m_component_arrays[type_id] != nullptr) {
+            PHOS_LOG_ERROR("Component {} is already registered", typeid(T).name());
             return;
         }
 
-        m_component_arrays.insert({type_name, std::make_shared<ComponentArray<T>>()});
+        m_component_arrays[type_id] = std::make_unique<ComponentArray<T>>();
     }
 
     template <typename T>
-    [[nodiscard]] bool contains_component() {
-        const std::string type_name = typeid(T).name();
-        return m_component_arrays.contains(type_name);
+    [[nodiscard]] bool contains_component() const {
+        const auto type_id = ComponentType::id<T>();
+        return type_id < m_component_arrays.size() && m_component_arrays[type_id] != nullptr;
     }
 
     template <typename T>
-    [[nodiscard]] T& get_component(std::size_t entity_id) const {
-        return get_component_array<T>()->get_data(entity_id);
+    [[nodiscard]] T& get_component(EntityHandle entity) const {
+        return get_component_array<T>()->get_data(entity);
     }
 
     template <typename T>
-    void add_component(std::size_t entity_id, T component) {
-        get_component_array<T>()->insert_data(entity_id, component);
+    void add_component(EntityHandle entity, T component, uint64_t tick = 0) {
+        get_component_array<T>()->insert_data(entity, std::move(component), tick);
     }
 
     template <typename T>
-    void remove_component(std::size_t entity_id) {
-        get_component_array<T>()->remove_data(entity_id);
+    void remove_component(EntityHandle entity) {
+        get_component_array<T>()->remove_data(entity);
     }
 
     template <typename T>
-    [[nodiscard]] bool entity_has_component(std::size_t entity_id) const {
-        return get_component_array<T>()->entity_has_component(entity_id);
+    [[nodiscard]] bool entity_has_component(EntityHandle entity) const {
+        const auto* array = find_component_array<T>();
+        return array != nullptr && array->entity_has_component(entity);
     }
 
     template <typename T>
-    [[nodiscard]] std::vector<std::size_t> get_entities_with_component() const {
-        return get_component_array<T>()->get_entities();
+    [[nodiscard]] ComponentArray<T>* find_component_array() const {
+        if (!contains_component<T>())
+            return nullptr;
+
+        return static_cast<ComponentArray<T>*>(m_component_arrays[ComponentType::id<T>()].get());
+    }
+
+    [[nodiscard]] IComponentArray* find_component_array(std::size_t type_id) const {
+        return type_id < m_component_arrays.size() ? m_component_arrays[type_id].get() : nullptr;
     }
 
-    void entity_destroyed(std::size_t entity_id) {
-        for (const auto& [_, array] : m_component_arrays) {
-            array->entity_destroyed(entity_id);
+    void entity_destroyed(EntityHandle entity) {
+        for (const auto& array : m_component_arrays) {
+            if (array != nullptr)
+                array->entity_destroyed(entity);
         }
     }
 
   private:
-    std::unordered_map<std::string, std::shared_ptr<IComponentArray>> m_component_arrays;
+    // Indexed by ComponentType::id, nullptr for types not registered in this manager
+    std::vector<std::unique_ptr<IComponentArray>> m_component_arrays;
 
     template <typename T>
-    std::shared_ptr<ComponentArray<T>> get_component_array() const {
-        const std::string type_name = typeid(T).name();
-
-        PHOS_ASSERT(m_component_arrays.contains(type_name), "Component {} is not registered", type_name);
-        return std::static_pointer_cast<ComponentArray<T>>(m_component_arrays.find(type_name)->second);
+    [[nodiscard]] ComponentArray<T>* get_component_array() const {
+        PHOS_ASSERT(contains_component<T>(), "Component {} is not registered", typeid(T).name());
+        return static_cast<ComponentArray<T>*>(m_component_arrays[ComponentType::id<T>()].get());
     }
 };
 
-} // namespace Phos
+} // namespace Phos
\ No newline at end of file
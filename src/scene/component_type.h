@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace Phos {
+
+/// Assigns every component type a dense integer id the first time it is requested.
+/// Ids are shared by all registries, and are used to index component storage without hashing type names.
+class ComponentType {
+  public:
+    ComponentType() = delete;
+
+    template <typename T>
+    [[nodiscard]] static std::size_t id() {
+        return id_impl<std::remove_cvref_t<T>>();
+    }
+
+  private:
+    static inline std::atomic<std::size_t> s_next_id = 0;
+
+    template <typename T>
+    [[nodiscard]] static std::size_t id_impl() {
+        static const std::size_t s_id = s_next_id.fetch_add(1, std::memory_order_relaxed);
+        return s_id;
+    }
+};
+
+} // namespace Phos
\ No newline at end of file
@@ -16,15 +16,6 @@ class StaticMesh;
 class Material;
 class ClassInstanceHandle;
 
-struct UUIDComponent {
-    UUID uuid;
-};
-
-struct RelationshipComponent {
-    std::optional<UUID> parent;
-    std::vector<UUID> children;
-};
-
 struct NameComponent {
     std::string name;
 };
@@ -35,6 +26,14 @@ struct TransformComponent {
     glm::vec3 scale{1.0f};
 };
 
+/// Matrices derived from TransformComponent and the hierarchy, kept up to date by TransformSystem
+struct WorldTransformComponent {
+    glm::mat4 local{1.0f};
+    glm::mat4 world{1.0f}; // Parent world * local
+
+    [[nodiscard]] glm::vec3 position() const { return glm::vec3(world[3]); }
+};
+
 struct LightComponent {
     Light::Type type = Light::Type::Point;
 
@@ -47,6 +46,8 @@ struct LightComponent {
 struct MeshRendererComponent {
     std::shared_ptr<StaticMesh> mesh;
     std::shared_ptr<Material> material;
+    // Rasterized into the occlusion buffer to hide what is behind it, meant for large and simple meshes like walls
+    bool occluder = false;
 };
 
 struct CameraComponent {
@@ -0,0 +1,381 @@
+#include "dynamic_aabb_tree.h"
+
+#include <algorithm>
+
+#include "utility/logging.h"
+
+namespace Phos {
+
+static AABB combine(const AABB& a, const AABB& b) {
+    return AABB{.min = glm::min(a.min, b.min), .max = glm::max(a.max, b.max)};
+}
+
+static bool contains(const AABB& outer, const AABB& inner) {
+    for (int axis = 0; axis < 3; ++axis) {
+        if (inner.min[axis] < outer.min[axis] || inner.max[axis] > outer.max[axis])
+            return false;
+    }
+    return true;
+}
+
+// Half of the surface area, the cost of visiting a node is proportional to it
+static float perimeter(const AABB& aabb) {
+    const auto size = aabb.max - aabb.min;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+DynamicAABBTree::DynamicAABBTree(float margin) : m_margin(margin) {}
+
+uint32_t DynamicAABBTree::create_proxy(const AABB& aabb, uint64_t user_data) {
+    const auto proxy = allocate_node();
+
+    auto& node = m_nodes[proxy];
+    node.aabb = AABB{.min = aabb.min - glm::vec3(m_margin), .max = aabb.max + glm::vec3(m_margin)};
+    node.user_data = user_data;
+    node.height = 0;
+
+    insert_leaf(proxy);
+    ++m_proxy_count;
+
+    return proxy;
+}
+
+void DynamicAABBTree::destroy_proxy(uint32_t proxy) {
+    PHOS_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].is_leaf(), "Proxy {} is not a leaf of the tree", proxy);
+
+    remove_leaf(proxy);
+    free_node(proxy);
+    --m_proxy_count;
+}
+
+bool DynamicAABBTree::move_proxy(uint32_t proxy, const AABB& aabb) {
+    PHOS_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].is_leaf(), "Proxy {} is not a leaf of the tree", proxy);
+
+    const auto fat_aabb = AABB{.min = aabb.min - glm::vec3(m_margin), .max = aabb.max + glm::vec3(m_margin)};
+
+    // Also reinsert boxes that shrank a lot, so that the enlarged box does not cause false positives forever
+    const auto& current = m_nodes[proxy].aabb;
+    if (contains(current, aabb) && perimeter(current) <= 4.0f * perimeter(fat_aabb))
+        return false;
+
+    remove_leaf(proxy);
+    m_nodes[proxy].aabb = fat_aabb;
+    insert_leaf(proxy);
+
+    return true;
+}
+
+bool DynamicAABBTree::validate() const {
+    if (m_root == NULL_NODE)
+        return m_proxy_count == 0;
+
+    if (m_nodes[m_root].parent != NULL_NODE)
+        return false;
+
+    std::size_t leaves = 0;
+    std::vector<uint32_t> stack = {m_root};
+
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+
+        const auto& node = m_nodes[index];
+        if (node.is_leaf()) {
+            if (node.height != 0 || node.child2 != NULL_NODE)
+                return false;
+
+            ++leaves;
+            continue;
+        }
+
+        const auto& child1 = m_nodes[node.child1];
+        const auto& child2 = m_nodes[node.child2];
+
+        if (child1.parent != index || child2.parent != index)
+            return false;
+        if (node.height != 1 + std::max(child1.height, child2.height))
+            return false;
+        if (std::abs(child1.height - child2.height) > 1)
+            return false;
+        if (!contains(node.aabb, child1.aabb) || !contains(node.aabb, child2.aabb))
+            return false;
+
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+    }
+
+    return leaves == m_proxy_count;
+}
+
+uint32_t DynamicAABBTree::allocate_node() {
+    if (m_free_list == NULL_NODE) {
+        m_nodes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    const auto node = m_free_list;
+    m_free_list = m_nodes[node].parent;
+    m_nodes[node] = Node{};
+
+    return node;
+}
+
+void DynamicAABBTree::free_node(uint32_t node) {
+    m_nodes[node] = Node{};
+    m_nodes[node].parent = m_free_list;
+    m_free_list = node;
+}
+
+void DynamicAABBTree::insert_leaf(uint32_t leaf) {
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Find the best sibling, descending into the child whose box grows the least
+    const auto leaf_aabb = m_nodes[leaf].aabb;
+
+    auto index = m_root;
+    while (!m_nodes[index].is_leaf()) {
+        const auto& node = m_nodes[index];
+
+        const auto area = perimeter(node.aabb);
+        const auto combined_area = perimeter(combine(node.aabb, leaf_aabb));
+
+        // Cost of creating a new parent for this node and the new leaf
+        const auto cost = 2.0f * combined_area;
+        // Minimum cost of pushing the leaf further down the tree
+        const auto inheritance_cost = 2.0f * (combined_area - area);
+
+        const auto descend_cost = [&](uint32_t child) {
+            const auto& child_node = m_nodes[child];
+            const auto child_combined = perimeter(combine(leaf_aabb, child_node.aabb));
+            if (child_node.is_leaf())
+                return child_combined + inheritance_cost;
+            return child_combined - perimeter(child_node.aabb) + inheritance_cost;
+        };
+
+        const auto cost1 = descend_cost(node.child1);
+        const auto cost2 = descend_cost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const auto sibling = index;
+
+    // New parent for the sibling and the leaf
+    const auto old_parent = m_nodes[sibling].parent;
+    const auto new_parent = allocate_node();
+
+    m_nodes[new_parent].parent = old_parent;
+    m_nodes[new_parent].aabb = combine(leaf_aabb, m_nodes[sibling].aabb);
+    m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+    m_nodes[new_parent].child1 = sibling;
+    m_nodes[new_parent].child2 = leaf;
+
+    if (old_parent != NULL_NODE) {
+        if (m_nodes[old_parent].child1 == sibling)
+            m_nodes[old_parent].child1 = new_parent;
+        else
+            m_nodes[old_parent].child2 = new_parent;
+    } else {
+        m_root = new_parent;
+    }
+
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    refit_ancestors(new_parent);
+}
+
+void DynamicAABBTree::remove_leaf(uint32_t leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    const auto parent = m_nodes[leaf].parent;
+    const auto grand_parent = m_nodes[parent].parent;
+    const auto sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    // The sibling takes the place of the parent
+    if (grand_parent != NULL_NODE) {
+        if (m_nodes[grand_parent].child1 == parent)
+            m_nodes[grand_parent].child1 = sibling;
+        else
+            m_nodes[grand_parent].child2 = sibling;
+
+        m_nodes[sibling].parent = grand_parent;
+        free_node(parent);
+
+        refit_ancestors(grand_parent);
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        free_node(parent);
+    }
+
+    m_nodes[leaf].parent = NULL_NODE;
+}
+
+void DynamicAABBTree::refit_ancestors(uint32_t node) {
+    auto index = node;
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        auto& current = m_nodes[index];
+        const auto& child1 = m_nodes[current.child1];
+        const auto& child2 = m_nodes[current.child2];
+
+        current.height = 1 + std::max(child1.height, child2.height);
+        current.aabb = combine(child1.aabb, child2.aabb);
+
+        index = current.parent;
+    }
+}
+
+uint32_t DynamicAABBTree::balance(uint32_t a_index) {
+    auto& a = m_nodes[a_index];
+    if (a.is_leaf() || a.height < 2)
+        return a_index;
+
+    const auto b_index = a.child1;
+    const auto c_index = a.child2;
+    auto& b = m_nodes[b_index];
+    auto& c = m_nodes[c_index];
+
+    const auto balance = c.height - b.height;
+
+    // Replaces a with its child in the parent of a
+    const auto promote = [&](uint32_t child_index) {
+        auto& child = m_nodes[child_index];
+
+        child.parent = a.parent;
+        a.parent = child_index;
+
+        if (child.parent == NULL_NODE)
+            m_root = child_index;
+        else if (m_nodes[child.parent].child1 == a_index)
+            m_nodes[child.parent].child1 = child_index;
+        else
+            m_nodes[child.parent].child2 = child_index;
+    };
+
+    // Rotate c up
+    if (balance > 1) {
+        const auto f_index = c.child1;
+        const auto g_index = c.child2;
+        auto& f = m_nodes[f_index];
+        auto& g = m_nodes[g_index];
+
+        c.child1 = a_index;
+        promote(c_index);
+
+        // The taller grandchild stays under c, the other one moves under a
+        if (f.height > g.height) {
+            c.child2 = f_index;
+            a.child2 = g_index;
+            g.parent = a_index;
+
+            a.aabb = combine(b.aabb, g.aabb);
+            c.aabb = combine(a.aabb, f.aabb);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        } else {
+            c.child2 = g_index;
+            a.child2 = f_index;
+            f.parent = a_index;
+
+            a.aabb = combine(b.aabb, f.aabb);
+            c.aabb = combine(a.aabb, g.aabb);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+
+        return c_index;
+    }
+
+    // Rotate b up
+    if (balance < -1) {
+        const auto d_index = b.child1;
+        const auto e_index = b.child2;
+        auto& d = m_nodes[d_index];
+        auto& e = m_nodes[e_index];
+
+        b.child1 = a_index;
+        promote(b_index);
+
+        if (d.height > e.height) {
+            b.child2 = d_index;
+            a.child1 = e_index;
+            e.parent = a_index;
+
+            a.aabb = combine(c.aabb, e.aabb);
+            b.aabb = combine(a.aabb, d.aabb);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        } else {
+            b.child2 = e_index;
+            a.child1 = d_index;
+            d.parent = a_index;
+
+            a.aabb = combine(c.aabb, d.aabb);
+            b.aabb = combine(a.aabb, e.aabb);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+
+        return b_index;
+    }
+
+    return a_index;
+}
+
+bool DynamicAABBTree::overlaps(const AABB& a, const AABB& b) {
+    for (int axis = 0; axis < 3; ++axis) {
+        if (a.min[axis] > b.max[axis] || b.min[axis] > a.max[axis])
+            return false;
+    }
+    return true;
+}
+
+DynamicAABBTree::Containment DynamicAABBTree::classify(const std::array<Plane, 6>& planes, const AABB& aabb) {
+    const auto center = (aabb.min + aabb.max) * 0.5f;
+    const auto extent = (aabb.max - aabb.min) * 0.5f;
+
+    auto containment = Containment::Inside;
+    for (const auto& plane : planes) {
+        const auto distance = glm::dot(plane.normal, center) + plane.distance;
+        const auto radius = glm::dot(glm::abs(plane.normal), extent);
+
+        if (distance < -radius)
+            return Containment::Outside;
+        if (distance < radius)
+            containment = Containment::Intersects;
+    }
+
+    return containment;
+}
+
+float DynamicAABBTree::intersect(const glm::vec3& origin,
+                                 const glm::vec3& inverse_direction,
+                                 const AABB& aabb,
+                                 float max_distance) {
+    // Slab test, starting inside of the box counts as a hit at distance 0
+    const auto t1 = (aabb.min - origin) * inverse_direction;
+    const auto t2 = (aabb.max - origin) * inverse_direction;
+
+    const auto t_min = glm::min(t1, t2);
+    const auto t_max = glm::max(t1, t2);
+
+    const auto enter = std::max(std::max(t_min.x, t_min.y), std::max(t_min.z, 0.0f));
+    const auto exit = std::min(std::min(t_max.x, t_max.y), std::min(t_max.z, max_distance));
+
+    return enter <= exit ? enter : -1.0f;
+}
+
+} // namespace Phos
\ No newline at end of file
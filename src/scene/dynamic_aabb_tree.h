@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "renderer/mesh.h"
+#include "renderer/frustum_culling.h"
+
+namespace Phos {
+
+struct Ray {
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, -1.0f};
+};
+
+/// Bounding volume hierarchy of axis aligned boxes that can be modified incrementally (Box2D's b2DynamicTree).
+/// Leaves store a box enlarged by a margin, so that objects moving a small distance do not need to be reinserted.
+/// Insertion picks the sibling with the smallest increase of surface area, and the tree is kept balanced with rotations
+/// while walking back up to the root, so queries visit O(log n) nodes per result.
+class DynamicAABBTree {
+  public:
+    static constexpr uint32_t NULL_NODE = std::numeric_limits<uint32_t>::max();
+
+    explicit DynamicAABBTree(float margin = 0.1f);
+    ~DynamicAABBTree() = default;
+
+    /// Returns the id of the new leaf, stable until the proxy is destroyed
+    [[nodiscard]] uint32_t create_proxy(const AABB& aabb, uint64_t user_data);
+    void destroy_proxy(uint32_t proxy);
+
+    /// Updates the box of the proxy. Returns true if the proxy had to be reinserted because aabb is no longer inside
+    /// of its enlarged box.
+    bool move_proxy(uint32_t proxy, const AABB& aabb);
+
+    [[nodiscard]] uint64_t user_data(uint32_t proxy) const { return m_nodes[proxy].user_data; }
+    [[nodiscard]] const AABB& fat_aabb(uint32_t proxy) const { return m_nodes[proxy].aabb; }
+
+    [[nodiscard]] std::size_t proxy_count() const { return m_proxy_count; }
+    /// Height of the root, 0 for a tree with a single leaf
+    [[nodiscard]] int32_t height() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+
+    /// Checks the parent links, heights and boxes of every node, meant for tests
+    [[nodiscard]] bool validate() const;
+
+    /// Calls func(proxy) for every proxy whose enlarged box overlaps aabb. Returning false from func stops the query.
+    template <typename Func>
+    void query(const AABB& aabb, Func&& func) const;
+
+    /// Calls func(proxy, fully_inside) for every proxy whose enlarged box is not completely outside of the frustum.
+    /// Subtrees completely inside of the frustum are not tested any further, so fully_inside is true for their leaves.
+    template <typename Func>
+    void query(const Frustum& frustum, Func&& func) const;
+
+    /// Calls func(proxy, max_distance) for every proxy whose enlarged box is hit by the ray closer than max_distance.
+    /// func returns the new max_distance, for example the distance of a hit to only look for closer ones, or a
+    /// negative value to stop the query. ray.direction must be normalized for distances to be in world units.
+    template <typename Func>
+    void raycast(const Ray& ray, float max_distance, Func&& func) const;
+
+    /// Distance along the ray where it enters aabb, 0 if the ray starts inside, or a negative value if it does not hit
+    /// it before max_distance
+    [[nodiscard]] static float intersect(const glm::vec3& origin,
+                                         const glm::vec3& inverse_direction,
+                                         const AABB& aabb,
+                                         float max_distance);
+
+  private:
+    struct Node {
+        AABB aabb{};
+        uint64_t user_data = 0;
+
+        // Next free node when the node is in the free list
+        uint32_t parent = NULL_NODE;
+        uint32_t child1 = NULL_NODE;
+        uint32_t child2 = NULL_NODE;
+
+        // Leaves have height 0, free nodes -1
+        int32_t height = -1;
+
+        [[nodiscard]] bool is_leaf() const { return child1 == NULL_NODE; }
+    };
+
+    std::vector<Node> m_nodes;
+    uint32_t m_root = NULL_NODE;
+    uint32_t m_free_list = NULL_NODE;
+    std::size_t m_proxy_count = 0;
+
+    float m_margin;
+
+    [[nodiscard]] uint32_t allocate_node();
+    void free_node(uint32_t node);
+
+    void insert_leaf(uint32_t leaf);
+    void remove_leaf(uint32_t leaf);
+
+    /// Rotates the subtree rooted at node if it is imbalanced, and returns the new root of the subtree
+    [[nodiscard]] uint32_t balance(uint32_t node);
+    /// Recomputes the boxes and heights from node to the root, balancing every ancestor
+    void refit_ancestors(uint32_t node);
+
+    [[nodiscard]] static bool overlaps(const AABB& a, const AABB& b);
+
+    enum class Containment {
+        Outside,
+        Intersects,
+        Inside,
+    };
+    [[nodiscard]] static Containment classify(const std::array<Plane, 6>& planes, const AABB& aabb);
+};
+
+template <typename Func>
+void DynamicAABBTree::query(const AABB& aabb, Func&& func) const {
+    if (m_root == NULL_NODE)
+        return;
+
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+
+        const auto& node = m_nodes[index];
+        if (!overlaps(node.aabb, aabb))
+            continue;
+
+        if (node.is_leaf()) {
+            if (!func(index))
+                return;
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+template <typename Func>
+void DynamicAABBTree::query(const Frustum& frustum, Func&& func) const {
+    if (m_root == NULL_NODE)
+        return;
+
+    const auto planes = frustum.planes();
+
+    // Second element tells whether the node is known to be inside of the frustum
+    std::vector<std::pair<uint32_t, bool>> stack;
+    stack.reserve(64);
+    stack.emplace_back(m_root, false);
+
+    while (!stack.empty()) {
+        const auto [index, inside] = stack.back();
+        stack.pop_back();
+
+        const auto& node = m_nodes[index];
+
+        auto containment = Containment::Inside;
+        if (!inside) {
+            containment = classify(planes, node.aabb);
+            if (containment == Containment::Outside)
+                continue;
+        }
+
+        if (node.is_leaf()) {
+            func(index, containment == Containment::Inside);
+        } else {
+            stack.emplace_back(node.child1, containment == Containment::Inside);
+            stack.emplace_back(node.child2, containment == Containment::Inside);
+        }
+    }
+}
+
+template <typename Func>
+void DynamicAABBTree::raycast(const Ray& ray, float max_distance, Func&& func) const {
+    if (m_root == NULL_NODE)
+        return;
+
+    const auto inverse_direction = glm::vec3(1.0f) / ray.direction;
+
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+
+        const auto& node = m_nodes[index];
+        if (intersect(ray.origin, inverse_direction, node.aabb, max_distance) < 0.0f)
+            continue;
+
+        if (node.is_leaf()) {
+            max_distance = func(index, max_distance);
+            if (max_distance < 0.0f)
+                return;
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+} // namespace Phos
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <ranges>
+#include <vector>
+#include <optional>
 
 #include "core/uuid.h"
 #include "utility/logging.h"
@@ -14,13 +15,13 @@ namespace Phos {
 class Entity {
   public:
     Entity() = default;
-    Entity(std::size_t id, Scene* scene) : m_id(id), m_scene(scene) {}
+    Entity(EntityHandle id, Scene* scene) : m_id(id), m_scene(scene) {}
     ~Entity() = default;
 
     Entity(const Entity& entity) = default;
     Entity& operator=(const Entity& entity) = default;
 
-    bool operator==(const Entity& entity) const { return uuid() == entity.uuid(); }
+    bool operator==(const Entity& entity) const { return m_id == entity.m_id && m_scene == entity.m_scene; }
     bool operator!=(const Entity& entity) const { return !(*this == entity); }
 
     template <typename T>
@@ -43,51 +44,70 @@ class Entity {
         return m_scene->m_registry->has_component<T>(m_id);
     }
 
-    void set_parent(const Entity& parent) const {
-        auto& relationship = get_component<RelationshipComponent>();
+    /// Modifies the component through func(component&) and marks it as changed
+    template <typename T, typename Func>
+    void patch(Func&& func) const {
+        m_scene->m_registry->patch<T>(m_id, std::forward<Func>(func));
+    }
 
-        if (relationship.parent) {
-            const auto& current_parent = m_scene->get_entity_with_uuid(relationship.parent.value());
-            current_parent.remove_child(*this);
-        }
+    template <typename T>
+    void mark_changed() const {
+        m_scene->m_registry->mark_changed<T>(m_id);
+    }
 
-        relationship.parent = parent.uuid();
-        parent.add_child(*this);
+    /// Moves the entity, together with its descendants, to be the last child of parent
+    void set_parent(const Entity& parent) const {
+        // World transforms depend on the parent
+        if (m_scene->m_hierarchy.set_parent(m_id, parent.m_id))
+            mark_changed<TransformComponent>();
     }
 
     void add_child(const Entity& child) const {
-        auto& relationship = get_component<RelationshipComponent>();
-
-        if (std::ranges::find(relationship.children, child.uuid()) != relationship.children.end()) {
+        if (m_scene->m_hierarchy.parent(child.m_id) == m_id) {
             PHOS_LOG_WARNING("Entity {} already contains child {}",
                              static_cast<uint64_t>(uuid()),
                              static_cast<uint64_t>(child.uuid()));
             return;
         }
 
-        relationship.children.push_back(child.uuid());
-        child.get_component<RelationshipComponent>().parent = uuid();
+        child.set_parent(*this);
     }
 
+    /// Makes the child a root entity
     void remove_child(const Entity& child) const {
-        auto& relationship = get_component<RelationshipComponent>();
-
-        if (std::ranges::find(relationship.children, child.uuid()) == relationship.children.end()) {
+        if (m_scene->m_hierarchy.parent(child.m_id) != m_id) {
             PHOS_LOG_ERROR("Entity {} does not contain child: {}",
                            static_cast<uint64_t>(uuid()),
                            static_cast<uint64_t>(child.uuid()));
             return;
         }
 
-        std::erase(relationship.children, child.uuid());
+        m_scene->m_hierarchy.set_parent(child.m_id);
+        child.mark_changed<TransformComponent>();
+    }
+
+    [[nodiscard]] std::optional<Entity> parent() const {
+        if (!m_scene->m_hierarchy.has_parent(m_id))
+            return {};
+        return Entity(m_scene->m_hierarchy.parent(m_id), m_scene);
     }
 
-    [[nodiscard]] UUID uuid() const { return get_component<UUIDComponent>().uuid; }
-    [[nodiscard]] std::size_t id() const { return m_id; }
+    [[nodiscard]] std::vector<Entity> children() const {
+        std::vector<Entity> children;
+        for (const auto child : m_scene->m_hierarchy.children(m_id))
+            children.emplace_back(child, m_scene);
+
+        return children;
+    }
+
+    [[nodiscard]] bool has_children() const { return m_scene->m_hierarchy.has_children(m_id); }
+
+    [[nodiscard]] UUID uuid() const { return m_scene->m_entity_uuids[m_id.index()]; }
+    [[nodiscard]] EntityHandle id() const { return m_id; }
 
   private:
-    std::size_t m_id;
-    Scene* m_scene;
+    EntityHandle m_id;
+    Scene* m_scene = nullptr;
 };
 
 } // namespace Phos
@@ -0,0 +1,157 @@
+#include "entity_command_buffer.h"
+
+#include <array>
+#include <algorithm>
+
+#include "utility/logging.h"
+#include "utility/profiling.h"
+#include "scene/scene.h"
+#include "scene/entity.h"
+
+namespace Phos {
+
+static std::atomic<uint64_t> s_next_command_buffer_id = 1;
+
+// Buffers of the last command buffers used by this thread, avoids locking on every recorded command. A thread
+// usually records into one or two command buffers, the oldest entry is replaced when none matches.
+struct ThreadBufferCache {
+    struct Entry {
+        uint64_t command_buffer_id = 0;
+        void* buffer = nullptr;
+    };
+
+    std::array<Entry, 4> entries{};
+    std::size_t next_entry_idx = 0;
+};
+static thread_local ThreadBufferCache s_thread_buffer_cache;
+
+EntityCommandBuffer::EntityCommandBuffer(Scene* scene) : m_scene(scene), m_id(s_next_command_buffer_id++) {}
+
+EntityCommandBuffer::~EntityCommandBuffer() = default;
+
+EntityHandle EntityCommandBuffer::create(std::string name, UUID uuid) {
+    const auto entity = m_scene->reserve_entity();
+    thread_buffer().creates.push_back({.entity = entity, .name = std::move(name), .uuid = uuid});
+
+    return entity;
+}
+
+void EntityCommandBuffer::destroy(EntityHandle entity) {
+    thread_buffer().destroys.push_back(entity);
+}
+
+void EntityCommandBuffer::set_parent(EntityHandle child, EntityHandle parent) {
+    thread_buffer().parent_commands.push_back({.child = child, .parent = parent});
+}
+
+std::optional<EntityHandle> EntityCommandBuffer::find_pending_parent(EntityHandle child) {
+    const auto& commands = thread_buffer().parent_commands;
+    for (auto it = commands.rbegin(); it != commands.rend(); ++it) {
+        if (it->child == child)
+            return it->parent;
+    }
+
+    return {};
+}
+
+void EntityCommandBuffer::flush() {
+    PHOS_PROFILE_ZONE_SCOPED;
+
+    // Take all the buffers, so that commands recorded during the flush end up in new ones
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    {
+        const std::scoped_lock lock(m_buffers_mutex);
+        buffers.swap(m_buffers);
+
+        // Threads may still have the taken buffers cached
+        m_id = s_next_command_buffer_id++;
+    }
+
+    std::size_t num_creates = 0;
+    for (const auto& buffer : buffers)
+        num_creates += buffer->creates.size();
+    m_scene->reserve_entities(num_creates);
+
+    std::vector<std::unique_ptr<ComponentCommand>> component_commands;
+    for (auto& buffer : buffers) {
+        for (auto& [entity, name, uuid] : buffer->creates)
+            m_scene->create_entity(entity, name, uuid);
+
+        std::ranges::move(buffer->component_commands, std::back_inserter(component_commands));
+    }
+
+    // Group component writes by type, keeping the recording order inside each type
+    std::ranges::stable_sort(component_commands, {}, &ComponentCommand::type_id);
+
+    for (const auto& command : component_commands) {
+        if (!m_scene->valid(command->entity)) {
+            PHOS_LOG_WARNING("Component command for entity {} which is no longer valid", command->entity.index());
+            continue;
+        }
+
+        auto entity = m_scene->get_entity(command->entity);
+        command->apply(entity);
+    }
+
+    for (const auto& buffer : buffers) {
+        for (const auto& [child, parent] : buffer->parent_commands) {
+            if (m_scene->valid(child) && m_scene->valid(parent))
+                m_scene->get_entity(child).set_parent(m_scene->get_entity(parent));
+        }
+    }
+
+    // Entities can be destroyed twice, or together with their parents, destroy_entities takes care of it
+    std::vector<Entity> destroys;
+    for (const auto& buffer : buffers) {
+        for (const auto entity : buffer->destroys) {
+            if (m_scene->valid(entity))
+                destroys.push_back(m_scene->get_entity(entity));
+        }
+    }
+
+    m_scene->destroy_entities(destroys);
+
+    // Keep the buffers with their capacity for the threads that record next
+    for (auto& buffer : buffers) {
+        buffer->creates.clear();
+        buffer->destroys.clear();
+        buffer->component_commands.clear();
+        buffer->parent_commands.clear();
+    }
+
+    const std::scoped_lock lock(m_buffers_mutex);
+    std::ranges::move(buffers, std::back_inserter(m_free_buffers));
+}
+
+bool EntityCommandBuffer::empty() const {
+    const std::scoped_lock lock(m_buffers_mutex);
+    return std::ranges::all_of(m_buffers, [](const auto& buffer) {
+        return buffer->creates.empty() && buffer->destroys.empty() && buffer->component_commands.empty() &&
+               buffer->parent_commands.empty();
+    });
+}
+
+EntityCommandBuffer::ThreadBuffer& EntityCommandBuffer::thread_buffer() {
+    auto& cache = s_thread_buffer_cache;
+    for (const auto& entry : cache.entries) {
+        if (entry.command_buffer_id == m_id)
+            return *static_cast<ThreadBuffer*>(entry.buffer);
+    }
+
+    const std::scoped_lock lock(m_buffers_mutex);
+
+    if (m_free_buffers.empty()) {
+        m_buffers.push_back(std::make_unique<ThreadBuffer>());
+    } else {
+        m_buffers.push_back(std::move(m_free_buffers.back()));
+        m_free_buffers.pop_back();
+    }
+
+    auto* buffer = m_buffers.back().get();
+    cache.entries[cache.next_entry_idx] = {.command_buffer_id = m_id, .buffer = buffer};
+    cache.next_entry_idx = (cache.next_entry_idx + 1) % cache.entries.size();
+
+    return *buffer;
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <optional>
+
+#include "core/uuid.h"
+#include "scene/entity.h"
+#include "scene/entity_handle.h"
+#include "scene/component_type.h"
+
+namespace Phos {
+
+/// Records structural changes (entity creation and destruction, adding and removing components, reparenting) to
+/// apply them later in a single flush, at a point where no one is iterating the scene.
+/// Commands can be recorded from several threads at the same time, every thread records into its own buffer.
+///
+/// On flush, commands are applied by kind rather than in recording order: creations first, then component additions
+/// and removals grouped by component type, then reparenting, and destructions last.
+class EntityCommandBuffer {
+  public:
+    explicit EntityCommandBuffer(Scene* scene);
+    ~EntityCommandBuffer();
+
+    EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+    EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+    /// The returned handle can be used in other commands right away, and refers to a scene entity after the flush
+    [[nodiscard]] EntityHandle create(std::string name = "Entity", UUID uuid = UUID());
+    void destroy(EntityHandle entity);
+
+    /// Adds the component, or replaces it if the entity already has one
+    template <typename T>
+    void add_component(EntityHandle entity, T component) {
+        auto command = std::make_unique<AddComponentCommand<T>>(std::move(component));
+        command->entity = entity;
+        command->type_id = ComponentType::id<T>();
+        command->adds = true;
+
+        thread_buffer().component_commands.push_back(std::move(command));
+    }
+
+    template <typename T>
+    void remove_component(EntityHandle entity) {
+        auto command = std::make_unique<RemoveComponentCommand<T>>();
+        command->entity = entity;
+        command->type_id = ComponentType::id<T>();
+
+        thread_buffer().component_commands.push_back(std::move(command));
+    }
+
+    void set_parent(EntityHandle child, EntityHandle parent);
+
+    /// Last value recorded by this thread with add_component for an entity that has not been flushed yet,
+    /// or nullptr. Allows initializing components of entities created in this frame.
+    template <typename T>
+    [[nodiscard]] T* find_pending_component(EntityHandle entity) {
+        auto& commands = thread_buffer().component_commands;
+        for (auto it = commands.rbegin(); it != commands.rend(); ++it) {
+            auto& command = **it;
+            if (command.entity != entity || command.type_id != ComponentType::id<T>())
+                continue;
+
+            // The type id identifies the component, so only the kind of command has to be checked
+            return command.adds ? &static_cast<AddComponentCommand<T>&>(command).component : nullptr;
+        }
+
+        return nullptr;
+    }
+
+    /// Parent of the last set_parent recorded by this thread for child that has not been flushed yet
+    [[nodiscard]] std::optional<EntityHandle> find_pending_parent(EntityHandle child);
+
+    /// Applies the commands recorded by all threads. Must be called from the thread that owns the scene, while no other
+    /// thread is recording. Commands recorded while flushing (for example by observers) are kept for the next flush.
+    void flush();
+
+    [[nodiscard]] bool empty() const;
+
+  private:
+    struct ComponentCommand {
+        virtual ~ComponentCommand() = default;
+        virtual void apply(Entity& entity) = 0;
+
+        EntityHandle entity;
+        std::size_t type_id = 0;
+        // AddComponentCommand if true, RemoveComponentCommand otherwise
+        bool adds = false;
+    };
+
+    template <typename T>
+    struct AddComponentCommand : ComponentCommand {
+        explicit AddComponentCommand(T c) : component(std::move(c)) {}
+
+        void apply(Entity& entity) override {
+            if (entity.has_component<T>()) {
+                entity.get_component<T>() = std::move(component);
+                entity.mark_changed<T>();
+            } else {
+                entity.add_component<T>(std::move(component));
+            }
+        }
+
+        T component;
+    };
+
+    template <typename T>
+    struct RemoveComponentCommand : ComponentCommand {
+        void apply(Entity& entity) override {
+            if (entity.has_component<T>())
+                entity.remove_component<T>();
+        }
+    };
+
+    struct CreateCommand {
+        EntityHandle entity;
+        std::string name;
+        UUID uuid;
+    };
+
+    struct ParentCommand {
+        EntityHandle child;
+        EntityHandle parent;
+    };
+
+    struct ThreadBuffer {
+        std::vector<CreateCommand> creates;
+        std::vector<EntityHandle> destroys;
+        std::vector<std::unique_ptr<ComponentCommand>> component_commands;
+        std::vector<ParentCommand> parent_commands;
+    };
+
+    Scene* m_scene;
+
+    // Identifies the current set of buffers in the per-thread caches, renewed on every flush
+    uint64_t m_id;
+
+    mutable std::mutex m_buffers_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    // Emptied buffers of previous flushes, reused so that recording does not allocate them again
+    std::vector<std::unique_ptr<ThreadBuffer>> m_free_buffers;
+
+    [[nodiscard]] ThreadBuffer& thread_buffer();
+};
+
+} // namespace Phos
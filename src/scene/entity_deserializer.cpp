@@ -13,66 +13,88 @@
 namespace Phos {
 
 template <typename T>
-void deserialize_component_t(const YAML::Node& node, Entity& entity, [[maybe_unused]] AssetManagerBase* asset_manager);
+T deserialize_component_t(const YAML::Node& node, [[maybe_unused]] AssetManagerBase* asset_manager);
 
-template <typename T>
+template <typename T, typename Func>
 void deserialize_component(const YAML::Node& node,
                            const std::string& name,
-                           Entity& entity,
-                           AssetManagerBase* asset_manager) {
+                           AssetManagerBase* asset_manager,
+                           Func& func) {
     if (!node[name])
         return;
 
-    deserialize_component_t<T>(node[name], entity, asset_manager);
+    func(deserialize_component_t<T>(node[name], asset_manager));
 }
 
-#define DESERIALIZE_COMPONENT(T, name) deserialize_component<T>(node, name, entity, asset_manager)
-
-Entity EntityDeserializer::deserialize(const YAML::Node& node,
-                                       const UUID& asset_id,
-                                       const std::shared_ptr<Scene>& scene,
-                                       AssetManagerBase* asset_manager) {
-    auto entity = scene->create_entity(asset_id);
+#define DESERIALIZE_COMPONENT(T, name) deserialize_component<T>(node, name, asset_manager, func)
 
+/// Calls func(component) for every component present in the node
+template <typename Func>
+void deserialize_components(const YAML::Node& node, AssetManagerBase* asset_manager, Func func) {
     DESERIALIZE_COMPONENT(NameComponent, "NameComponent");
-    DESERIALIZE_COMPONENT(RelationshipComponent, "RelationshipComponent");
     DESERIALIZE_COMPONENT(TransformComponent, "TransformComponent");
     DESERIALIZE_COMPONENT(MeshRendererComponent, "MeshRendererComponent");
     DESERIALIZE_COMPONENT(LightComponent, "LightComponent");
     DESERIALIZE_COMPONENT(CameraComponent, "CameraComponent");
     DESERIALIZE_COMPONENT(ScriptComponent, "ScriptComponent");
+}
+
+Entity EntityDeserializer::deserialize(const YAML::Node& node,
+                                       const UUID& asset_id,
+                                       const std::shared_ptr<Scene>& scene,
+                                       AssetManagerBase* asset_manager) {
+    auto entity = scene->create_entity(asset_id);
+
+    deserialize_components(node, asset_manager, [&]<typename T>(T component) {
+        // Default components are created together with the entity
+        if (entity.has_component<T>())
+            entity.get_component<T>() = std::move(component);
+        else
+            entity.add_component<T>(std::move(component));
+    });
 
     return entity;
 }
 
+EntityHandle EntityDeserializer::deserialize(const YAML::Node& node,
+                                             const UUID& asset_id,
+                                             EntityCommandBuffer& commands,
+                                             AssetManagerBase* asset_manager) {
+    const auto entity = commands.create("Entity", asset_id);
+
+    deserialize_components(node, asset_manager, [&]<typename T>(T component) {
+        commands.add_component<T>(entity, std::move(component));
+    });
+
+    return entity;
+}
+
+void EntityDeserializer::deserialize_children(const YAML::Node& node,
+                                              const Entity& entity,
+                                              const std::shared_ptr<Scene>& scene) {
+    const auto relationship_node = node["RelationshipComponent"];
+    if (!relationship_node || !relationship_node["children"])
+        return;
+
+    // Children are attached in the order they were saved
+    for (const auto child_uuid : relationship_node["children"])
+        scene->get_entity_with_uuid(UUID(child_uuid.as<uint64_t>())).set_parent(entity);
+}
+
 //
 // Specific deserialize_component_t
 //
 
-#define DESERIALIZE_COMPONENT_T(Type)   \
-    template <>                         \
-    void deserialize_component_t<Type>( \
-        const YAML::Node& node, Entity& entity, [[maybe_unused]] AssetManagerBase* asset_manager)
+#define DESERIALIZE_COMPONENT_T(Type) \
+    template <>                       \
+    Type deserialize_component_t<Type>(const YAML::Node& node, [[maybe_unused]] AssetManagerBase* asset_manager)
 
 DESERIALIZE_COMPONENT_T(NameComponent) {
-    entity.get_component<NameComponent>().name = node.as<std::string>();
-}
-
-DESERIALIZE_COMPONENT_T(RelationshipComponent) {
-    if (node["parent"]) {
-        const auto parent_uuid = node["parent"].as<uint64_t>();
-        entity.get_component<RelationshipComponent>().parent = UUID(parent_uuid);
-    }
-
-    if (node["children"]) {
-        for (const auto child_uuid : node["children"]) {
-            entity.get_component<RelationshipComponent>().children.emplace_back(child_uuid.as<uint64_t>());
-        }
-    }
+    return {.name = node.as<std::string>()};
 }
 
 DESERIALIZE_COMPONENT_T(TransformComponent) {
-    auto& transform = entity.get_component<TransformComponent>();
+    TransformComponent transform;
 
     const auto& position = node["position"];
     transform.position = glm::vec3(position["x"].as<float>(), position["y"].as<float>(), position["z"].as<float>());
@@ -82,6 +104,8 @@ DESERIALIZE_COMPONENT_T(TransformComponent) {
 
     const auto& scale = node["scale"];
     transform.scale = glm::vec3(scale["x"].as<float>(), scale["y"].as<float>(), scale["z"].as<float>());
+
+    return transform;
 }
 
 DESERIALIZE_COMPONENT_T(MeshRendererComponent) {
@@ -91,6 +115,7 @@ DESERIALIZE_COMPONENT_T(MeshRendererComponent) {
     auto component = MeshRendererComponent{
         .mesh = nullptr,
         .material = nullptr,
+        .occluder = node["occluder"] && node["occluder"].as<bool>(),
     };
 
     if (mesh_uuid != UUID(0)) {
@@ -101,7 +126,7 @@ DESERIALIZE_COMPONENT_T(MeshRendererComponent) {
         component.material = asset_manager->load_by_id_type<Material>(material_uuid);
     }
 
-    entity.add_component<MeshRendererComponent>(component);
+    return component;
 }
 
 DESERIALIZE_COMPONENT_T(LightComponent) {
@@ -129,12 +154,12 @@ DESERIALIZE_COMPONENT_T(LightComponent) {
     else if (shadow_type_str == "hard")
         shadow_type = Light::ShadowType::Hard;
 
-    entity.add_component<LightComponent>({
+    return {
         .type = light_type,
         .color = color,
         .intensity = intensity,
         .shadow_type = shadow_type,
-    });
+    };
 }
 
 DESERIALIZE_COMPONENT_T(CameraComponent) {
@@ -151,14 +176,14 @@ DESERIALIZE_COMPONENT_T(CameraComponent) {
     const auto zfar = node["zfar"].as<float>();
     const auto depth = node["depth"].as<int32_t>();
 
-    entity.add_component<CameraComponent>({
+    return {
         .type = camera_type,
         .fov = fov,
         .size = size,
         .znear = znear,
         .zfar = zfar,
         .depth = depth,
-    });
+    };
 }
 
 DESERIALIZE_COMPONENT_T(ScriptComponent) {
@@ -191,11 +216,11 @@ DESERIALIZE_COMPONENT_T(ScriptComponent) {
     const auto script_id = AssetParsingUtils::parse_uuid(node["script"]);
     const auto handle = asset_manager->load_by_id_type<ClassHandle>(script_id);
 
-    entity.add_component(ScriptComponent{
+    return {
         .class_name = handle->class_name(),
         .script = script_id,
         .field_values = std::move(field_values),
-    });
+    };
 }
 
 } // namespace Phos
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scene/entity.h"
+#include "scene/entity_command_buffer.h"
 
 // Forward declarations
 namespace YAML {
@@ -21,6 +22,16 @@ class EntityDeserializer {
                               const UUID& asset_id,
                               const std::shared_ptr<Scene>& scene,
                               AssetManagerBase* asset_manager);
+
+    /// Attaches the children listed in the node to the entity. The parent of an entity is not read, the relationship
+    /// is rebuilt from the children lists once every entity of the scene has been deserialized.
+    static void deserialize_children(const YAML::Node& node, const Entity& entity, const std::shared_ptr<Scene>& scene);
+
+    /// Records the creation of the entity in the command buffer, the returned handle is valid after the next flush
+    static EntityHandle deserialize(const YAML::Node& node,
+                                    const UUID& asset_id,
+                                    EntityCommandBuffer& commands,
+                                    AssetManagerBase* asset_manager);
 };
 
 } // namespace Phos
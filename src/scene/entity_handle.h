@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <functional>
+
+namespace Phos {
+
+/// Runtime identifier of an entity inside a Registry: index into the component sparse arrays, plus a version that
+/// is increased every time the index is recycled, so that handles to destroyed entities can be detected.
+/// Unlike UUID, it is not persistent and must not be serialized.
+class EntityHandle {
+  public:
+    EntityHandle() = default;
+    EntityHandle(uint32_t index, uint32_t version) : m_index(index), m_version(version) {}
+    explicit EntityHandle(uint64_t packed)
+          : m_index(static_cast<uint32_t>(packed)), m_version(static_cast<uint32_t>(packed >> 32)) {}
+
+    bool operator==(const EntityHandle& other) const = default;
+    explicit operator uint64_t() const { return (static_cast<uint64_t>(m_version) << 32) | m_index; }
+
+    [[nodiscard]] uint32_t index() const { return m_index; }
+    [[nodiscard]] uint32_t version() const { return m_version; }
+
+    static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+  private:
+    uint32_t m_index = INVALID_INDEX;
+    uint32_t m_version = 0;
+};
+
+} // namespace Phos
+
+namespace std {
+
+template <>
+struct hash<Phos::EntityHandle> {
+    std::size_t operator()(const Phos::EntityHandle& entity) const { return static_cast<uint64_t>(entity); }
+};
+
+} // namespace std
\ No newline at end of file
@@ -2,28 +2,129 @@
 
 namespace Phos {
 
-Registry::Registry() {
-    for (std::size_t i = 0; i < MAX_NUM_ENTITIES; ++i)
-        m_available_ids.push(i);
+Registry::Registry(StorageMode mode) : m_mode(mode) {
+    if (m_mode == StorageMode::Archetype)
+        m_archetype_storage = std::make_unique<ArchetypeStorage>();
+    else
+        m_component_manager = std::make_unique<ComponentManager>();
+}
+
+std::unique_ptr<Registry> Registry::clone() const {
+    auto copy = std::make_unique<Registry>(m_mode);
+
+    copy->m_versions = m_versions;
+    copy->m_free_indices = m_free_indices;
+    copy->m_tick = m_tick;
+
+    if (m_mode == StorageMode::Archetype)
+        copy->m_archetype_storage = m_archetype_storage->clone();
+    else
+        copy->m_component_manager = m_component_manager->clone();
+
+    return copy;
+}
+
+EntityHandle Registry::create() {
+    commit_reserved();
+
+    // Recycle destroyed indices first, so that component sparse pages stay compact
+    if (m_free_indices.empty()) {
+        m_versions.push_back(0);
+        return {static_cast<uint32_t>(m_versions.size() - 1), 0};
+    }
+
+    const auto index = m_free_indices.back();
+    m_free_indices.pop_back();
+
+    return {index, m_versions[index]};
+}
+
+std::vector<EntityHandle> Registry::create(std::size_t count) {
+    commit_reserved();
+
+    std::vector<EntityHandle> entities;
+    entities.reserve(count);
+
+    while (entities.size() < count && !m_free_indices.empty()) {
+        const auto index = m_free_indices.back();
+        m_free_indices.pop_back();
+
+        entities.emplace_back(index, m_versions[index]);
+    }
+
+    const auto first_index = static_cast<uint32_t>(m_versions.size());
+    const auto num_new = static_cast<uint32_t>(count - entities.size());
+    m_versions.resize(m_versions.size() + num_new, 0);
 
-    m_component_manager = std::make_unique<ComponentManager>();
+    for (uint32_t i = 0; i < num_new; ++i)
+        entities.emplace_back(first_index + i, 0);
+
+    return entities;
+}
+
+void Registry::destroy(std::span<const EntityHandle> entities) {
+    m_free_indices.reserve(m_free_indices.size() + entities.size());
+
+    for (const auto entity : entities)
+        destroy(entity);
+}
+
+EntityHandle Registry::reserve() {
+    // Only fresh indices are handed out, recycling would race with other threads popping the free list
+    const auto index = static_cast<uint32_t>(m_versions.size()) + m_num_reserved.fetch_add(1);
+    return {index, 0};
+}
+
+void Registry::commit_reserved() {
+    if (m_num_reserved == 0)
+        return;
+
+    m_versions.resize(m_versions.size() + m_num_reserved, 0);
+    m_num_reserved = 0;
 }
 
-std::size_t Registry::create() {
-    if (m_available_ids.empty()) {
-        PHOS_LOG_ERROR("Maximum number of entities reached");
-        return 0;
+void Registry::destroy(EntityHandle entity) {
+    if (!valid(entity)) {
+        PHOS_LOG_ERROR("Trying to destroy entity {} which is no longer valid", entity.index());
+        return;
     }
 
-    const auto id = m_available_ids.front();
-    m_available_ids.pop();
+    for (std::size_t type_id = 0; type_id < m_observers.size(); ++type_id) {
+        if (!m_observers[type_id].on_destroy.empty() && has_component(type_id, entity))
+            notify(type_id, &ComponentObservers::on_destroy, entity);
+    }
+
+    if (m_mode == StorageMode::Archetype)
+        m_archetype_storage->entity_destroyed(entity);
+    else
+        m_component_manager->entity_destroyed(entity);
+
+    // Invalidate existing handles to the entity
+    ++m_versions[entity.index()];
+    m_free_indices.push_back(entity.index());
+}
+
+bool Registry::has_component(std::size_t type_id, EntityHandle entity) const {
+    if (m_mode == StorageMode::Archetype)
+        return m_archetype_storage->has_component(entity, type_id);
 
-    return id;
+    const auto* array = m_component_manager->find_component_array(type_id);
+    return array != nullptr && array->entity_has_component(entity);
 }
 
-void Registry::destroy(std::size_t entity) {
-    m_available_ids.push(entity);
-    m_component_manager->entity_destroyed(entity);
+Registry::ComponentObservers& Registry::observers(std::size_t type_id) {
+    if (type_id >= m_observers.size())
+        m_observers.resize(type_id + 1);
+
+    return m_observers[type_id];
+}
+
+void Registry::notify(std::size_t type_id, std::vector<Observer> ComponentObservers::*event, EntityHandle entity) {
+    if (type_id >= m_observers.size())
+        return;
+
+    for (const auto& observer : m_observers[type_id].*event)
+        observer(*this, entity);
 }
 
 } // namespace Phos
\ No newline at end of file
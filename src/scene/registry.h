@@ -1,52 +1,182 @@
 #pragma once
 
-#include <queue>
+#include <span>
+#include <atomic>
+#include <vector>
 #include <memory>
+#include <functional>
 
 #include "scene/scene_constants.h"
 #include "utility/logging.h"
+#include "scene/entity_handle.h"
 #include "scene/component_manager.h"
+#include "scene/archetype_storage.h"
+#include "scene/view.h"
 
 namespace Phos {
 
 class Registry {
   public:
-    Registry();
+    /// How components are stored. SparseSet keeps one array per component type, which makes adding and removing
+    /// components cheap. Archetype groups entities by their set of components, which makes iterating views linear.
+    enum class StorageMode {
+        SparseSet,
+        Archetype,
+    };
+
+    using Observer = std::function<void(Registry&, EntityHandle)>;
+
+    explicit Registry(StorageMode mode = StorageMode::SparseSet);
     ~Registry() = default;
 
-    std::size_t create();
-    void destroy(std::size_t entity);
+    /// Copy of the entities, with the same handles, and of all their components. Observers are not copied.
+    [[nodiscard]] std::unique_ptr<Registry> clone() const;
+
+    EntityHandle create();
+    void destroy(EntityHandle entity);
+
+    /// Creates count entities at once, recycling destroyed indices first
+    [[nodiscard]] std::vector<EntityHandle> create(std::size_t count);
+    void destroy(std::span<const EntityHandle> entities);
+
+    /// Reserves a handle for an entity that will be created later. Can be called from several threads at the same
+    /// time, but not concurrently with the rest of the Registry functions. Reserved handles become valid (without
+    /// components) on commit_reserved or on the next create.
+    EntityHandle reserve();
+    void commit_reserved();
+
+    /// Whether the handle refers to an entity that has not been destroyed
+    [[nodiscard]] bool valid(EntityHandle entity) const {
+        return entity.index() < m_versions.size() && m_versions[entity.index()] == entity.version();
+    }
 
     template <typename T>
-    void add_component(std::size_t entity_id, T component) {
+    void add_component(EntityHandle entity, T component) {
+        // The storage would ignore the component, observers must not see a construction that did not happen
+        if (has_component<T>(entity)) {
+            PHOS_LOG_ERROR("Component added to entity {} more than once", entity.index());
+            return;
+        }
+
+        if (m_mode == StorageMode::Archetype) {
+            m_archetype_storage->add_component(entity, std::move(component), m_tick);
+        } else {
+            if (!m_component_manager->contains_component<T>())
+                m_component_manager->register_component<T>();
+
+            m_component_manager->add_component(entity, std::move(component), m_tick);
+        }
+
+        notify(ComponentType::id<T>(), &ComponentObservers::on_construct, entity);
+    }
+
+    template <typename T>
+    void remove_component(EntityHandle entity) {
+        if (has_component<T>(entity))
+            notify(ComponentType::id<T>(), &ComponentObservers::on_destroy, entity);
+
+        if (m_mode == StorageMode::Archetype)
+            m_archetype_storage->remove_component<T>(entity);
+        else
+            m_component_manager->remove_component<T>(entity);
+    }
+
+    /// Makes room for count more components of type T, to avoid reallocations when adding many at once.
+    /// Archetype storage allocates fixed size chunks on demand, so it does not need it.
+    template <typename T>
+    void reserve_components(std::size_t count) {
+        if (m_mode == StorageMode::Archetype)
+            return;
+
         if (!m_component_manager->contains_component<T>())
             m_component_manager->register_component<T>();
 
-        m_component_manager->add_component(entity_id, component);
+        auto* array = m_component_manager->find_component_array<T>();
+        array->reserve(array->size() + count);
     }
 
+    /// Mutable access. Changes made through the reference are not tracked, use patch or mark_changed for that.
     template <typename T>
-    void remove_component(std::size_t entity_id) {
-        m_component_manager->remove_component<T>(entity_id);
+    [[nodiscard]] T& get_component(EntityHandle entity) const {
+        if (m_mode == StorageMode::Archetype)
+            return m_archetype_storage->get_component<T>(entity);
+        return m_component_manager->get_component<T>(entity);
     }
 
     template <typename T>
-    [[nodiscard]] T& get_component(std::size_t entity_id) const {
-        return m_component_manager->get_component<T>(entity_id);
+    [[nodiscard]] bool has_component(EntityHandle entity) const {
+        if (m_mode == StorageMode::Archetype)
+            return m_archetype_storage->has_component<T>(entity);
+        return m_component_manager->entity_has_component<T>(entity);
+    }
+
+    /// Calls func(component) and marks the component as changed
+    template <typename T, typename Func>
+    void patch(EntityHandle entity, Func&& func) {
+        func(get_component<T>(entity));
+        mark_changed<T>(entity);
     }
 
+    /// Marks the component as changed in the current tick and notifies the on_update observers
     template <typename T>
-    [[nodiscard]] bool has_component(std::size_t entity_id) const {
-        return m_component_manager->entity_has_component<T>(entity_id);
+    void mark_changed(EntityHandle entity) {
+        changed_tick<T>(entity) = m_tick;
+        notify(ComponentType::id<T>(), &ComponentObservers::on_update, entity);
     }
 
+    /// Whether the component was added or changed after the given tick
     template <typename T>
-    [[nodiscard]] std::vector<std::size_t> view() const {
-        return m_component_manager->get_entities_with_component<T>();
+    [[nodiscard]] bool changed_since(EntityHandle entity, uint64_t tick) const {
+        return changed_tick<T>(entity) > tick;
     }
 
+    /// Calls func(entity, component) for every component of type T added or changed after the given tick
+    template <typename T, typename Func>
+    void for_each_changed(uint64_t since_tick, Func&& func) const {
+        if (m_mode == StorageMode::Archetype) {
+            m_archetype_storage->for_each_changed<T>(since_tick, func);
+            return;
+        }
+
+        if (auto* array = m_component_manager->find_component_array<T>())
+            array->for_each_changed(since_tick, func);
+    }
+
+    /// Changes are stamped with the current tick. A system that consumes changes remembers the value returned by
+    /// advance_tick, and on its next run asks for the changes made since then.
+    [[nodiscard]] uint64_t current_tick() const { return m_tick; }
+    uint64_t advance_tick() { return m_tick++; }
+
+    /// Observers are called after a component is added, after it is marked as changed, and before it is removed
+    /// (including when its entity is destroyed)
+    template <typename T>
+    void on_construct(Observer observer) {
+        observers(ComponentType::id<T>()).on_construct.push_back(std::move(observer));
+    }
+
+    template <typename T>
+    void on_update(Observer observer) {
+        observers(ComponentType::id<T>()).on_update.push_back(std::move(observer));
+    }
+
+    template <typename T>
+    void on_destroy(Observer observer) {
+        observers(ComponentType::id<T>()).on_destroy.push_back(std::move(observer));
+    }
+
+    template <typename... Components>
+    [[nodiscard]] View<Components...> view() const {
+        if (m_mode == StorageMode::Archetype)
+            return View<Components...>(m_archetype_storage.get());
+        return View<Components...>(m_component_manager->find_component_array<Components>()...);
+    }
+
+    /// Only needed for sparse set storage, archetype storage learns about component types as they are added
     template <typename T>
     void register_component() {
+        if (m_mode == StorageMode::Archetype)
+            return;
+
         if (!m_component_manager->contains_component<T>()) {
             m_component_manager->register_component<T>();
         } else {
@@ -54,13 +184,45 @@ class Registry {
         }
     }
 
+    [[nodiscard]] StorageMode storage_mode() const { return m_mode; }
+
     [[nodiscard]] uint32_t number_entities() const {
-        return MAX_NUM_ENTITIES - static_cast<uint32_t>(m_available_ids.size());
+        return static_cast<uint32_t>(m_versions.size() - m_free_indices.size());
     }
 
   private:
-    std::queue<std::size_t> m_available_ids;
+    // Current version of every entity index ever created
+    std::vector<uint32_t> m_versions;
+    // Indices of destroyed entities, ready to be recycled
+    std::vector<uint32_t> m_free_indices;
+    // Number of indices reserved after the end of m_versions
+    std::atomic<uint32_t> m_num_reserved = 0;
+
+    StorageMode m_mode;
     std::unique_ptr<ComponentManager> m_component_manager;
+    std::unique_ptr<ArchetypeStorage> m_archetype_storage;
+
+    // Starts at 1 so that components added in the first tick are newer than a system that has never run (tick 0)
+    uint64_t m_tick = 1;
+
+    struct ComponentObservers {
+        std::vector<Observer> on_construct;
+        std::vector<Observer> on_update;
+        std::vector<Observer> on_destroy;
+    };
+    std::vector<ComponentObservers> m_observers; // Indexed by ComponentType::id
+
+    template <typename T>
+    [[nodiscard]] uint64_t& changed_tick(EntityHandle entity) const {
+        if (m_mode == StorageMode::Archetype)
+            return m_archetype_storage->changed_tick<T>(entity);
+        return m_component_manager->find_component_array<T>()->changed_tick(entity);
+    }
+
+    [[nodiscard]] bool has_component(std::size_t type_id, EntityHandle entity) const;
+
+    ComponentObservers& observers(std::size_t type_id);
+    void notify(std::size_t type_id, std::vector<Observer> ComponentObservers::*event, EntityHandle entity);
 };
 
 } // namespace Phos
@@ -7,56 +7,33 @@
 
 namespace Phos {
 
-Scene::Scene(std::string name) : m_name(std::move(name)) {
-    m_registry = std::make_unique<Registry>();
+Scene::Scene(std::string name, Registry::StorageMode storage_mode) : m_name(std::move(name)) {
+    m_registry = std::make_unique<Registry>(storage_mode);
 
     // Register default components
-    m_registry->register_component<Phos::UUIDComponent>();
-    m_registry->register_component<Phos::RelationshipComponent>();
     m_registry->register_component<Phos::NameComponent>();
 
     m_registry->register_component<Phos::TransformComponent>();
+    m_registry->register_component<Phos::WorldTransformComponent>();
     m_registry->register_component<Phos::MeshRendererComponent>();
     m_registry->register_component<Phos::LightComponent>();
     m_registry->register_component<Phos::CameraComponent>();
     m_registry->register_component<Phos::ScriptComponent>();
-}
-
-#define COPY_COMPONENT(T)                              \
-    if (entity.has_component<T>()) {                   \
-        const auto c = entity.get_component<T>();      \
-        if (copy_entity.has_component<T>()) {          \
-            auto& cc = copy_entity.get_component<T>(); \
-            cc = c;                                    \
-        } else {                                       \
-            copy_entity.add_component<T>(c);           \
-        }                                              \
-    }
-
-Scene::Scene(Scene& other) : Scene(other.name() + "Copy") {
-    // @TODO: Probably very slow, look into more efficient way
-    // Leaving for the moment because there will not be many copies
-    for (const auto& entity : other.get_all_entities()) {
-        auto copy_entity = create_entity(entity.uuid());
-
-        COPY_COMPONENT(NameComponent);
-        COPY_COMPONENT(RelationshipComponent);
-        COPY_COMPONENT(TransformComponent);
-        COPY_COMPONENT(LightComponent);
-        COPY_COMPONENT(MeshRendererComponent);
-        COPY_COMPONENT(CameraComponent);
-        COPY_COMPONENT(ScriptComponent);
-    }
 
-    m_renderer_config = other.m_renderer_config;
+    register_observers();
 }
 
-Scene::~Scene() {
-    for (auto& [_, entity] : m_id_to_entity) {
-        delete entity;
-    }
+Scene::Scene(Scene& other)
+      : m_name(other.name() + "Copy"), m_registry(other.m_registry->clone()),
+        m_renderer_config(other.m_renderer_config), m_entity_uuids(other.m_entity_uuids),
+        m_uuid_to_entity(other.m_uuid_to_entity), m_hierarchy(other.m_hierarchy),
+        m_world_transform_tick(other.m_world_transform_tick), m_spatial_index(other.m_spatial_index),
+        m_spatial_index_tick(other.m_spatial_index_tick) {
+    register_observers();
 }
 
+Scene::~Scene() = default;
+
 Entity Scene::create_entity() {
     const auto num_entities = m_uuid_to_entity.size();
     const std::string default_name = "Entity " + std::to_string(num_entities);
@@ -70,61 +47,126 @@ Entity Scene::create_entity(const UUID uuid) {
 }
 
 Entity Scene::create_entity(const std::string& name, const UUID uuid) {
-    auto* entity = new Entity(m_registry->create(), this);
-    m_id_to_entity[entity->id()] = entity;
+    return create_entity(m_registry->create(), name, uuid);
+}
+
+Entity Scene::create_entity(EntityHandle handle, const std::string& name, UUID uuid) {
+    // Handles given by reserve_entity become valid here
+    m_registry->commit_reserved();
+
+    if (handle.index() >= m_entity_uuids.size())
+        m_entity_uuids.resize(handle.index() + 1, UUID(0));
+
+    m_entity_uuids[handle.index()] = uuid;
+    m_uuid_to_entity.insert({uuid, handle});
+    m_hierarchy.add(handle);
+
+    auto entity = Entity(handle, this);
 
     // Default components
-    entity->add_component<TransformComponent>();
-    entity->add_component<UUIDComponent>({.uuid = uuid});
-    entity->add_component<RelationshipComponent>();
-    entity->add_component<NameComponent>({.name = name});
+    entity.add_component<TransformComponent>();
+    entity.add_component<WorldTransformComponent>();
+    entity.add_component<NameComponent>({.name = name});
+
+    return entity;
+}
+
+std::vector<Entity> Scene::create_entities(std::size_t count, const std::string& name_prefix) {
+    const auto first_number = m_uuid_to_entity.size();
+    const auto handles = m_registry->create(count);
+
+    reserve_entities(count);
+
+    std::vector<Entity> entities;
+    entities.reserve(count);
 
-    m_uuid_to_entity[entity->uuid()] = entity;
+    for (const auto handle : handles) {
+        if (handle.index() >= m_entity_uuids.size())
+            m_entity_uuids.resize(handle.index() + 1, UUID(0));
 
-    return *entity;
+        const auto uuid = UUID();
+        m_entity_uuids[handle.index()] = uuid;
+        m_uuid_to_entity.insert({uuid, handle});
+        m_hierarchy.add(handle);
+
+        entities.emplace_back(handle, this);
+    }
+
+    // Default components, one type at a time so that every pool is filled in one go
+    for (const auto handle : handles)
+        m_registry->add_component(handle, TransformComponent{});
+
+    for (const auto handle : handles)
+        m_registry->add_component(handle, WorldTransformComponent{});
+
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+        const auto name = name_prefix + " " + std::to_string(first_number + i);
+        m_registry->add_component(handles[i], NameComponent{.name = name});
+    }
+
+    return entities;
 }
 
 void Scene::destroy_entity(Entity entity) {
-    destroy_entity_r(entity);
+    destroy_subtree(entity);
 }
 
-void Scene::destroy_entity_r(Phos::Entity entity) {
-    auto* e = m_id_to_entity[entity.id()];
+void Scene::destroy_subtree(Entity root) {
+    destroy_entities(std::span(&root, 1));
+}
 
-    // Remove entity from parent children
-    const auto relationship = entity.get_component<RelationshipComponent>();
-    if (relationship.parent) {
-        const auto parent = get_entity_with_uuid(*relationship.parent);
-        parent.remove_child(entity);
-    }
+void Scene::destroy_entities(std::span<const Entity> entities) {
+    std::vector<EntityHandle> roots;
+    roots.reserve(entities.size());
 
-    // Remove child entities
-    for (const auto& child_id : relationship.children) {
-        const auto child = get_entity_with_uuid(child_id);
-        destroy_entity_r(child);
+    for (const auto& entity : entities) {
+        if (valid(entity.id()))
+            roots.push_back(entity.id());
     }
 
-    m_id_to_entity.erase(entity.id());
-    m_uuid_to_entity.erase(entity.uuid());
+    // Subtrees are contiguous in the hierarchy, so they are removed in a single pass
+    const auto destroyed = m_hierarchy.remove_subtrees(roots);
 
-    m_registry->destroy(entity.id());
+    for (const auto handle : destroyed)
+        m_uuid_to_entity.erase(m_entity_uuids[handle.index()]);
 
-    delete e;
+    m_registry->destroy(destroyed);
 }
 
 Entity Scene::get_entity_with_uuid(const UUID& uuid) {
+    const auto it = m_uuid_to_entity.find(uuid);
     PHOS_ASSERT(
-        m_uuid_to_entity.contains(uuid), "Scene does not contain entity with uuid: {}", static_cast<uint64_t>(uuid));
+        it != m_uuid_to_entity.end(), "Scene does not contain entity with uuid: {}", static_cast<uint64_t>(uuid));
+
+    return {it->second, this};
+}
+
+Entity Scene::get_entity(EntityHandle handle) {
+    PHOS_ASSERT(m_registry->valid(handle), "Entity handle {} is no longer valid", static_cast<uint64_t>(handle));
+    return {handle, this};
+}
+
+void Scene::reserve_entities(std::size_t count) {
+    m_registry->reserve_components<TransformComponent>(count);
+    m_registry->reserve_components<WorldTransformComponent>(count);
+    m_registry->reserve_components<NameComponent>(count);
+
+    m_uuid_to_entity.reserve(m_uuid_to_entity.size() + count);
+    m_hierarchy.reserve(count);
+}
 
-    return *m_uuid_to_entity[uuid];
+void Scene::register_observers() {
+    // Also called when the entity is destroyed
+    m_registry->on_destroy<MeshRendererComponent>(
+        [&](Registry&, EntityHandle entity) { m_spatial_index.remove(entity); });
 }
 
-std::vector<Entity> Scene::get_all_entities() const {
-    std::vector<Entity> entities(m_uuid_to_entity.size());
+std::vector<Entity> Scene::get_all_entities() {
+    std::vector<Entity> entities;
+    entities.reserve(m_uuid_to_entity.size());
 
-    uint32_t i = 0;
-    for (const auto& [_, entity] : m_uuid_to_entity) {
-        entities[i++] = *entity;
+    for (const auto& [_, handle] : m_uuid_to_entity) {
+        entities.emplace_back(handle, this);
     }
 
     return entities;
@@ -7,13 +7,13 @@ namespace Phos {
 
 template <typename... Components>
 [[nodiscard]] std::vector<Entity> Scene::get_entities_with() {
-    const auto ids = m_registry->view<Components...>();
+    const auto view = m_registry->view<Components...>();
 
     std::vector<Entity> entities;
-    entities.reserve(ids.size());
+    entities.reserve(view.size_hint());
 
-    for (const auto& entity_id : ids)
-        entities.push_back(*m_id_to_entity[entity_id]);
+    for (const auto& components : view)
+        entities.emplace_back(std::get<0>(components), this);
 
     return entities;
 }
@@ -1,7 +1,15 @@
 #pragma once
 
+#include <cstdint>
+#include <cstddef>
+
 namespace Phos {
 
-constexpr uint32_t MAX_NUM_ENTITIES = 500;
+// Number of entities covered by each page of a ComponentArray's sparse index
+constexpr uint32_t COMPONENT_ARRAY_PAGE_SIZE = 4096;
+
+// Size and alignment, in bytes, of the chunks where archetype storage keeps its components
+constexpr std::size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+constexpr std::size_t ARCHETYPE_CHUNK_ALIGNMENT = 64;
 
 } // namespace Phos
\ No newline at end of file
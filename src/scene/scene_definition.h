@@ -1,8 +1,12 @@
 #pragma once
 
+#include <span>
+
 #include "asset/asset.h"
 
 #include "scene/registry.h"
+#include "scene/scene_hierarchy.h"
+#include "scene/spatial_index.h"
 #include "scene/components.h"
 #include "scene/scene_renderer.h"
 
@@ -14,7 +18,7 @@ class Entity;
 
 class Scene : public IAsset {
   public:
-    explicit Scene(std::string name);
+    explicit Scene(std::string name, Registry::StorageMode storage_mode = Registry::StorageMode::SparseSet);
     Scene(Scene& other);
     ~Scene() override;
 
@@ -24,14 +28,62 @@ class Scene : public IAsset {
     Entity create_entity(UUID uuid);
     Entity create_entity(const std::string& name, UUID uuid);
 
+    /// Creates count entities with new uuids and the default components, named "<name_prefix> <number>"
+    std::vector<Entity> create_entities(std::size_t count, const std::string& name_prefix = "Entity");
+
+    /// Destroys the entity and all its descendants
     void destroy_entity(Entity entity);
+    void destroy_subtree(Entity root);
+    /// Destroys the entities and all their descendants. Entities can appear more than once, or inside the subtree of
+    /// another entity in the list.
+    void destroy_entities(std::span<const Entity> entities);
+
+    /// Handle for an entity that will be created by an EntityCommandBuffer flush, see Registry::reserve
+    [[nodiscard]] EntityHandle reserve_entity() { return m_registry->reserve(); }
+    [[nodiscard]] bool valid(EntityHandle handle) const { return m_registry->valid(handle); }
+
+    /// Parent and child links of the entities, see Entity::set_parent to modify it
+    [[nodiscard]] const SceneHierarchy& hierarchy() const { return m_hierarchy; }
+
+    /// World space bounds of the entities with a mesh, updated by SpatialIndexSystem
+    [[nodiscard]] const SpatialIndex& spatial_index() const { return m_spatial_index; }
 
     [[nodiscard]] Entity get_entity_with_uuid(const UUID& uuid);
-    [[nodiscard]] std::vector<Entity> get_all_entities() const;
+    [[nodiscard]] Entity get_entity(EntityHandle handle);
+    [[nodiscard]] std::vector<Entity> get_all_entities();
 
     template <typename... Components>
     [[nodiscard]] std::vector<Entity> get_entities_with();
 
+    template <typename... Components>
+    [[nodiscard]] View<Components...> view() const {
+        return m_registry->view<Components...>();
+    }
+
+    /// See Registry::for_each_changed and Registry::advance_tick
+    template <typename T, typename Func>
+    void for_each_changed(uint64_t since_tick, Func&& func) const {
+        m_registry->for_each_changed<T>(since_tick, std::forward<Func>(func));
+    }
+
+    [[nodiscard]] uint64_t current_tick() const { return m_registry->current_tick(); }
+    uint64_t advance_tick() { return m_registry->advance_tick(); }
+
+    template <typename T>
+    void on_construct(Registry::Observer observer) {
+        m_registry->on_construct<T>(std::move(observer));
+    }
+
+    template <typename T>
+    void on_update(Registry::Observer observer) {
+        m_registry->on_update<T>(std::move(observer));
+    }
+
+    template <typename T>
+    void on_destroy(Registry::Observer observer) {
+        m_registry->on_destroy<T>(std::move(observer));
+    }
+
     [[nodiscard]] std::string name() const { return m_name; }
     [[nodiscard]] SceneRendererConfig& config() { return m_renderer_config; }
 
@@ -40,12 +92,29 @@ class Scene : public IAsset {
     std::unique_ptr<Registry> m_registry;
     SceneRendererConfig m_renderer_config;
 
-    std::unordered_map<std::size_t, Entity*> m_id_to_entity;
-    std::unordered_map<UUID, Entity*> m_uuid_to_entity;
+    // Persistent identity of every entity, indexed by EntityHandle::index
+    std::vector<UUID> m_entity_uuids;
+    std::unordered_map<UUID, EntityHandle> m_uuid_to_entity;
+
+    SceneHierarchy m_hierarchy;
+
+    // Tick of the last TransformSystem update
+    uint64_t m_world_transform_tick = 0;
+
+    SpatialIndex m_spatial_index;
+    // Tick of the last SpatialIndexSystem update
+    uint64_t m_spatial_index_tick = 0;
 
-    void destroy_entity_r(Entity entity);
+    Entity create_entity(EntityHandle handle, const std::string& name, UUID uuid);
+    // Reserves space for the default components and indices of count new entities
+    void reserve_entities(std::size_t count);
+    // Observers are not cloned with the registry, so every constructor registers them
+    void register_observers();
 
     friend class Entity;
+    friend class EntityCommandBuffer;
+    friend class TransformSystem;
+    friend class SpatialIndexSystem;
 };
 
 } // namespace Phos
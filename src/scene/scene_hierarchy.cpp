@@ -0,0 +1,192 @@
+#include "scene_hierarchy.h"
+
+#include <algorithm>
+
+#include "utility/logging.h"
+
+namespace Phos {
+
+void SceneHierarchy::add(EntityHandle entity) {
+    PHOS_ASSERT(!contains(entity), "Entity {} is already in the hierarchy", entity.index());
+
+    if (entity.index() >= m_nodes.size())
+        m_nodes.resize(entity.index() + 1);
+
+    node(entity) = Node{
+        .position = static_cast<uint32_t>(m_order.size()),
+        .subtree_size = 1,
+    };
+    m_order.push_back(entity);
+}
+
+std::vector<EntityHandle> SceneHierarchy::remove_subtrees(std::span<const EntityHandle> roots) {
+    // Every subtree is a contiguous range of the order, and two subtrees are either disjoint or nested
+    struct Range {
+        uint32_t begin;
+        uint32_t end;
+        EntityHandle root;
+    };
+
+    std::vector<Range> ranges;
+    ranges.reserve(roots.size());
+
+    for (const auto root : roots) {
+        if (!contains(root))
+            continue;
+
+        const auto& root_node = node(root);
+        ranges.push_back(Range{
+            .begin = root_node.position,
+            .end = root_node.position + root_node.subtree_size,
+            .root = root,
+        });
+    }
+
+    if (ranges.empty())
+        return {};
+
+    // Drop the repeated subtrees and the ones nested in another subtree of the list
+    std::ranges::sort(ranges, [](const Range& a, const Range& b) {
+        return a.begin < b.begin || (a.begin == b.begin && a.end > b.end);
+    });
+
+    std::size_t num_ranges = 0;
+    for (const auto& range : ranges) {
+        if (num_ranges > 0 && range.begin < ranges[num_ranges - 1].end)
+            continue;
+
+        ranges[num_ranges++] = range;
+    }
+    ranges.resize(num_ranges);
+
+    // Only the roots of the remaining subtrees have to be detached, their parents are not removed
+    std::vector<EntityHandle> removed;
+    for (const auto& range : ranges) {
+        detach(range.root);
+
+        for (auto position = range.begin; position < range.end; ++position) {
+            const auto entity = m_order[position];
+            removed.push_back(entity);
+            node(entity) = Node{};
+        }
+    }
+
+    // Erase from the last range so that the positions of the ranges before it stay valid
+    for (auto it = ranges.rbegin(); it != ranges.rend(); ++it)
+        m_order.erase(m_order.begin() + it->begin, m_order.begin() + it->end);
+
+    // Entities before the first removed range keep their positions
+    update_positions(ranges.front().begin, static_cast<uint32_t>(m_order.size()));
+
+    return removed;
+}
+
+bool SceneHierarchy::set_parent(EntityHandle child, EntityHandle parent) {
+    PHOS_ASSERT(contains(child), "Entity {} is not in the hierarchy", child.index());
+
+    if (is_valid(parent)) {
+        PHOS_ASSERT(contains(parent), "Entity {} is not in the hierarchy", parent.index());
+
+        if (is_ancestor(child, parent)) {
+            PHOS_LOG_ERROR("Can't set entity {} as parent of {}, it is one of its descendants",
+                           parent.index(),
+                           child.index());
+            return false;
+        }
+    }
+
+    const auto begin = node(child).position;
+    const auto count = node(child).subtree_size;
+
+    // End of the parent subtree, computed before the subtree sizes change so that it is also correct when parent is
+    // an ancestor of child
+    const auto destination = is_valid(parent) ? node(parent).position + node(parent).subtree_size
+                                              : static_cast<uint32_t>(m_order.size());
+
+    detach(child);
+
+    // Move the subtree as a single range, only the positions of the entities in between change
+    const auto order_begin = m_order.begin();
+    if (destination > begin) {
+        std::rotate(order_begin + begin, order_begin + begin + count, order_begin + destination);
+        update_positions(begin, destination);
+    } else if (destination < begin) {
+        std::rotate(order_begin + destination, order_begin + begin, order_begin + begin + count);
+        update_positions(destination, begin + count);
+    }
+
+    if (is_valid(parent))
+        attach(child, parent);
+
+    return true;
+}
+
+void SceneHierarchy::reserve(std::size_t count) {
+    m_nodes.reserve(m_nodes.size() + count);
+    m_order.reserve(m_order.size() + count);
+}
+
+std::vector<EntityHandle> SceneHierarchy::children(EntityHandle entity) const {
+    std::vector<EntityHandle> children;
+    for (auto child = node(entity).first_child; is_valid(child); child = node(child).next_sibling)
+        children.push_back(child);
+
+    return children;
+}
+
+std::vector<EntityHandle> SceneHierarchy::roots() const {
+    std::vector<EntityHandle> roots;
+    for (std::size_t position = 0; position < m_order.size(); position += node(m_order[position]).subtree_size)
+        roots.push_back(m_order[position]);
+
+    return roots;
+}
+
+void SceneHierarchy::detach(EntityHandle entity) {
+    auto& entity_node = node(entity);
+    if (!is_valid(entity_node.parent))
+        return;
+
+    auto& parent_node = node(entity_node.parent);
+
+    if (is_valid(entity_node.prev_sibling))
+        node(entity_node.prev_sibling).next_sibling = entity_node.next_sibling;
+    else
+        parent_node.first_child = entity_node.next_sibling;
+
+    if (is_valid(entity_node.next_sibling))
+        node(entity_node.next_sibling).prev_sibling = entity_node.prev_sibling;
+    else
+        parent_node.last_child = entity_node.prev_sibling;
+
+    for (auto ancestor = entity_node.parent; is_valid(ancestor); ancestor = node(ancestor).parent)
+        node(ancestor).subtree_size -= entity_node.subtree_size;
+
+    entity_node.parent = {};
+    entity_node.next_sibling = {};
+    entity_node.prev_sibling = {};
+}
+
+void SceneHierarchy::attach(EntityHandle entity, EntityHandle parent) {
+    auto& entity_node = node(entity);
+    auto& parent_node = node(parent);
+
+    entity_node.parent = parent;
+    entity_node.prev_sibling = parent_node.last_child;
+
+    if (is_valid(parent_node.last_child))
+        node(parent_node.last_child).next_sibling = entity;
+    else
+        parent_node.first_child = entity;
+    parent_node.last_child = entity;
+
+    for (auto ancestor = parent; is_valid(ancestor); ancestor = node(ancestor).parent)
+        node(ancestor).subtree_size += entity_node.subtree_size;
+}
+
+void SceneHierarchy::update_positions(uint32_t begin, uint32_t end) {
+    for (auto position = begin; position < end; ++position)
+        node(m_order[position]).position = position;
+}
+
+} // namespace Phos
\ No newline at end of file
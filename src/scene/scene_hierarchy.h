@@ -0,0 +1,101 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <limits>
+
+#include "scene/entity_handle.h"
+
+namespace Phos {
+
+/// Parent and child links of the entities of a scene, stored by entity index.
+/// Entities are also kept in a dense depth-first order, where every entity is followed by all its descendants, so a
+/// linear sweep visits parents before their children and every subtree is a contiguous range of the order.
+/// Roots are ordered by insertion, and children of an entity are ordered by the time they were attached to it.
+class SceneHierarchy {
+  public:
+    SceneHierarchy() = default;
+    ~SceneHierarchy() = default;
+
+    /// Adds the entity as the last root of the hierarchy
+    void add(EntityHandle entity);
+
+    /// Removes the entities together with all their descendants, and returns the removed entities in depth-first
+    /// order. Entities can appear more than once, or inside the subtree of another entity in the list.
+    [[nodiscard]] std::vector<EntityHandle> remove_subtrees(std::span<const EntityHandle> roots);
+
+    /// Moves the subtree of child to be the last child of parent, or the last root if parent is an invalid handle.
+    /// The subtree is moved as a single range of the depth-first order. Returns false, leaving the hierarchy
+    /// untouched, if parent is inside the subtree of child.
+    bool set_parent(EntityHandle child, EntityHandle parent = {});
+
+    /// Makes room for count more entities without reallocating
+    void reserve(std::size_t count);
+
+    [[nodiscard]] bool contains(EntityHandle entity) const {
+        return entity.index() < m_nodes.size() && m_nodes[entity.index()].position < m_order.size() &&
+               m_order[m_nodes[entity.index()].position] == entity;
+    }
+
+    // Links are invalid handles when missing
+    [[nodiscard]] EntityHandle parent(EntityHandle entity) const { return node(entity).parent; }
+    [[nodiscard]] EntityHandle first_child(EntityHandle entity) const { return node(entity).first_child; }
+    [[nodiscard]] EntityHandle next_sibling(EntityHandle entity) const { return node(entity).next_sibling; }
+
+    [[nodiscard]] bool has_parent(EntityHandle entity) const { return is_valid(node(entity).parent); }
+    [[nodiscard]] bool has_children(EntityHandle entity) const { return is_valid(node(entity).first_child); }
+
+    [[nodiscard]] std::vector<EntityHandle> children(EntityHandle entity) const;
+    [[nodiscard]] std::vector<EntityHandle> roots() const;
+
+    /// Whether ancestor is entity or one of its ancestors
+    [[nodiscard]] bool is_ancestor(EntityHandle ancestor, EntityHandle entity) const {
+        const auto& ancestor_node = node(ancestor);
+        const auto position = node(entity).position;
+        return position >= ancestor_node.position && position < ancestor_node.position + ancestor_node.subtree_size;
+    }
+
+    /// Position of the entity in the depth-first order
+    [[nodiscard]] uint32_t position(EntityHandle entity) const { return node(entity).position; }
+
+    /// The entity followed by all its descendants, in depth-first order
+    [[nodiscard]] std::span<const EntityHandle> subtree(EntityHandle entity) const {
+        const auto& entity_node = node(entity);
+        return std::span(m_order).subspan(entity_node.position, entity_node.subtree_size);
+    }
+
+    /// Every entity in the hierarchy, in depth-first order
+    [[nodiscard]] std::span<const EntityHandle> order() const { return m_order; }
+    [[nodiscard]] std::size_t size() const { return m_order.size(); }
+
+  private:
+    static constexpr uint32_t INVALID_POSITION = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        EntityHandle parent;
+        EntityHandle first_child;
+        EntityHandle last_child;
+        EntityHandle next_sibling;
+        EntityHandle prev_sibling;
+
+        uint32_t position = INVALID_POSITION;
+        uint32_t subtree_size = 0; // Including the entity itself
+    };
+
+    std::vector<Node> m_nodes; // Indexed by EntityHandle::index
+    std::vector<EntityHandle> m_order;
+
+    [[nodiscard]] static bool is_valid(EntityHandle entity) { return entity.index() != EntityHandle::INVALID_INDEX; }
+
+    [[nodiscard]] Node& node(EntityHandle entity) { return m_nodes[entity.index()]; }
+    [[nodiscard]] const Node& node(EntityHandle entity) const { return m_nodes[entity.index()]; }
+
+    // Unlinks the entity from its parent and siblings, and removes its subtree size from its ancestors
+    void detach(EntityHandle entity);
+    // Links the entity as the last child of parent, and adds its subtree size to its new ancestors
+    void attach(EntityHandle entity, EntityHandle parent);
+
+    void update_positions(uint32_t begin, uint32_t end);
+};
+
+} // namespace Phos
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <cstdint>
 
 namespace Phos {
 
@@ -12,6 +14,10 @@ class Cubemap;
 
 struct RenderingConfig {
     uint32_t shadow_map_resolution = 256;
+    // Hide the renderables behind the occluders of the scene, see MeshRendererComponent::occluder
+    bool occlusion_culling = true;
+    // Draw consecutive sub meshes with the same mesh and material with a single instanced draw
+    bool gpu_instancing = true;
 };
 
 struct BloomConfig {
@@ -29,6 +35,23 @@ struct SceneRendererConfig {
     EnvironmentConfig environment_config{};
 };
 
+/// Counters of the last rendered frame
+struct RendererStatistics {
+    uint32_t renderables = 0;
+    uint32_t visible_renderables = 0;
+    uint32_t visible_sub_meshes = 0;
+    uint32_t occluder_triangles = 0;
+    /// Sub meshes inside of the view frustum but hidden behind occluders
+    uint32_t occluded_sub_meshes = 0;
+    /// Draws and state changes of the shadow mapping and geometry passes
+    uint32_t draw_calls = 0;
+    uint32_t instances = 0;
+    uint32_t material_binds = 0;
+    uint32_t mesh_binds = 0;
+    /// Shadow casters drawn into the shadow map of every directional light
+    std::vector<uint32_t> shadow_casters;
+};
+
 class ISceneRenderer {
   public:
     virtual ~ISceneRenderer() = default;
@@ -40,6 +63,8 @@ class ISceneRenderer {
     virtual void set_scene(std::shared_ptr<Scene> scene) = 0;
 
     virtual void window_resized(uint32_t width, uint32_t height) = 0;
+
+    [[nodiscard]] virtual const RendererStatistics& statistics() const = 0;
 };
 
 } // namespace Phos
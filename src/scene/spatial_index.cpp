@@ -0,0 +1,108 @@
+#include "spatial_index.h"
+
+#include "utility/profiling.h"
+
+namespace Phos {
+
+void SpatialIndex::update(EntityHandle entity, const AABB& world_bounds) {
+    if (entity.index() >= m_entries.size())
+        m_entries.resize(entity.index() + 1);
+
+    auto& entry = m_entries[entity.index()];
+
+    // The index was reused by a new entity without removing the old one
+    if (entry.proxy != DynamicAABBTree::NULL_NODE && entry.version != entity.version()) {
+        m_tree.destroy_proxy(entry.proxy);
+        entry.proxy = DynamicAABBTree::NULL_NODE;
+    }
+
+    if (entry.proxy == DynamicAABBTree::NULL_NODE)
+        entry.proxy = m_tree.create_proxy(world_bounds, static_cast<uint64_t>(entity));
+    else
+        m_tree.move_proxy(entry.proxy, world_bounds);
+
+    entry.version = entity.version();
+    entry.bounds = world_bounds;
+}
+
+void SpatialIndex::remove(EntityHandle entity) {
+    if (!contains(entity))
+        return;
+
+    auto& entry = m_entries[entity.index()];
+    m_tree.destroy_proxy(entry.proxy);
+    entry.proxy = DynamicAABBTree::NULL_NODE;
+}
+
+bool SpatialIndex::contains(EntityHandle entity) const {
+    return entity.index() < m_entries.size() && m_entries[entity.index()].proxy != DynamicAABBTree::NULL_NODE &&
+           m_entries[entity.index()].version == entity.version();
+}
+
+void SpatialIndex::query(const Frustum& frustum, std::vector<EntityHandle>& entities) const {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("SpatialIndex::query");
+
+    // Leaves whose enlarged box crosses a plane, tested with their exact bounds in a single batch
+    std::vector<EntityHandle> candidates;
+    BoundsArrays candidate_bounds;
+
+    m_tree.query(frustum, [&](uint32_t proxy, bool fully_inside) {
+        const auto handle = entity(proxy);
+        if (fully_inside) {
+            entities.push_back(handle);
+            return;
+        }
+
+        candidates.push_back(handle);
+        candidate_bounds.push_back(m_entries[handle.index()].bounds);
+    });
+
+    if (candidates.empty())
+        return;
+
+    VisibilityMask visibility;
+    FrustumCulling::cull(frustum, candidate_bounds, visibility);
+
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (FrustumCulling::is_visible(visibility, i))
+            entities.push_back(candidates[i]);
+    }
+}
+
+void SpatialIndex::query(const AABB& aabb, std::vector<EntityHandle>& entities) const {
+    m_tree.query(aabb, [&](uint32_t proxy) {
+        const auto handle = entity(proxy);
+        const auto& bounds = m_entries[handle.index()].bounds;
+
+        bool overlaps = true;
+        for (int axis = 0; axis < 3; ++axis)
+            overlaps = overlaps && bounds.min[axis] <= aabb.max[axis] && aabb.min[axis] <= bounds.max[axis];
+
+        if (overlaps)
+            entities.push_back(handle);
+        return true;
+    });
+}
+
+std::optional<RaycastHit> SpatialIndex::raycast(const Ray& ray, float max_distance) const {
+    const auto inverse_direction = glm::vec3(1.0f) / ray.direction;
+
+    std::optional<RaycastHit> closest;
+    m_tree.raycast(ray, max_distance, [&](uint32_t proxy, float current_max) {
+        const auto handle = entity(proxy);
+        const auto& bounds = m_entries[handle.index()].bounds;
+
+        // The tree only tested the enlarged box
+        const auto distance = DynamicAABBTree::intersect(ray.origin, inverse_direction, bounds, current_max);
+        if (distance < 0.0f)
+            return current_max;
+
+        // Only hits closer than this one are of interest from now on
+        closest = RaycastHit{.entity = handle, .distance = distance};
+        return distance;
+    });
+
+    return closest;
+}
+
+} // namespace Phos
\ No newline at end of file
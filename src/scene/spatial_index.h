@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <optional>
+
+#include "scene/entity_handle.h"
+#include "scene/dynamic_aabb_tree.h"
+
+namespace Phos {
+
+struct RaycastHit {
+    EntityHandle entity;
+    float distance = 0.0f;
+};
+
+/// World space bounding boxes of the renderable entities of a Scene, kept in a DynamicAABBTree so that visibility,
+/// picking and overlap queries do not need to visit every entity. Kept up to date by SpatialIndexSystem.
+class SpatialIndex {
+  public:
+    SpatialIndex() = default;
+    ~SpatialIndex() = default;
+
+    /// Inserts the entity, or moves it if it was already in the index
+    void update(EntityHandle entity, const AABB& world_bounds);
+    void remove(EntityHandle entity);
+
+    [[nodiscard]] bool contains(EntityHandle entity) const;
+    [[nodiscard]] std::size_t size() const { return m_tree.proxy_count(); }
+    [[nodiscard]] const DynamicAABBTree& tree() const { return m_tree; }
+
+    /// Appends the entities whose bounds are not completely outside of the frustum. Subtrees inside of the frustum
+    /// are accepted without further tests, and the leaves of partially visible subtrees are culled with FrustumCulling.
+    void query(const Frustum& frustum, std::vector<EntityHandle>& entities) const;
+
+    /// Appends the entities whose bounds overlap aabb
+    void query(const AABB& aabb, std::vector<EntityHandle>& entities) const;
+
+    /// Closest entity whose bounds are hit by the ray. ray.direction must be normalized.
+    [[nodiscard]] std::optional<RaycastHit> raycast(const Ray& ray,
+                                                    float max_distance = std::numeric_limits<float>::max()) const;
+
+  private:
+    DynamicAABBTree m_tree;
+
+    struct Entry {
+        uint32_t proxy = DynamicAABBTree::NULL_NODE;
+        uint32_t version = 0;
+        // Exact bounds, the tree stores them enlarged
+        AABB bounds{};
+    };
+    std::vector<Entry> m_entries; // Indexed by EntityHandle::index
+
+    [[nodiscard]] EntityHandle entity(uint32_t proxy) const { return EntityHandle(m_tree.user_data(proxy)); }
+};
+
+} // namespace Phos
@@ -0,0 +1,44 @@
+#include "spatial_index_system.h"
+
+#include "utility/profiling.h"
+
+#include "scene/scene.h"
+#include "renderer/mesh.h"
+#include "renderer/frustum_culling.h"
+
+namespace Phos {
+
+void SpatialIndexSystem::update(Scene& scene) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("SpatialIndexSystem::update");
+
+    const auto since = scene.m_spatial_index_tick;
+    const auto now = scene.advance_tick();
+    scene.m_spatial_index_tick = now;
+
+    auto& registry = *scene.m_registry;
+    auto& index = scene.m_spatial_index;
+
+    const auto update_entity = [&](EntityHandle entity) {
+        if (!registry.has_component<MeshRendererComponent>(entity)) {
+            index.remove(entity);
+            return;
+        }
+
+        const auto& mesh_renderer = registry.get_component<MeshRendererComponent>(entity);
+        if (mesh_renderer.mesh == nullptr) {
+            index.remove(entity);
+            return;
+        }
+
+        const auto& world = registry.get_component<WorldTransformComponent>(entity).world;
+        index.update(entity, FrustumCulling::transform(mesh_renderer.mesh->bounding_box(), world));
+    };
+
+    // An entity changed in both is updated twice, which only costs a second containment test in the tree
+    scene.for_each_changed<WorldTransformComponent>(
+        since, [&](EntityHandle entity, const WorldTransformComponent&) { update_entity(entity); });
+    scene.for_each_changed<MeshRendererComponent>(
+        since, [&](EntityHandle entity, const MeshRendererComponent&) { update_entity(entity); });
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace Phos {
+
+// Forward declarations
+class Scene;
+
+/// Keeps the SpatialIndex of a Scene in sync with the world transforms and meshes of its entities. Only the entities
+/// whose WorldTransformComponent or MeshRendererComponent changed since the last update are moved in the index, so it
+/// must run after TransformSystem::update.
+class SpatialIndexSystem {
+  public:
+    static void update(Scene& scene);
+};
+
+} // namespace Phos
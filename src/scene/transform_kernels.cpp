@@ -0,0 +1,68 @@
+#include "transform_kernels.h"
+
+#include <cmath>
+
+#include "utility/logging.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PHOS_TRANSFORM_KERNELS_X86
+#endif
+
+namespace Phos {
+
+void TransformKernels::compose(const TransformArrays& transforms,
+                               std::span<const glm::mat4* const> parents,
+                               std::span<glm::mat4> local,
+                               std::span<glm::mat4> world) {
+    compose(CpuFeatures::best_simd_backend(), transforms, parents, local, world);
+}
+
+void TransformKernels::compose(SimdBackend backend,
+                               const TransformArrays& transforms,
+                               std::span<const glm::mat4* const> parents,
+                               std::span<glm::mat4> local,
+                               std::span<glm::mat4> world) {
+    PHOS_ASSERT(parents.empty() || parents.size() == transforms.count, "Expected one parent per transform");
+    PHOS_ASSERT(local.size() >= transforms.count && world.size() >= transforms.count,
+                "Output spans are smaller than the number of transforms");
+
+    ComposeFunc func = compose_scalar;
+#ifdef PHOS_TRANSFORM_KERNELS_X86
+    if (backend == SimdBackend::AVX2)
+        func = compose_avx2;
+    else if (backend == SimdBackend::SSE4)
+        func = compose_sse4;
+#else
+    PHOS_ASSERT(backend == SimdBackend::Scalar, "Backend not supported on this architecture");
+#endif
+
+    func(transforms, parents.empty() ? nullptr : parents.data(), local.data(), world.data(), 0, transforms.count);
+}
+
+void TransformKernels::compose_scalar(const TransformArrays& transforms,
+                                      const glm::mat4* const* parents,
+                                      glm::mat4* local,
+                                      glm::mat4* world,
+                                      std::size_t begin,
+                                      std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+        const auto sa = std::sin(transforms.rotation[0][i]), ca = std::cos(transforms.rotation[0][i]);
+        const auto sb = std::sin(transforms.rotation[1][i]), cb = std::cos(transforms.rotation[1][i]);
+        const auto sc = std::sin(transforms.rotation[2][i]), cc = std::cos(transforms.rotation[2][i]);
+
+        const auto sx = transforms.scale[0][i];
+        const auto sy = transforms.scale[1][i];
+        const auto sz = transforms.scale[2][i];
+
+        // R = Rz * Ry * Rx, the same rotation as glm::quat(euler), with every column multiplied by its scale
+        auto& m = local[i];
+        m[0] = glm::vec4(cc * cb * sx, sc * cb * sx, -sb * sx, 0.0f);
+        m[1] = glm::vec4((cc * sb * sa - sc * ca) * sy, (sc * sb * sa + cc * ca) * sy, cb * sa * sy, 0.0f);
+        m[2] = glm::vec4((cc * sb * ca + sc * sa) * sz, (sc * sb * ca - cc * sa) * sz, cb * ca * sz, 0.0f);
+        m[3] = glm::vec4(transforms.position[0][i], transforms.position[1][i], transforms.position[2][i], 1.0f);
+
+        world[i] = (parents != nullptr && parents[i] != nullptr) ? *parents[i] * m : m;
+    }
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+#include "core/cpu_features.h"
+
+namespace Phos {
+
+/// Positions, Euler rotations (radians) and scales of a batch of transforms, stored as separate arrays (x, y, z) of
+/// count elements each
+struct TransformArrays {
+    const float* position[3];
+    const float* rotation[3];
+    const float* scale[3];
+
+    std::size_t count = 0;
+};
+
+/// Batched composition of translation, rotation and scale into matrices, processing 4 (SSE4.1) or 8 (AVX2)
+/// transforms at a time. The backend is selected at runtime from the features of the CPU, with a scalar fallback.
+/// Results match glm::translate * glm::mat4_cast(glm::quat(rotation)) * glm::scale up to float rounding.
+class TransformKernels {
+  public:
+    /// Computes local = T * R * S and world = parent * local for every transform. parents is either empty, meaning
+    /// world = local, or contains count pointers where nullptr means no parent. Parents must not point into world.
+    static void compose(const TransformArrays& transforms,
+                        std::span<const glm::mat4* const> parents,
+                        std::span<glm::mat4> local,
+                        std::span<glm::mat4> world);
+
+    /// Same as compose, with a specific backend. Used to compare backends, the backend must be supported.
+    static void compose(SimdBackend backend,
+                        const TransformArrays& transforms,
+                        std::span<const glm::mat4* const> parents,
+                        std::span<glm::mat4> local,
+                        std::span<glm::mat4> world);
+
+  private:
+    // Each backend processes the transforms in [begin, end), and is defined in its own translation unit so that it
+    // can be compiled with the matching instruction set
+    using ComposeFunc = void (*)(const TransformArrays&,
+                                 const glm::mat4* const*,
+                                 glm::mat4*,
+                                 glm::mat4*,
+                                 std::size_t begin,
+                                 std::size_t end);
+
+    static void compose_scalar(const TransformArrays& transforms,
+                               const glm::mat4* const* parents,
+                               glm::mat4* local,
+                               glm::mat4* world,
+                               std::size_t begin,
+                               std::size_t end);
+    static void compose_sse4(const TransformArrays& transforms,
+                             const glm::mat4* const* parents,
+                             glm::mat4* local,
+                             glm::mat4* world,
+                             std::size_t begin,
+                             std::size_t end);
+    static void compose_avx2(const TransformArrays& transforms,
+                             const glm::mat4* const* parents,
+                             glm::mat4* local,
+                             glm::mat4* world,
+                             std::size_t begin,
+                             std::size_t end);
+};
+
+} // namespace Phos
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "scene/transform_kernels.h"
+
+// Shared implementation of the SIMD transform kernels. It is included by the translation unit of every instruction
+// set, which provides a Simd type with the operations used below, so the code is compiled once per instruction set.
+// Only meant to be included by transform_kernels_*.cpp. Matrices are accessed as 16 column-major floats instead of
+// through glm, so that no inline glm function is compiled with a wider instruction set than the rest of the engine.
+
+namespace Phos::TransformKernelsSimd {
+
+constexpr float IDENTITY[16] = {
+    1.0f, 0.0f, 0.0f, 0.0f, //
+    0.0f, 1.0f, 0.0f, 0.0f, //
+    0.0f, 0.0f, 1.0f, 0.0f, //
+    0.0f, 0.0f, 0.0f, 1.0f, //
+};
+
+inline float* column_ptr(glm::mat4* matrix, int column) {
+    return reinterpret_cast<float*>(matrix) + column * 4;
+}
+
+inline const float* column_ptr(const glm::mat4* matrix, int column) {
+    return reinterpret_cast<const float*>(matrix) + column * 4;
+}
+
+/// Sine and cosine of every lane, using the Cephes single precision polynomials after reducing the angle to
+/// [-pi/4, pi/4]. Accurate to a couple of ulps for the angle ranges of Euler rotations.
+template <typename Simd>
+inline void sincos(typename Simd::Float x, typename Simd::Float& out_sin, typename Simd::Float& out_cos) {
+    using Float = typename Simd::Float;
+    using Int = typename Simd::Int;
+
+    const Float sign_mask = Simd::set1(-0.0f);
+
+    Float sign_sin = Simd::bit_and(x, sign_mask);
+    x = Simd::bit_andnot(sign_mask, x);
+
+    // Octant of the angle, rounded to an even value
+    Int octant = Simd::to_int(Simd::mul(x, Simd::set1(1.27323954473516f))); // 4 / pi
+    octant = Simd::iand(Simd::iadd(octant, Simd::iset1(1)), Simd::iset1(~1));
+    const Float y = Simd::to_float(octant);
+
+    const Int swap_sign_sin = Simd::template shift_left<29>(Simd::iand(octant, Simd::iset1(4)));
+    const Int sign_cos = Simd::template shift_left<29>(Simd::iandnot(Simd::isub(octant, Simd::iset1(2)), Simd::iset1(4)));
+    const Float use_sin_poly = Simd::as_float(Simd::icmpeq(Simd::iand(octant, Simd::iset1(2)), Simd::iset1(0)));
+
+    // Extended precision modular arithmetic, x - y * pi / 4
+    x = Simd::sub(x, Simd::mul(y, Simd::set1(0.78515625f)));
+    x = Simd::sub(x, Simd::mul(y, Simd::set1(2.4187564849853515625e-4f)));
+    x = Simd::sub(x, Simd::mul(y, Simd::set1(3.77489497744594108e-8f)));
+
+    sign_sin = Simd::bit_xor(sign_sin, Simd::as_float(swap_sign_sin));
+
+    const Float z = Simd::mul(x, x);
+
+    Float cos_poly = Simd::fmadd(Simd::set1(2.443315711809948e-5f), z, Simd::set1(-1.388731625493765e-3f));
+    cos_poly = Simd::fmadd(cos_poly, z, Simd::set1(4.166664568298827e-2f));
+    cos_poly = Simd::mul(Simd::mul(cos_poly, z), z);
+    cos_poly = Simd::fmadd(Simd::set1(-0.5f), z, cos_poly);
+    cos_poly = Simd::add(cos_poly, Simd::set1(1.0f));
+
+    Float sin_poly = Simd::fmadd(Simd::set1(-1.9515295891e-4f), z, Simd::set1(8.3321608736e-3f));
+    sin_poly = Simd::fmadd(sin_poly, z, Simd::set1(-1.6666654611e-1f));
+    sin_poly = Simd::fmadd(Simd::mul(sin_poly, z), x, x);
+
+    out_sin = Simd::bit_xor(Simd::blend(cos_poly, sin_poly, use_sin_poly), sign_sin);
+    out_cos = Simd::bit_xor(Simd::blend(sin_poly, cos_poly, use_sin_poly), Simd::as_float(sign_cos));
+}
+
+/// Composes the transforms in [begin, end) Simd::WIDTH at a time, and returns the index of the first transform that
+/// was not processed because it did not fill a whole batch
+template <typename Simd>
+inline std::size_t compose(const TransformArrays& transforms,
+                           const glm::mat4* const* parents,
+                           glm::mat4* local,
+                           glm::mat4* world,
+                           std::size_t begin,
+                           std::size_t end) {
+    using Float = typename Simd::Float;
+    constexpr auto WIDTH = Simd::WIDTH;
+
+    const Float zero = Simd::set1(0.0f);
+    const Float one = Simd::set1(1.0f);
+
+    auto i = begin;
+    for (; i + WIDTH <= end; i += WIDTH) {
+        const Float px = Simd::load(transforms.position[0] + i);
+        const Float py = Simd::load(transforms.position[1] + i);
+        const Float pz = Simd::load(transforms.position[2] + i);
+
+        const Float sx = Simd::load(transforms.scale[0] + i);
+        const Float sy = Simd::load(transforms.scale[1] + i);
+        const Float sz = Simd::load(transforms.scale[2] + i);
+
+        Float sa, ca, sb, cb, sc, cc;
+        sincos<Simd>(Simd::load(transforms.rotation[0] + i), sa, ca);
+        sincos<Simd>(Simd::load(transforms.rotation[1] + i), sb, cb);
+        sincos<Simd>(Simd::load(transforms.rotation[2] + i), sc, cc);
+
+        // R = Rz * Ry * Rx, with every column multiplied by its scale
+        const Float sb_sa = Simd::mul(sb, sa);
+        const Float sb_ca = Simd::mul(sb, ca);
+
+        // Local matrix columns, L[column][row]
+        Float l[3][3];
+        l[0][0] = Simd::mul(Simd::mul(cc, cb), sx);
+        l[0][1] = Simd::mul(Simd::mul(sc, cb), sx);
+        l[0][2] = Simd::mul(Simd::sub(zero, sb), sx);
+
+        l[1][0] = Simd::mul(Simd::sub(Simd::mul(cc, sb_sa), Simd::mul(sc, ca)), sy);
+        l[1][1] = Simd::mul(Simd::fmadd(sc, sb_sa, Simd::mul(cc, ca)), sy);
+        l[1][2] = Simd::mul(Simd::mul(cb, sa), sy);
+
+        l[2][0] = Simd::mul(Simd::fmadd(cc, sb_ca, Simd::mul(sc, sa)), sz);
+        l[2][1] = Simd::mul(Simd::sub(Simd::mul(sc, sb_ca), Simd::mul(cc, sa)), sz);
+        l[2][2] = Simd::mul(Simd::mul(cb, ca), sz);
+
+        float* lanes[WIDTH];
+        const auto store_column = [&](glm::mat4* matrices, int column, Float x, Float y, Float z, Float w) {
+            for (std::size_t lane = 0; lane < WIDTH; ++lane)
+                lanes[lane] = column_ptr(matrices + i + lane, column);
+            Simd::scatter_transposed(lanes, x, y, z, w);
+        };
+
+        for (int column = 0; column < 3; ++column)
+            store_column(local, column, l[column][0], l[column][1], l[column][2], zero);
+        store_column(local, 3, px, py, pz, one);
+
+        if (parents == nullptr) {
+            for (int column = 0; column < 3; ++column)
+                store_column(world, column, l[column][0], l[column][1], l[column][2], zero);
+            store_column(world, 3, px, py, pz, one);
+            continue;
+        }
+
+        // Parent matrix columns, P[column][row]
+        Float p[4][4];
+        const float* parent_lanes[WIDTH];
+        for (int column = 0; column < 4; ++column) {
+            for (std::size_t lane = 0; lane < WIDTH; ++lane) {
+                const auto* parent = parents[i + lane];
+                parent_lanes[lane] = parent != nullptr ? column_ptr(parent, column) : IDENTITY + column * 4;
+            }
+            Simd::gather_transposed(parent_lanes, p[column][0], p[column][1], p[column][2], p[column][3]);
+        }
+
+        // World = P * L, where the last row of L is (0, 0, 0, 1)
+        for (int column = 0; column < 3; ++column) {
+            Float w[4];
+            for (int row = 0; row < 4; ++row) {
+                w[row] = Simd::mul(p[0][row], l[column][0]);
+                w[row] = Simd::fmadd(p[1][row], l[column][1], w[row]);
+                w[row] = Simd::fmadd(p[2][row], l[column][2], w[row]);
+            }
+            store_column(world, column, w[0], w[1], w[2], w[3]);
+        }
+
+        Float w[4];
+        for (int row = 0; row < 4; ++row) {
+            w[row] = Simd::fmadd(p[0][row], px, p[3][row]);
+            w[row] = Simd::fmadd(p[1][row], py, w[row]);
+            w[row] = Simd::fmadd(p[2][row], pz, w[row]);
+        }
+        store_column(world, 3, w[0], w[1], w[2], w[3]);
+    }
+
+    return i;
+}
+
+} // namespace Phos::TransformKernelsSimd
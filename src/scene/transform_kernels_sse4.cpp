@@ -0,0 +1,22 @@
+#include "transform_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include "utility/simd.h"
+#include "scene/transform_kernels_simd.h"
+
+namespace Phos {
+
+void TransformKernels::compose_sse4(const TransformArrays& transforms,
+                                    const glm::mat4* const* parents,
+                                    glm::mat4* local,
+                                    glm::mat4* world,
+                                    std::size_t begin,
+                                    std::size_t end) {
+    const auto remaining = TransformKernelsSimd::compose<SimdSse4>(transforms, parents, local, world, begin, end);
+    compose_scalar(transforms, parents, local, world, remaining, end);
+}
+
+} // namespace Phos
+
+#endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "transform_system.h"
+
+#include <array>
+#include <algorithm>
+
+#include "utility/profiling.h"
+
+#include "scene/scene.h"
+#include "scene/transform_kernels.h"
+
+namespace Phos {
+
+void TransformSystem::update(Scene& scene) {
+    PHOS_PROFILE_ZONE_SCOPED_NAMED("TransformSystem::update");
+
+    // Changes made from now on get a tick greater than now, and are picked up by the next update
+    const auto since = scene.m_world_transform_tick;
+    const auto now = scene.advance_tick();
+    scene.m_world_transform_tick = now;
+
+    const auto& hierarchy = scene.m_hierarchy;
+    auto& registry = *scene.m_registry;
+
+    // Positions in the depth-first order of the entities with a changed transform
+    std::vector<uint32_t> dirty_positions;
+    scene.for_each_changed<TransformComponent>(since, [&](EntityHandle entity, const TransformComponent&) {
+        dirty_positions.push_back(hierarchy.position(entity));
+    });
+
+    if (dirty_positions.empty())
+        return;
+
+    std::ranges::sort(dirty_positions);
+
+    // Every subtree is a contiguous range that follows its root, so sweeping the dirty ranges in order visits parents
+    // before their children, and skips the dirty entities already covered by the subtree of a dirty ancestor.
+    // The entities are bucketed by their depth inside the range, so that every level can be composed in one batch
+    // once the level above has been written.
+    const auto order = hierarchy.order();
+    std::vector<std::vector<EntityHandle>> levels;
+    std::vector<uint32_t> depths;
+    uint32_t end = 0;
+
+    for (const auto begin : dirty_positions) {
+        if (begin < end)
+            continue;
+
+        end = begin + static_cast<uint32_t>(hierarchy.subtree(order[begin]).size());
+        depths.resize(end - begin);
+
+        for (auto position = begin; position < end; ++position) {
+            const auto entity = order[position];
+            const auto depth = position == begin ? 0 : depths[hierarchy.position(hierarchy.parent(entity)) - begin] + 1;
+            depths[position - begin] = depth;
+
+            if (depth >= levels.size())
+                levels.resize(depth + 1);
+            levels[depth].push_back(entity);
+        }
+    }
+
+    std::array<std::vector<float>, 9> soa;
+    std::vector<const glm::mat4*> parents;
+    std::vector<glm::mat4> local, world;
+
+    for (const auto& level : levels) {
+        const auto count = level.size();
+
+        for (auto& array : soa)
+            array.resize(count);
+        parents.resize(count);
+        local.resize(count);
+        world.resize(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& transform = registry.get_component<TransformComponent>(level[i]);
+            for (int axis = 0; axis < 3; ++axis) {
+                soa[axis][i] = transform.position[axis];
+                soa[3 + axis][i] = transform.rotation[axis];
+                soa[6 + axis][i] = transform.scale[axis];
+            }
+
+            // Parents are either outside of the dirty ranges or in the previous level, so their world is up to date
+            parents[i] = hierarchy.has_parent(level[i])
+                             ? &registry.get_component<WorldTransformComponent>(hierarchy.parent(level[i])).world
+                             : nullptr;
+        }
+
+        const TransformArrays arrays{
+            .position = {soa[0].data(), soa[1].data(), soa[2].data()},
+            .rotation = {soa[3].data(), soa[4].data(), soa[5].data()},
+            .scale = {soa[6].data(), soa[7].data(), soa[8].data()},
+            .count = count,
+        };
+        TransformKernels::compose(arrays, parents, local, world);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto& world_transform = registry.get_component<WorldTransformComponent>(level[i]);
+            world_transform.local = local[i];
+            world_transform.world = world[i];
+
+            registry.mark_changed<WorldTransformComponent>(level[i]);
+        }
+    }
+}
+
+} // namespace Phos
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Phos {
+
+// Forward declarations
+class Scene;
+
+/// Keeps the WorldTransformComponent of every entity in sync with its TransformComponent and hierarchy.
+/// Only the subtrees whose root had its transform changed since the last update are recomputed, sweeping the dense
+/// depth-first order of the SceneHierarchy so that parents are resolved before their children. The recomputed entities
+/// are composed one hierarchy level at a time with TransformKernels. Reparenting an entity marks its transform as
+/// changed.
+class TransformSystem {
+  public:
+    /// Propagates the changes made since the previous call. Meant to be called once per frame, before reading
+    /// world transforms.
+    static void update(Scene& scene);
+};
+
+} // namespace Phos
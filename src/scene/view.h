@@ -0,0 +1,248 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <tuple>
+#include <vector>
+#include <ranges>
+#include <iterator>
+
+#include "core/job_system.h"
+#include "scene/component_array.h"
+#include "scene/archetype_storage.h"
+
+namespace Phos {
+
+/// Lazy range over the entities that have all the given components.
+/// With sparse set storage, iteration is driven by the smallest of the component arrays, the rest are only used for
+/// membership tests. With archetype storage, the chunks of every matching archetype are walked linearly.
+/// Dereferencing yields a (entity, Components&...) tuple, so no Entity objects or containers are created.
+template <typename... Components>
+class View {
+  public:
+    using Pools = std::tuple<ComponentArray<Components>*...>;
+    using ColumnOffsets = std::array<std::size_t, sizeof...(Components)>;
+
+    class Iterator {
+      public:
+        using value_type = std::tuple<EntityHandle, Components&...>;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator() = default;
+        Iterator(std::span<const EntityHandle> entities, Pools pools, std::size_t idx)
+              : m_entities(entities), m_pools(pools), m_idx(idx) {
+            skip_missing();
+        }
+
+        Iterator(const ArchetypeStorage* storage, std::size_t archetype_idx)
+              : m_storage(storage), m_idx(archetype_idx) {
+            find_archetype();
+        }
+
+        [[nodiscard]] reference operator*() const {
+            if (m_storage != nullptr)
+                return dereference_chunk(std::index_sequence_for<Components...>{});
+
+            const auto entity = m_entities[m_idx];
+            return std::apply([&](auto*... pools) { return value_type(entity, pools->get_data(entity)...); }, m_pools);
+        }
+
+        Iterator& operator++() {
+            if (m_storage != nullptr) {
+                if (++m_row == m_chunk_rows)
+                    next_chunk();
+                return *this;
+            }
+
+            ++m_idx;
+            skip_missing();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return m_idx == other.m_idx && m_chunk_idx == other.m_chunk_idx && m_row == other.m_row;
+        }
+
+      private:
+        // Sparse set storage
+        std::span<const EntityHandle> m_entities;
+        Pools m_pools{};
+
+        // Archetype storage, m_idx is the index of the current archetype
+        const ArchetypeStorage* m_storage = nullptr;
+        ColumnOffsets m_offsets{};
+        std::byte* m_chunk = nullptr;
+        std::size_t m_chunk_idx = 0;
+        uint32_t m_chunk_rows = 0;
+        uint32_t m_row = 0;
+
+        std::size_t m_idx = 0;
+
+        void skip_missing() {
+            if constexpr (sizeof...(Components) > 1) {
+                while (m_idx < m_entities.size() && !contains_all(m_pools, m_entities[m_idx]))
+                    ++m_idx;
+            }
+        }
+
+        template <std::size_t... I>
+        [[nodiscard]] reference dereference_chunk(std::index_sequence<I...>) const {
+            return value_type(reinterpret_cast<const EntityHandle*>(m_chunk)[m_row],
+                              reinterpret_cast<Components*>(m_chunk + m_offsets[I])[m_row]...);
+        }
+
+        // Advances to the first non empty archetype, starting at m_idx, that has all the components
+        void find_archetype() {
+            const auto& archetypes = m_storage->archetypes();
+            for (; m_idx < archetypes.size(); ++m_idx) {
+                const auto& archetype = *archetypes[m_idx];
+                if (archetype.size() == 0 || !(archetype.contains(ComponentType::id<Components>()) && ...))
+                    continue;
+
+                m_offsets = {archetype.column_offset(ComponentType::id<Components>())...};
+                m_chunk_idx = 0;
+                load_chunk(archetype);
+                return;
+            }
+
+            m_chunk_idx = 0;
+            m_row = 0;
+        }
+
+        void next_chunk() {
+            const auto& archetype = *m_storage->archetypes()[m_idx];
+            if (++m_chunk_idx < archetype.number_chunks()) {
+                load_chunk(archetype);
+                return;
+            }
+
+            ++m_idx;
+            find_archetype();
+        }
+
+        void load_chunk(const Archetype& archetype) {
+            m_chunk = archetype.chunk(m_chunk_idx);
+            m_chunk_rows = archetype.chunk_size(m_chunk_idx);
+            m_row = 0;
+        }
+    };
+
+    explicit View(ComponentArray<Components>*... pools) : m_pools(pools...) {
+        // If any of the components has not been registered, no entity can have all of them
+        if (((pools == nullptr) || ...))
+            return;
+
+        bool first = true;
+        const auto select_smallest = [&](const auto* pool) {
+            if (first || pool->size() < m_entities.size())
+                m_entities = pool->entities();
+            first = false;
+        };
+        (select_smallest(pools), ...);
+    }
+
+    explicit View(const ArchetypeStorage* storage) : m_storage(storage) {}
+
+    [[nodiscard]] Iterator begin() const {
+        if (m_storage != nullptr)
+            return Iterator(m_storage, 0);
+        return Iterator(m_entities, m_pools, 0);
+    }
+
+    [[nodiscard]] Iterator end() const {
+        if (m_storage != nullptr)
+            return Iterator(m_storage, m_storage->archetypes().size());
+        return Iterator(m_entities, m_pools, m_entities.size());
+    }
+
+    [[nodiscard]] bool contains(EntityHandle entity) const {
+        if (m_storage != nullptr)
+            return (m_storage->has_component<Components>(entity) && ...);
+        return !m_entities.empty() && contains_all(m_pools, entity);
+    }
+
+    /// Upper bound on the number of entities the view will yield. With sparse set storage it is the size of the
+    /// smallest component array, with archetype storage it is exact.
+    [[nodiscard]] std::size_t size_hint() const {
+        if (m_storage == nullptr)
+            return m_entities.size();
+
+        std::size_t size = 0;
+        for (const auto& archetype : m_storage->archetypes()) {
+            if ((archetype->contains(ComponentType::id<Components>()) && ...))
+                size += archetype->size();
+        }
+        return size;
+    }
+
+    /// Calls func(entity, components&...) for every entity in the view, splitting the entities across the job system
+    /// workers in batches of at least grain_size entities (whole chunks with archetype storage). Blocks until done.
+    /// func can run concurrently and must not create or destroy entities, nor add or remove components.
+    template <typename Func>
+    void parallel_for_each(Func&& func, std::size_t grain_size = 256) const {
+        if (m_storage != nullptr) {
+            std::vector<std::pair<const Archetype*, std::size_t>> chunks;
+            for (const auto& archetype : m_storage->archetypes()) {
+                if (!(archetype->contains(ComponentType::id<Components>()) && ...))
+                    continue;
+
+                for (std::size_t chunk_idx = 0; chunk_idx < archetype->number_chunks(); ++chunk_idx)
+                    chunks.emplace_back(archetype.get(), chunk_idx);
+            }
+
+            JobSystem::parallel_for(chunks.size(), 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                    for_each_in_chunk(*chunks[i].first, chunks[i].second, func);
+            });
+            return;
+        }
+
+        JobSystem::parallel_for(m_entities.size(), grain_size, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto entity = m_entities[i];
+                if constexpr (sizeof...(Components) > 1) {
+                    if (!contains_all(m_pools, entity))
+                        continue;
+                }
+
+                std::apply([&](auto*... pools) { func(entity, pools->get_data(entity)...); }, m_pools);
+            }
+        });
+    }
+
+  private:
+    std::span<const EntityHandle> m_entities;
+    Pools m_pools{};
+
+    const ArchetypeStorage* m_storage = nullptr;
+
+    template <typename Func>
+    static void for_each_in_chunk(const Archetype& archetype, std::size_t chunk_idx, Func& func) {
+        auto* chunk = archetype.chunk(chunk_idx);
+        const auto* entities = reinterpret_cast<const EntityHandle*>(chunk);
+        const auto rows = archetype.chunk_size(chunk_idx);
+
+        const auto columns = std::make_tuple(
+            reinterpret_cast<Components*>(chunk + archetype.column_offset(ComponentType::id<Components>()))...);
+
+        for (uint32_t row = 0; row < rows; ++row)
+            std::apply([&](auto*... column) { func(entities[row], column[row]...); }, columns);
+    }
+
+    static bool contains_all(const Pools& pools, EntityHandle entity) {
+        return std::apply([&](const auto*... p) { return (p->entity_has_component(entity) && ...); }, pools);
+    }
+};
+
+} // namespace Phos
+
+template <typename... Components>
+inline constexpr bool std::ranges::enable_borrowed_range<Phos::View<Components...>> = true;
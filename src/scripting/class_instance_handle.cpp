@@ -27,13 +27,13 @@ ClassInstanceHandle::ClassInstanceHandle(std::shared_ptr<ClassHandle> class_hand
     m_on_update_method = *m_class_handle->get_method("OnUpdate", 1);
 }
 
-void ClassInstanceHandle::invoke_constructor(const UUID& entity_id) {
+void ClassInstanceHandle::invoke_constructor(EntityHandle entity) {
     PHOS_ASSERT(!m_constructed,
                 "Class's instance for class '{}' constructor has already been called",
                 m_class_handle->class_name());
 
     void* args[1];
-    auto id = static_cast<uint64_t>(entity_id);
+    auto id = static_cast<uint64_t>(entity);
     args[0] = &id;
 
     mono_runtime_invoke(m_constructor, m_instance, args, nullptr);
@@ -104,10 +104,11 @@ SET_FIELD_VALUE_INTERNAL_FUNC(PrefabRef) {
     mono_field_set_value(m_instance, info.field, &prefab_id);
 }
 
-SET_FIELD_VALUE_INTERNAL_FUNC(EntityRef) {
+SET_FIELD_VALUE_INTERNAL_FUNC(EntityHandle) {
     check_type(info, ClassField::Type::Entity, "entity");
 
-    auto entity_id = static_cast<uint64_t>(value->id);
+    // Scripts address entities by their runtime handle
+    auto entity_id = static_cast<uint64_t>(*value);
     mono_field_set_value(m_instance, info.field, &entity_id);
 }
 
@@ -3,6 +3,7 @@
 #include <mono/jit/jit.h>
 #include "utility/logging.h"
 #include "scripting/class_handle.h"
+#include "scene/entity_handle.h"
 
 namespace Phos {
 
@@ -11,7 +12,7 @@ class ClassInstanceHandle {
     [[nodiscard]] static std::shared_ptr<ClassInstanceHandle> instantiate(std::shared_ptr<ClassHandle> class_handle);
     ~ClassInstanceHandle() = default;
 
-    void invoke_constructor(const UUID& entity_id);
+    void invoke_constructor(EntityHandle entity);
     void invoke_on_create();
     void invoke_on_update(double delta_time);
 
@@ -1,12 +1,15 @@
 #include "script_glue.h"
 
 #include <mono/jit/jit.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include "asset/asset_manager.h"
 #include "asset/prefab_loader.h"
 #include "asset/prefab_asset.h"
 
 #include "scene/scene.h"
+#include "scene/entity_command_buffer.h"
 
 #include "input/input.h"
 
@@ -19,8 +22,7 @@ namespace Phos {
 static std::shared_ptr<Scene> s_scene;
 static std::shared_ptr<AssetManagerBase> s_asset_manager;
 
-static std::function<void(const Entity&)> s_entity_instantiated_callback_func;
-static std::function<void(const Entity&)> s_entity_destroyed_callback_func;
+static std::shared_ptr<EntityCommandBuffer> s_command_buffer;
 
 void ScriptGlue::initialize() {
     ADD_INTERNAL_CALL(Logging_Info);
@@ -41,11 +43,15 @@ void ScriptGlue::initialize() {
     ADD_INTERNAL_CALL(TransformComponent_SetRotation);
     ADD_INTERNAL_CALL(TransformComponent_GetScale);
     ADD_INTERNAL_CALL(TransformComponent_SetScale);
+    ADD_INTERNAL_CALL(TransformComponent_GetWorldPosition);
+
+    ADD_INTERNAL_CALL(Physics_Raycast);
 }
 
 void ScriptGlue::shutdown() {
     s_scene = nullptr;
     s_asset_manager = nullptr;
+    s_command_buffer = nullptr;
 }
 
 void ScriptGlue::set_scene(std::shared_ptr<Scene> scene) {
@@ -56,12 +62,8 @@ void ScriptGlue::set_asset_manager(std::shared_ptr<AssetManagerBase> asset_manag
     s_asset_manager = std::move(asset_manager);
 }
 
-void ScriptGlue::set_entity_instantiated_callback(const std::function<void(const Entity&)>& func) {
-    s_entity_instantiated_callback_func = func;
-}
-
-void ScriptGlue::set_entity_destroyed_callback(const std::function<void(const Entity&)>& func) {
-    s_entity_destroyed_callback_func = func;
+void ScriptGlue::set_command_buffer(std::shared_ptr<EntityCommandBuffer> command_buffer) {
+    s_command_buffer = std::move(command_buffer);
 }
 
 //
@@ -87,15 +89,12 @@ void ScriptGlue::Entity_Instantiate(uint64_t prefab_asset_id, uint64_t* id) {
         return;
     }
 
-    const auto entity = PrefabLoader::load(*prefab_asset, s_scene, s_asset_manager);
-    s_entity_instantiated_callback_func(entity);
-    *id = static_cast<uint64_t>(entity.uuid());
+    const auto entity = PrefabLoader::load(*prefab_asset, *s_command_buffer, s_asset_manager);
+    *id = static_cast<uint64_t>(entity);
 }
 
 void ScriptGlue::Entity_Destroy(uint64_t id) {
-    const auto entity = s_scene->get_entity_with_uuid(Phos::UUID(id));
-    s_entity_destroyed_callback_func(entity);
-    s_scene->destroy_entity(entity);
+    s_command_buffer->destroy(EntityHandle(id));
 }
 
 void ScriptGlue::Input_IsKeyDown(uint32_t key, bool* is_down) {
@@ -116,34 +115,93 @@ void ScriptGlue::Input_VerticalAxisChange(float* out) {
     *out = Input::vertical_axis_change();
 }
 
+// Entities instantiated in the current frame only exist in the command buffer until it is flushed
+static const TransformComponent& get_transform(uint64_t id) {
+    const auto entity = EntityHandle(id);
+    if (const auto* pending = s_command_buffer->find_pending_component<TransformComponent>(entity))
+        return *pending;
+
+    return s_scene->get_entity(entity).get_component<TransformComponent>();
+}
+
+template <typename Func>
+static void patch_transform(uint64_t id, Func&& func) {
+    const auto entity = EntityHandle(id);
+    if (auto* pending = s_command_buffer->find_pending_component<TransformComponent>(entity)) {
+        func(*pending);
+        return;
+    }
+
+    s_scene->get_entity(entity).patch<TransformComponent>(std::forward<Func>(func));
+}
+
 void ScriptGlue::TransformComponent_GetPosition(uint64_t id, glm::vec3* out) {
-    const auto entity = s_scene->get_entity_with_uuid(Phos::UUID(id));
-    *out = entity.get_component<TransformComponent>().position;
+    *out = get_transform(id).position;
 }
 
 void ScriptGlue::TransformComponent_SetPosition(uint64_t id, glm::vec3* value) {
-    const auto entity = s_scene->get_entity_with_uuid(Phos::UUID(id));
-    entity.get_component<TransformComponent>().position = *value;
+    patch_transform(id, [&](TransformComponent& transform) { transform.position = *value; });
 }
 
 void ScriptGlue::TransformComponent_GetRotation(uint64_t id, glm::vec3* out) {
-    const auto entity = s_scene->get_entity_with_uuid(Phos::UUID(id));
-    *out = glm::degrees(entity.get_component<TransformComponent>().rotation);
+    *out = glm::degrees(get_transform(id).rotation);
 }
 
 void ScriptGlue::TransformComponent_SetRotation(uint64_t id, glm::vec3* value) {
-    const auto entity = s_scene->get_entity_with_uuid(Phos::UUID(id));
-    entity.get_component<TransformComponent>().rotation = glm::radians(*value);
+    patch_transform(id, [&](TransformComponent& transform) { transform.rotation = glm::radians(*value); });
 }
 
 void ScriptGlue::TransformComponent_GetScale(uint64_t id, glm::vec3* out) {
-    const auto entity = s_scene->get_entity_with_uuid(Phos::UUID(id));
-    *out = entity.get_component<TransformComponent>().scale;
+    *out = get_transform(id).scale;
 }
 
 void ScriptGlue::TransformComponent_SetScale(uint64_t id, glm::vec3* value) {
-    const auto entity = s_scene->get_entity_with_uuid(Phos::UUID(id));
-    entity.get_component<TransformComponent>().scale = *value;
+    patch_transform(id, [&](TransformComponent& transform) { transform.scale = *value; });
+}
+
+// World transforms are resolved by the TransformSystem once per frame, so changes made in the current frame are not
+// visible until the next one. Pending transforms (entities instantiated in this frame) have no world transform yet,
+// theirs is composed with the world transform of their parent, set by a pending command or already in the scene.
+static glm::mat4 get_world_transform(EntityHandle entity) {
+    const auto* pending = s_command_buffer->find_pending_component<TransformComponent>(entity);
+    if (pending == nullptr)
+        return s_scene->get_entity(entity).get_component<WorldTransformComponent>().world;
+
+    const auto local = glm::translate(glm::mat4(1.0f), pending->position) *
+                       glm::mat4_cast(glm::quat(pending->rotation)) * glm::scale(glm::mat4(1.0f), pending->scale);
+
+    auto parent = s_command_buffer->find_pending_parent(entity);
+    if (!parent.has_value() && s_scene->valid(entity)) {
+        if (const auto scene_parent = s_scene->get_entity(entity).parent())
+            parent = scene_parent->id();
+    }
+
+    return parent.has_value() ? get_world_transform(*parent) * local : local;
+}
+
+void ScriptGlue::TransformComponent_GetWorldPosition(uint64_t id, glm::vec3* out) {
+    *out = glm::vec3(get_world_transform(EntityHandle(id))[3]);
+}
+
+// Hits are tested against the world space bounding boxes of the meshes, as of the start of the frame
+void ScriptGlue::Physics_Raycast(glm::vec3* origin,
+                                 glm::vec3* direction,
+                                 float max_distance,
+                                 bool* hit,
+                                 uint64_t* id,
+                                 float* distance) {
+    *hit = false;
+    if (glm::length(*direction) == 0.0f)
+        return;
+
+    const auto ray = Ray{.origin = *origin, .direction = glm::normalize(*direction)};
+    const auto result = s_scene->spatial_index().raycast(ray, max_distance);
+    if (!result.has_value())
+        return;
+
+    *hit = true;
+    *id = static_cast<uint64_t>(result->entity);
+    *distance = result->distance;
 }
 
 } // namespace Phos
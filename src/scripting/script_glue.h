@@ -11,7 +11,7 @@ namespace Phos {
 // Forward declarations
 class Scene;
 class AssetManagerBase;
-class Entity;
+class EntityCommandBuffer;
 
 class ScriptGlue {
   public:
@@ -21,8 +21,9 @@ class ScriptGlue {
     static void set_scene(std::shared_ptr<Scene> scene);
     static void set_asset_manager(std::shared_ptr<AssetManagerBase> asset_manager);
 
-    static void set_entity_instantiated_callback(const std::function<void(const Entity&)>& func);
-    static void set_entity_destroyed_callback(const std::function<void(const Entity&)>& func);
+    /// Entities instantiated or destroyed by scripts are recorded in the command buffer, the owner of the scene
+    /// flushes it once scripts have finished updating
+    static void set_command_buffer(std::shared_ptr<EntityCommandBuffer> command_buffer);
 
   private:
     // region Logging
@@ -60,6 +61,19 @@ class ScriptGlue {
     static void TransformComponent_GetScale(uint64_t id, glm::vec3* out);
     static void TransformComponent_SetScale(uint64_t id, glm::vec3* value);
 
+    static void TransformComponent_GetWorldPosition(uint64_t id, glm::vec3* out);
+
+    // endregion
+
+    // region Physics
+
+    static void Physics_Raycast(glm::vec3* origin,
+                                glm::vec3* direction,
+                                float max_distance,
+                                bool* hit,
+                                uint64_t* id,
+                                float* distance);
+
     // endregion
 };
 
@@ -5,6 +5,9 @@
 #include "asset/asset_manager.h"
 
 #include "scene/scene.h"
+#include "scene/entity_command_buffer.h"
+#include "scene/transform_system.h"
+#include "scene/spatial_index_system.h"
 
 #include "scripting/scripting_engine.h"
 #include "scripting/script_glue.h"
@@ -17,24 +20,18 @@ ScriptingSystem::ScriptingSystem(std::shared_ptr<Project> project) : m_project(s
 
     ScriptingEngine::set_dll_path(m_dll_path);
     ScriptGlue::set_asset_manager(m_project->asset_manager());
-
-    ScriptGlue::set_entity_instantiated_callback([&](const Entity& entity) {
-        if (entity.has_component<ScriptComponent>() && !m_entity_script_instance.contains(entity.uuid())) {
-            m_entity_script_instance[entity.uuid()] = create_entity_instance(entity);
-        }
-    });
-
-    ScriptGlue::set_entity_destroyed_callback([&](const Entity& entity) {
-        if (entity.has_component<ScriptComponent>()) {
-            m_entity_script_instance.erase(entity.uuid());
-        }
-    });
 }
 
 void ScriptingSystem::on_update(double ts) {
+    // Scripts read the world transforms and spatial index resolved by the renderer in the previous frame, which runs
+    // the TransformSystem once per frame, after the commands of the scripts have been flushed.
+
+    // Scripts only record structural changes, so the instances can not change while iterating them
     for (const auto& [entity_id, instance] : m_entity_script_instance) {
         instance->invoke_on_update(ts);
     }
+
+    flush_commands();
 }
 
 void ScriptingSystem::start(std::shared_ptr<Scene> scene) {
@@ -44,16 +41,64 @@ void ScriptingSystem::start(std::shared_ptr<Scene> scene) {
     m_scene_copy = std::move(scene);
     ScriptGlue::set_scene(m_scene_copy);
 
+    m_command_buffer = std::make_shared<EntityCommandBuffer>(m_scene_copy.get());
+    ScriptGlue::set_command_buffer(m_command_buffer);
+
+    m_scene_copy->on_construct<ScriptComponent>(
+        [&](Registry&, EntityHandle entity) { m_pending_script_entities.push_back(entity); });
+
+    m_scene_copy->on_destroy<ScriptComponent>([&](Registry&, EntityHandle entity) {
+        m_entity_script_instance.erase(m_scene_copy->get_entity(entity).uuid());
+    });
+
+    // Scripts can create or destroy entities when constructed, so resolve the
+    // scripted entities before instantiating any of them
+    const auto view = m_scene_copy->view<ScriptComponent>();
+
+    std::vector<Entity> scripted_entities;
+    scripted_entities.reserve(view.size_hint());
+
+    for (const auto& [handle, _] : view)
+        scripted_entities.emplace_back(handle, m_scene_copy.get());
+
     // Create class instances for entities
-    for (const auto& entity : m_scene_copy->get_entities_with<ScriptComponent>()) {
+    for (const auto& entity : scripted_entities) {
         m_entity_script_instance[entity.uuid()] = create_entity_instance(entity);
     }
+
+    flush_commands();
+
+    // The first update of the scripts runs before the scene has been rendered
+    TransformSystem::update(*m_scene_copy);
+    SpatialIndexSystem::update(*m_scene_copy);
 }
 
 void ScriptingSystem::shutdown() {
     ScriptGlue::set_scene(nullptr);
+    ScriptGlue::set_command_buffer(nullptr);
+
+    m_command_buffer.reset();
     m_scene_copy.reset();
     m_entity_script_instance.clear();
+    m_pending_script_entities.clear();
+}
+
+void ScriptingSystem::flush_commands() {
+    m_command_buffer->flush();
+
+    // Instantiate scripts once the flush has added all the components of the new entities.
+    // Commands recorded by their constructors are applied in the next flush.
+    const auto pending_entities = std::move(m_pending_script_entities);
+    m_pending_script_entities.clear();
+
+    for (const auto handle : pending_entities) {
+        if (!m_scene_copy->valid(handle))
+            continue;
+
+        const auto entity = m_scene_copy->get_entity(handle);
+        if (entity.has_component<ScriptComponent>() && !m_entity_script_instance.contains(entity.uuid()))
+            m_entity_script_instance[entity.uuid()] = create_entity_instance(entity);
+    }
 }
 
 std::shared_ptr<ClassInstanceHandle> ScriptingSystem::create_entity_instance(const Entity& entity) {
@@ -62,7 +107,7 @@ std::shared_ptr<ClassInstanceHandle> ScriptingSystem::create_entity_instance(con
     const auto class_handle = m_project->asset_manager()->load_by_id_type<ClassHandle>(sc.script);
     auto instance = ClassInstanceHandle::instantiate(class_handle);
 
-    instance->invoke_constructor(entity.uuid());
+    instance->invoke_constructor(entity.id());
 
     for (const auto& [name, value] : sc.field_values) {
         if (std::holds_alternative<int32_t>(value)) {
@@ -81,8 +126,9 @@ std::shared_ptr<ClassInstanceHandle> ScriptingSystem::create_entity_instance(con
             auto v = std::get<PrefabRef>(value);
             instance->set_field_value(name, v);
         } else if (std::holds_alternative<EntityRef>(value)) {
+            // Entity references are stored by uuid, but scripts work with runtime handles
             auto v = std::get<EntityRef>(value);
-            instance->set_field_value(name, v);
+            instance->set_field_value(name, m_scene_copy->get_entity_with_uuid(v.id).id());
         }
     }
 
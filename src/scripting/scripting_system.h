@@ -1,9 +1,11 @@
 #pragma once
 
+#include <vector>
 #include <filesystem>
 #include <unordered_map>
 
 #include "core/uuid.h"
+#include "scene/entity_handle.h"
 
 namespace Phos {
 
@@ -12,6 +14,7 @@ class Project;
 class Scene;
 class Entity;
 class ClassInstanceHandle;
+class EntityCommandBuffer;
 
 class ScriptingSystem {
   public:
@@ -28,10 +31,14 @@ class ScriptingSystem {
     std::filesystem::path m_dll_path;
 
     std::shared_ptr<Scene> m_scene_copy;
+    std::shared_ptr<EntityCommandBuffer> m_command_buffer;
 
     std::unordered_map<UUID, std::shared_ptr<ClassInstanceHandle>> m_entity_script_instance;
+    // Scripted entities created by the last flush, waiting for their script instance
+    std::vector<EntityHandle> m_pending_script_entities;
 
     [[nodiscard]] std::shared_ptr<ClassInstanceHandle> create_entity_instance(const Entity& entity);
+    void flush_commands();
 };
 
 } // namespace Phos
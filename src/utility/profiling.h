@@ -9,6 +9,8 @@ namespace Phos {
 #define PHOS_PROFILE_FRAMEMARK FrameMark
 #define PHOS_PROFILE_ZONE_SCOPED ZoneScoped
 #define PHOS_PROFILE_ZONE_SCOPED_NAMED(name) ZoneScopedN(name)
+#define PHOS_PROFILE_SET_THREAD_NAME(name) tracy::SetThreadName(name)
+#define PHOS_PROFILE_PLOT(name, value) TracyPlot(name, value)
 
 } // namespace Phos
 
@@ -19,6 +21,8 @@ namespace Phos {
 #define PHOS_PROFILE_FRAMEMARK
 #define PHOS_PROFILE_ZONE_SCOPED
 #define PHOS_PROFILE_ZONE_SCOPED_NAMED(name)
+#define PHOS_PROFILE_SET_THREAD_NAME(name)
+#define PHOS_PROFILE_PLOT(name, value)
 
 } // namespace Phos
 
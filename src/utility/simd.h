@@ -0,0 +1,174 @@
+#pragma once
+
+// Thin wrappers over the SSE4.1 and AVX2 intrinsics, giving both instruction sets the same interface so that SIMD
+// kernels can be written once as templates. Only the wrappers of the instruction sets the including translation unit
+// is compiled for are defined. They have internal linkage on purpose: an inline function compiled with AVX2 must never
+// be picked by the linker for a translation unit that runs on CPUs without it.
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <cstddef>
+#include <immintrin.h>
+
+namespace Phos {
+
+namespace {
+
+#if defined(__SSE4_1__) || defined(_MSC_VER)
+
+struct SimdSse4 {
+    using Float = __m128;
+    using Int = __m128i;
+    static constexpr std::size_t WIDTH = 4;
+
+    static Float load(const float* ptr) { return _mm_loadu_ps(ptr); }
+    static void store(float* ptr, Float a) { _mm_storeu_ps(ptr, a); }
+    static Float set1(float value) { return _mm_set1_ps(value); }
+
+    static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float fmadd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+
+    static Float bit_and(Float a, Float b) { return _mm_and_ps(a, b); }
+    static Float bit_andnot(Float a, Float b) { return _mm_andnot_ps(a, b); }
+    static Float bit_or(Float a, Float b) { return _mm_or_ps(a, b); }
+    static Float bit_xor(Float a, Float b) { return _mm_xor_ps(a, b); }
+    static Float blend(Float a, Float b, Float mask) { return _mm_blendv_ps(a, b, mask); }
+
+    static Float cmp_ge(Float a, Float b) { return _mm_cmpge_ps(a, b); }
+    static Float cmp_lt(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+    /// One bit per lane, set when the sign bit of the lane is set
+    static int movemask(Float a) { return _mm_movemask_ps(a); }
+
+    static Int to_int(Float a) { return _mm_cvttps_epi32(a); }
+    static Float to_float(Int a) { return _mm_cvtepi32_ps(a); }
+    static Float as_float(Int a) { return _mm_castsi128_ps(a); }
+
+    static Int iset1(int value) { return _mm_set1_epi32(value); }
+    static Int iadd(Int a, Int b) { return _mm_add_epi32(a, b); }
+    static Int isub(Int a, Int b) { return _mm_sub_epi32(a, b); }
+    static Int iand(Int a, Int b) { return _mm_and_si128(a, b); }
+    static Int iandnot(Int a, Int b) { return _mm_andnot_si128(a, b); }
+    static Int icmpeq(Int a, Int b) { return _mm_cmpeq_epi32(a, b); }
+
+    template <int N>
+    static Int shift_left(Int a) {
+        return _mm_slli_epi32(a, N);
+    }
+
+    /// Loads a vec4 from every lane pointer, and transposes them into one register per component
+    static void gather_transposed(const float* const* lanes, Float& x, Float& y, Float& z, Float& w) {
+        x = _mm_loadu_ps(lanes[0]);
+        y = _mm_loadu_ps(lanes[1]);
+        z = _mm_loadu_ps(lanes[2]);
+        w = _mm_loadu_ps(lanes[3]);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+    }
+
+    /// Transposes one register per component into a vec4 per lane, and stores them in the lane pointers
+    static void scatter_transposed(float* const* lanes, Float x, Float y, Float z, Float w) {
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        _mm_storeu_ps(lanes[0], x);
+        _mm_storeu_ps(lanes[1], y);
+        _mm_storeu_ps(lanes[2], z);
+        _mm_storeu_ps(lanes[3], w);
+    }
+};
+
+#endif
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+
+struct SimdAvx2 {
+    using Float = __m256;
+    using Int = __m256i;
+    static constexpr std::size_t WIDTH = 8;
+
+    static Float load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+    static void store(float* ptr, Float a) { _mm256_storeu_ps(ptr, a); }
+    static Float set1(float value) { return _mm256_set1_ps(value); }
+
+    static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float fmadd(Float a, Float b, Float c) { return _mm256_fmadd_ps(a, b, c); }
+    static Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+
+    static Float bit_and(Float a, Float b) { return _mm256_and_ps(a, b); }
+    static Float bit_andnot(Float a, Float b) { return _mm256_andnot_ps(a, b); }
+    static Float bit_or(Float a, Float b) { return _mm256_or_ps(a, b); }
+    static Float bit_xor(Float a, Float b) { return _mm256_xor_ps(a, b); }
+    static Float blend(Float a, Float b, Float mask) { return _mm256_blendv_ps(a, b, mask); }
+
+    static Float cmp_ge(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Float cmp_lt(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static int movemask(Float a) { return _mm256_movemask_ps(a); }
+
+    static Int to_int(Float a) { return _mm256_cvttps_epi32(a); }
+    static Float to_float(Int a) { return _mm256_cvtepi32_ps(a); }
+    static Float as_float(Int a) { return _mm256_castsi256_ps(a); }
+
+    static Int iset1(int value) { return _mm256_set1_epi32(value); }
+    static Int iadd(Int a, Int b) { return _mm256_add_epi32(a, b); }
+    static Int isub(Int a, Int b) { return _mm256_sub_epi32(a, b); }
+    static Int iand(Int a, Int b) { return _mm256_and_si256(a, b); }
+    static Int iandnot(Int a, Int b) { return _mm256_andnot_si256(a, b); }
+    static Int icmpeq(Int a, Int b) { return _mm256_cmpeq_epi32(a, b); }
+
+    template <int N>
+    static Int shift_left(Int a) {
+        return _mm256_slli_epi32(a, N);
+    }
+
+    // 4x4 transpose inside each 128-bit half
+    static void transpose4(Float& a, Float& b, Float& c, Float& d) {
+        const Float t0 = _mm256_unpacklo_ps(a, b);
+        const Float t1 = _mm256_unpacklo_ps(c, d);
+        const Float t2 = _mm256_unpackhi_ps(a, b);
+        const Float t3 = _mm256_unpackhi_ps(c, d);
+
+        a = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+        b = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+        c = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        d = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    // Lanes k and k + 4 share a register before the transpose, in its low and high halves
+    static void gather_transposed(const float* const* lanes, Float& x, Float& y, Float& z, Float& w) {
+        const auto load_pair = [&](int k) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lanes[k])), _mm_loadu_ps(lanes[k + 4]), 1);
+        };
+
+        x = load_pair(0);
+        y = load_pair(1);
+        z = load_pair(2);
+        w = load_pair(3);
+        transpose4(x, y, z, w);
+    }
+
+    static void scatter_transposed(float* const* lanes, Float x, Float y, Float z, Float w) {
+        transpose4(x, y, z, w);
+
+        const auto store_pair = [&](int k, Float pair) {
+            _mm_storeu_ps(lanes[k], _mm256_castps256_ps128(pair));
+            _mm_storeu_ps(lanes[k + 4], _mm256_extractf128_ps(pair, 1));
+        };
+
+        store_pair(0, x);
+        store_pair(1, y);
+        store_pair(2, z);
+        store_pair(3, w);
+    }
+};
+
+#endif
+
+} // namespace
+
+} // namespace Phos
+
+#endif
@@ -0,0 +1,79 @@
+#include "core/job_system.h"
+
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+#include <thread>
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("Jobs run inline without workers", "[JobSystem]") {
+    Phos::JobCounter counter;
+
+    bool executed = false;
+    Phos::JobSystem::schedule([&] { executed = true; }, &counter);
+
+    REQUIRE(executed);
+    REQUIRE(counter.is_zero());
+}
+
+TEST_CASE("Parallel for covers the whole range once", "[JobSystem]") {
+    Phos::JobSystem::initialize(4);
+
+    std::vector<std::atomic<uint32_t>> visits(100'003);
+    Phos::JobSystem::parallel_for(visits.size(), 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            ++visits[i];
+    });
+
+    REQUIRE(std::ranges::all_of(visits, [](const auto& v) { return v == 1; }));
+
+    Phos::JobSystem::shutdown();
+}
+
+TEST_CASE("Jobs wait for their dependencies", "[JobSystem]") {
+    Phos::JobSystem::initialize(4);
+
+    Phos::JobCounter first;
+    Phos::JobCounter second;
+
+    std::atomic<uint32_t> finished_first = 0;
+    std::atomic<bool> dependency_respected = true;
+
+    for (uint32_t i = 0; i < 64; ++i)
+        Phos::JobSystem::schedule([&] { ++finished_first; }, &first);
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        Phos::JobSystem::schedule_after(
+            first, [&] { dependency_respected = dependency_respected && finished_first == 64; }, &second);
+    }
+
+    Phos::JobSystem::wait(second);
+
+    REQUIRE(first.is_zero());
+    REQUIRE(dependency_respected);
+
+    Phos::JobSystem::shutdown();
+}
+
+TEST_CASE("Waiting sleeps until long jobs finish", "[JobSystem]") {
+    Phos::JobSystem::initialize(2);
+
+    // Both jobs are picked up by the workers, so the waiting thread has nothing to run and has to sleep
+    Phos::JobCounter counter;
+    std::atomic<uint32_t> finished = 0;
+    for (uint32_t i = 0; i < 2; ++i) {
+        Phos::JobSystem::schedule(
+            [&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                ++finished;
+            },
+            &counter);
+    }
+
+    Phos::JobSystem::wait(counter);
+    REQUIRE(finished == 2);
+
+    Phos::JobSystem::shutdown();
+}
@@ -0,0 +1,122 @@
+#include "core/tlsf_allocator.h"
+
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("Allocations do not overlap and respect the alignment", "[TLSFAllocator]") {
+    Phos::TLSFAllocator allocator(1024);
+
+    const auto a = allocator.allocate(100);
+    const auto b = allocator.allocate(60, 256);
+    const auto c = allocator.allocate(10, 16);
+
+    REQUIRE(a.has_value());
+    REQUIRE(b.has_value());
+    REQUIRE(c.has_value());
+
+    REQUIRE(b->offset % 256 == 0);
+    REQUIRE(c->offset % 16 == 0);
+
+    const auto overlap = [](uint64_t offset_a, uint64_t size_a, uint64_t offset_b, uint64_t size_b) {
+        return offset_a < offset_b + size_b && offset_b < offset_a + size_a;
+    };
+    REQUIRE_FALSE(overlap(a->offset, 100, b->offset, 60));
+    REQUIRE_FALSE(overlap(a->offset, 100, c->offset, 10));
+    REQUIRE_FALSE(overlap(b->offset, 60, c->offset, 10));
+
+    REQUIRE(allocator.used() == 170);
+    REQUIRE(allocator.allocation_count() == 3);
+    REQUIRE(allocator.validate());
+}
+
+TEST_CASE("Freed ranges are merged with their free neighbours", "[TLSFAllocator]") {
+    Phos::TLSFAllocator allocator(4096);
+
+    std::vector<Phos::TLSFAllocator::Allocation> allocations;
+    for (uint32_t idx = 0; idx < 4; ++idx)
+        allocations.push_back(*allocator.allocate(1024));
+
+    // The block is full
+    REQUIRE_FALSE(allocator.allocate(1).has_value());
+
+    // Freeing the middle ranges in any order leaves a single range for a bigger allocation
+    allocator.free(allocations[2].node);
+    allocator.free(allocations[1].node);
+    REQUIRE(allocator.validate());
+
+    const auto merged = allocator.allocate(2048);
+    REQUIRE(merged.has_value());
+    REQUIRE(merged->offset == 1024);
+
+    allocator.free(merged->node);
+    allocator.free(allocations[0].node);
+    allocator.free(allocations[3].node);
+
+    REQUIRE(allocator.empty());
+    REQUIRE(allocator.used() == 0);
+    REQUIRE(allocator.validate());
+
+    // Everything has been merged back into the whole block
+    const auto whole = allocator.allocate(4096);
+    REQUIRE(whole.has_value());
+    REQUIRE(whole->offset == 0);
+}
+
+TEST_CASE("Random allocations and frees keep the allocator consistent", "[TLSFAllocator]") {
+    constexpr uint64_t BLOCK_SIZE = 64 * 1024 * 1024;
+    Phos::TLSFAllocator allocator(BLOCK_SIZE);
+
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<uint64_t> size_dist(1, 512 * 1024);
+    std::uniform_int_distribution<uint32_t> alignment_dist(0, 8);
+    std::uniform_int_distribution<uint32_t> action_dist(0, 2);
+
+    struct Live {
+        uint64_t offset;
+        uint64_t size;
+        Phos::TLSFAllocator::NodeId node;
+    };
+    std::vector<Live> live;
+
+    for (uint32_t iteration = 0; iteration < 20'000; ++iteration) {
+        // Two allocations for every free
+        if (live.empty() || action_dist(generator) != 0) {
+            const auto size = size_dist(generator);
+            const auto alignment = uint64_t{1} << alignment_dist(generator);
+
+            const auto allocation = allocator.allocate(size, alignment);
+            if (!allocation.has_value())
+                continue;
+
+            REQUIRE(allocation->offset % alignment == 0);
+            REQUIRE(allocation->offset + size <= BLOCK_SIZE);
+            live.push_back({allocation->offset, size, allocation->node});
+        } else {
+            const auto idx = std::uniform_int_distribution<std::size_t>(0, live.size() - 1)(generator);
+            allocator.free(live[idx].node);
+
+            live[idx] = live.back();
+            live.pop_back();
+        }
+
+        if (iteration % 1000 == 0)
+            REQUIRE(allocator.validate());
+    }
+
+    std::ranges::sort(live, [](const Live& a, const Live& b) { return a.offset < b.offset; });
+    for (std::size_t idx = 1; idx < live.size(); ++idx)
+        REQUIRE(live[idx - 1].offset + live[idx - 1].size <= live[idx].offset);
+
+    REQUIRE(allocator.allocation_count() == live.size());
+    REQUIRE(allocator.validate());
+
+    for (const auto& allocation : live)
+        allocator.free(allocation.node);
+
+    REQUIRE(allocator.empty());
+    REQUIRE(allocator.validate());
+    REQUIRE(allocator.allocate(BLOCK_SIZE).has_value());
+}
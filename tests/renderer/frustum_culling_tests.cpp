@@ -0,0 +1,116 @@
+#include "renderer/frustum_culling.h"
+
+#include <catch2/catch_all.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "renderer/mesh.h"
+
+static Phos::Frustum make_frustum() {
+    const auto projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+    const auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return Phos::Frustum::from_view_projection(projection * view);
+}
+
+TEST_CASE("Transformed bounding boxes enclose every corner", "[FrustumCulling]") {
+    const auto aabb = Phos::AABB{.min = glm::vec3(-1.0f, -2.0f, -0.5f), .max = glm::vec3(1.0f, 2.0f, 3.0f)};
+
+    const auto rotation =
+        GENERATE(glm::vec3(0.0f), glm::vec3(0.0f, glm::radians(45.0f), 0.0f), glm::vec3(0.3f, -1.2f, 2.5f));
+    const auto model = glm::translate(glm::mat4{1.0f}, glm::vec3(5.0f, -3.0f, 2.0f)) *
+                       glm::mat4_cast(glm::quat(rotation)) * glm::scale(glm::mat4{1.0f}, glm::vec3(2.0f, 1.0f, 0.5f));
+
+    auto expected = Phos::AABB{.min = glm::vec3(INFINITY), .max = glm::vec3(-INFINITY)};
+    for (int corner = 0; corner < 8; ++corner) {
+        const auto local = glm::vec3((corner & 1) ? aabb.max.x : aabb.min.x,
+                                     (corner & 2) ? aabb.max.y : aabb.min.y,
+                                     (corner & 4) ? aabb.max.z : aabb.min.z);
+        const auto world = glm::vec3(model * glm::vec4(local, 1.0f));
+
+        expected.min = glm::min(expected.min, world);
+        expected.max = glm::max(expected.max, world);
+    }
+
+    // The box of the transformed corners is the tightest axis aligned box
+    const auto transformed = Phos::FrustumCulling::transform(aabb, model);
+    for (int axis = 0; axis < 3; ++axis) {
+        REQUIRE(transformed.min[axis] == Catch::Approx(expected.min[axis]).margin(1e-4));
+        REQUIRE(transformed.max[axis] == Catch::Approx(expected.max[axis]).margin(1e-4));
+    }
+}
+
+TEST_CASE("Boxes outside of the frustum are culled", "[FrustumCulling]") {
+    const auto frustum = make_frustum();
+
+    const auto box_at = [](glm::vec3 center) {
+        return Phos::AABB{.min = center - glm::vec3(0.5f), .max = center + glm::vec3(0.5f)};
+    };
+
+    REQUIRE(Phos::FrustumCulling::is_visible(frustum, box_at(glm::vec3(0.0f, 0.0f, -10.0f))));
+    // Crossing the left plane
+    REQUIRE(Phos::FrustumCulling::is_visible(frustum, box_at(glm::vec3(-5.9f, 0.0f, -10.0f))));
+
+    REQUIRE_FALSE(Phos::FrustumCulling::is_visible(frustum, box_at(glm::vec3(0.0f, 0.0f, 10.0f))));
+    REQUIRE_FALSE(Phos::FrustumCulling::is_visible(frustum, box_at(glm::vec3(0.0f, 0.0f, -150.0f))));
+    REQUIRE_FALSE(Phos::FrustumCulling::is_visible(frustum, box_at(glm::vec3(50.0f, 0.0f, -10.0f))));
+    REQUIRE_FALSE(Phos::FrustumCulling::is_visible(frustum, box_at(glm::vec3(0.0f, -50.0f, -10.0f))));
+}
+
+TEST_CASE("Batched culling matches single box culling", "[FrustumCulling]") {
+    const auto backend = GENERATE(Phos::SimdBackend::Scalar, Phos::SimdBackend::SSE4, Phos::SimdBackend::AVX2);
+    if (!Phos::CpuFeatures::supports(backend))
+        return;
+
+    const auto frustum = make_frustum();
+
+    // Grid of boxes around the camera, the count is not a multiple of the batch size nor of the mask words
+    std::vector<Phos::AABB> boxes;
+    for (int x = -10; x <= 10; x += 2) {
+        for (int y = -4; y <= 4; y += 4) {
+            for (int z = -60; z <= 20; z += 8) {
+                const auto center = glm::vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+                boxes.push_back(Phos::AABB{.min = center - glm::vec3(1.0f), .max = center + glm::vec3(1.0f)});
+            }
+        }
+    }
+
+    Phos::BoundsArrays bounds;
+    for (const auto& box : boxes)
+        bounds.push_back(box);
+
+    Phos::VisibilityMask visibility;
+    Phos::FrustumCulling::cull(backend, frustum, bounds, visibility);
+
+    REQUIRE(visibility.size() == (boxes.size() + 63) / 64);
+
+    std::size_t expected_visible = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const auto expected = Phos::FrustumCulling::is_visible(frustum, boxes[i]);
+        REQUIRE(Phos::FrustumCulling::is_visible(visibility, i) == expected);
+
+        expected_visible += expected ? 1 : 0;
+    }
+
+    REQUIRE(expected_visible > 0);
+    REQUIRE(expected_visible < boxes.size());
+    REQUIRE(Phos::FrustumCulling::count_visible(visibility) == expected_visible);
+}
+
+TEST_CASE("Frustums extended to the viewer keep what is in front of the near plane", "[FrustumCulling]") {
+    // Directional light looking down -z, like the shadow pass
+    const auto projection = glm::ortho(-10.0f, 10.0f, 10.0f, -10.0f, 0.01f, 40.0f);
+    const auto view = glm::lookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const auto frustum = Phos::Frustum::from_view_projection(projection * view);
+    const auto extended = frustum.extended_to_viewer();
+
+    const auto between_light_and_near =
+        Phos::AABB{.min = glm::vec3(-1.0f, -1.0f, 20.0f), .max = glm::vec3(1.0f, 1.0f, 22.0f)};
+    REQUIRE_FALSE(Phos::FrustumCulling::is_visible(frustum, between_light_and_near));
+    REQUIRE(Phos::FrustumCulling::is_visible(extended, between_light_and_near));
+
+    // The sides and the far plane still cull
+    const auto beside = Phos::AABB{.min = glm::vec3(15.0f, -1.0f, 20.0f), .max = glm::vec3(17.0f, 1.0f, 22.0f)};
+    const auto behind_far = Phos::AABB{.min = glm::vec3(-1.0f, -1.0f, -45.0f), .max = glm::vec3(1.0f, 1.0f, -40.0f)};
+    REQUIRE_FALSE(Phos::FrustumCulling::is_visible(extended, beside));
+    REQUIRE_FALSE(Phos::FrustumCulling::is_visible(extended, behind_far));
+}
@@ -0,0 +1,158 @@
+#include "renderer/occlusion_culling.h"
+
+#include <catch2/catch_all.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <array>
+
+#include "renderer/mesh.h"
+
+static glm::mat4 make_view_projection() {
+    const auto projection = glm::perspective(glm::radians(90.0f), 2.0f, 0.1f, 100.0f);
+    const auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+// Quad facing the camera at depth z, as two triangles
+static const std::array<uint32_t, 6> QUAD_INDICES = {0, 1, 2, 0, 2, 3};
+
+static std::array<glm::vec3, 4> make_quad(glm::vec2 min, glm::vec2 max, float z) {
+    return {
+        glm::vec3(min.x, min.y, z),
+        glm::vec3(max.x, min.y, z),
+        glm::vec3(max.x, max.y, z),
+        glm::vec3(min.x, max.y, z),
+    };
+}
+
+static Phos::AABB make_box(glm::vec3 center, float half_size) {
+    return Phos::AABB{.min = center - glm::vec3(half_size), .max = center + glm::vec3(half_size)};
+}
+
+TEST_CASE("Boxes behind an occluder are rejected", "[OcclusionCulling]") {
+    const auto backend = GENERATE(Phos::SimdBackend::Scalar, Phos::SimdBackend::SSE4, Phos::SimdBackend::AVX2);
+    if (!Phos::CpuFeatures::supports(backend))
+        return;
+
+    Phos::OcclusionBuffer buffer;
+    REQUIRE(buffer.width() == Phos::OcclusionBuffer::DEFAULT_WIDTH);
+    REQUIRE(buffer.height() == Phos::OcclusionBuffer::DEFAULT_HEIGHT);
+
+    buffer.begin(make_view_projection());
+
+    // Wall covering the left half of the view
+    const auto wall = make_quad(glm::vec2(-50.0f, -20.0f), glm::vec2(0.0f, 20.0f), -10.0f);
+    buffer.add_occluder(wall, QUAD_INDICES, glm::mat4{1.0f});
+    buffer.rasterize(backend);
+
+    REQUIRE(buffer.statistics().occluders == 1);
+    REQUIRE(buffer.statistics().occluder_triangles == 2);
+
+    // Behind the wall
+    REQUIRE_FALSE(buffer.is_visible(make_box(glm::vec3(-5.0f, 0.0f, -30.0f), 1.0f)));
+    REQUIRE_FALSE(buffer.is_visible(make_box(glm::vec3(-15.0f, 3.0f, -50.0f), 4.0f)));
+
+    // In front of the wall
+    REQUIRE(buffer.is_visible(make_box(glm::vec3(-5.0f, 0.0f, -5.0f), 1.0f)));
+    // Behind, but not hidden by the wall
+    REQUIRE(buffer.is_visible(make_box(glm::vec3(10.0f, 0.0f, -30.0f), 1.0f)));
+    // Behind, partially hidden
+    REQUIRE(buffer.is_visible(make_box(glm::vec3(0.0f, 0.0f, -30.0f), 3.0f)));
+    // Crossing the near plane
+    REQUIRE(buffer.is_visible(make_box(glm::vec3(-1.0f, 0.0f, 0.0f), 1.0f)));
+
+    REQUIRE(buffer.statistics().tested == 6);
+    REQUIRE(buffer.statistics().occluded == 2);
+
+    // Starting a new frame removes the occluders
+    buffer.begin(make_view_projection());
+    buffer.rasterize(backend);
+    REQUIRE(buffer.is_visible(make_box(glm::vec3(-5.0f, 0.0f, -30.0f), 1.0f)));
+    REQUIRE(buffer.statistics().occluded == 0);
+}
+
+TEST_CASE("Occluders crossing the near plane do not hide anything", "[OcclusionCulling]") {
+    Phos::OcclusionBuffer buffer;
+    buffer.begin(make_view_projection());
+
+    // Floor going from behind the camera to far away
+    const std::array<glm::vec3, 4> floor = {glm::vec3(-50.0f, -1.0f, 10.0f),
+                                           glm::vec3(50.0f, -1.0f, 10.0f),
+                                           glm::vec3(50.0f, -1.0f, -90.0f),
+                                           glm::vec3(-50.0f, -1.0f, -90.0f)};
+    buffer.add_occluder(floor, QUAD_INDICES, glm::mat4{1.0f});
+    buffer.rasterize();
+
+    REQUIRE(buffer.statistics().occluder_triangles == 0);
+    REQUIRE(buffer.is_visible(make_box(glm::vec3(0.0f, -5.0f, -20.0f), 1.0f)));
+}
+
+TEST_CASE("Depth hierarchy keeps the minimum and maximum of every block", "[OcclusionCulling]") {
+    Phos::OcclusionBuffer buffer(100, 50);
+
+    // Rounded up to whole tiles
+    REQUIRE(buffer.width() == 128);
+    REQUIRE(buffer.height() == 64);
+
+    buffer.begin(make_view_projection());
+    const auto near_quad = make_quad(glm::vec2(-4.0f, -1.0f), glm::vec2(-1.0f, 1.0f), -5.0f);
+    const auto far_quad = make_quad(glm::vec2(1.0f, -2.0f), glm::vec2(20.0f, 5.0f), -40.0f);
+    buffer.add_occluder(near_quad, QUAD_INDICES, glm::mat4{1.0f});
+    buffer.add_occluder(far_quad, QUAD_INDICES, glm::mat4{1.0f});
+    buffer.rasterize();
+
+    auto expected_min = 1.0f, expected_max = 0.0f;
+    for (uint32_t y = 0; y < buffer.height(); ++y) {
+        for (uint32_t x = 0; x < buffer.width(); ++x) {
+            expected_min = std::min(expected_min, buffer.depth(x, y));
+            expected_max = std::max(expected_max, buffer.depth(x, y));
+        }
+    }
+
+    REQUIRE(expected_min < 1.0f);
+
+    const auto top = buffer.number_levels() - 1;
+    REQUIRE(buffer.min_depth(top, 0, 0) == expected_min);
+    REQUIRE(buffer.max_depth(top, 0, 0) == expected_max);
+
+    for (uint32_t level = 1; level < buffer.number_levels(); ++level) {
+        REQUIRE(buffer.min_depth(level, 0, 0) <= buffer.min_depth(level - 1, 0, 0));
+        REQUIRE(buffer.max_depth(level, 0, 0) >= buffer.max_depth(level - 1, 0, 0));
+    }
+}
+
+TEST_CASE("SIMD rasterizers match the scalar one", "[OcclusionCulling]") {
+    const auto backend = GENERATE(Phos::SimdBackend::SSE4, Phos::SimdBackend::AVX2);
+    if (!Phos::CpuFeatures::supports(backend))
+        return;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> depth(-60.0f, -2.0f);
+
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < 300; ++i) {
+        vertices.emplace_back(position(rng), position(rng), depth(rng));
+        indices.push_back(i);
+    }
+
+    Phos::OcclusionBuffer scalar, simd;
+    for (auto* buffer : {&scalar, &simd}) {
+        buffer->begin(make_view_projection());
+        buffer->add_occluder(vertices, indices, glm::mat4{1.0f});
+    }
+    scalar.rasterize(Phos::SimdBackend::Scalar);
+    simd.rasterize(backend);
+
+    // Pixel centers lying exactly on an edge can be classified differently because of rounding
+    uint32_t mismatches = 0;
+    for (uint32_t y = 0; y < scalar.height(); ++y) {
+        for (uint32_t x = 0; x < scalar.width(); ++x) {
+            if (std::abs(scalar.depth(x, y) - simd.depth(x, y)) > 1e-5f)
+                ++mismatches;
+        }
+    }
+
+    REQUIRE(mismatches < scalar.width() * scalar.height() / 1000);
+}
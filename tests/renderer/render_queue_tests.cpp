@@ -0,0 +1,185 @@
+#include "renderer/render_queue.h"
+
+#include <catch2/catch_all.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <random>
+
+TEST_CASE("Sort keys order by pass, pipeline, material, mesh and depth", "[RenderQueue]") {
+    const auto key = [](uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+        return Phos::RenderQueue::make_sort_key(pass, pipeline, material, mesh, depth);
+    };
+
+    // Every field is more significant than the following ones
+    REQUIRE(key(0, 9, 9, 9, 100.0f) < key(1, 0, 0, 0, 0.0f));
+    REQUIRE(key(0, 0, 9, 9, 100.0f) < key(0, 1, 0, 0, 0.0f));
+    REQUIRE(key(0, 0, 0, 9, 100.0f) < key(0, 0, 1, 0, 0.0f));
+    REQUIRE(key(0, 0, 0, 0, 100.0f) < key(0, 0, 0, 1, 0.0f));
+
+    // Front to back
+    REQUIRE(key(0, 0, 0, 0, 0.5f) < key(0, 0, 0, 0, 1.0f));
+    REQUIRE(key(0, 0, 0, 0, 1.0f) < key(0, 0, 0, 0, 20.0f));
+    REQUIRE(key(0, 0, 0, 0, 20.0f) < key(0, 0, 0, 0, 1000.0f));
+
+    // Negative depths are clamped
+    REQUIRE(key(0, 0, 0, 0, -5.0f) == key(0, 0, 0, 0, 0.0f));
+
+    // Ids that do not fit are truncated instead of overflowing into other fields
+    REQUIRE(key(0, 0, 0, 1u << Phos::RenderQueue::MESH_BITS, 0.0f) == key(0, 0, 0, 0, 0.0f));
+}
+
+TEST_CASE("Radix sort matches a stable sort", "[RenderQueue]") {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<uint32_t> pass_dist(0, 3);
+    std::uniform_int_distribution<uint32_t> id_dist(0, 20);
+    std::uniform_real_distribution<float> depth_dist(0.0f, 200.0f);
+
+    const auto size = GENERATE(0, 1, 7, 1000, 50000);
+
+    std::vector<Phos::RenderQueue::SortEntry> entries;
+    for (uint32_t idx = 0; idx < static_cast<uint32_t>(size); ++idx) {
+        const auto pass = pass_dist(generator);
+        const auto pipeline = id_dist(generator) % 2;
+        const auto material = id_dist(generator);
+        const auto mesh = id_dist(generator);
+
+        const auto key = Phos::RenderQueue::make_sort_key(pass, pipeline, material, mesh, depth_dist(generator));
+        entries.push_back({.key = key, .packet_idx = idx});
+    }
+
+    auto expected = entries;
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+
+    std::vector<Phos::RenderQueue::SortEntry> scratch;
+    Phos::RenderQueue::radix_sort(entries, scratch);
+
+    REQUIRE(entries.size() == expected.size());
+    for (std::size_t idx = 0; idx < entries.size(); ++idx) {
+        REQUIRE(entries[idx].key == expected[idx].key);
+        REQUIRE(entries[idx].packet_idx == expected[idx].packet_idx);
+    }
+}
+
+TEST_CASE("Packets are replayed by pass from front to back", "[RenderQueue]") {
+    Phos::RenderQueue queue;
+    queue.set_instancing(false);
+
+    const auto packet_at = [](float x) {
+        return Phos::RenderPacket{.model = glm::translate(glm::mat4{1.0f}, glm::vec3(x, 0.0f, 0.0f))};
+    };
+
+    queue.push(1, packet_at(3.0f), 3.0f);
+    queue.push(0, packet_at(2.0f), 2.0f);
+    queue.push(1, packet_at(1.0f), 1.0f);
+    queue.push(0, packet_at(4.0f), 4.0f);
+    queue.push(1, packet_at(2.0f), 2.0f);
+    queue.sort();
+
+    REQUIRE(queue.size() == 5);
+
+    // Instance data is stored in sort order
+    REQUIRE(queue.instances().size() == 5);
+    REQUIRE(queue.instances()[0].model[3].x == 2.0f);
+    REQUIRE(queue.instances()[2].model[3].x == 1.0f);
+
+    const auto replayed = [&](uint32_t pass) {
+        std::vector<float> order;
+        queue.for_each(pass, [&](const Phos::RenderQueue::RenderBatch& batch, Phos::RenderQueue::StateChanges changes) {
+            REQUIRE(batch.instance_count == 1);
+            REQUIRE(queue.instances()[batch.first_instance].model == batch.packet->model);
+
+            // Every packet shares the same (empty) state, so it is only set for the first draw of the pass
+            REQUIRE_FALSE(changes.pipeline);
+            REQUIRE(changes.material == order.empty());
+            REQUIRE(changes.mesh == order.empty());
+
+            order.push_back(batch.packet->model[3].x);
+        });
+        return order;
+    };
+
+    REQUIRE(replayed(0) == std::vector<float>{2.0f, 4.0f});
+    REQUIRE(replayed(1) == std::vector<float>{1.0f, 2.0f, 3.0f});
+    REQUIRE(replayed(2).empty());
+
+    queue.clear();
+    REQUIRE(queue.size() == 0);
+    REQUIRE(replayed(1).empty());
+}
+
+// Pointers to distinct objects that are only compared by the queue, never dereferenced
+template <typename T>
+static std::vector<std::shared_ptr<T>> make_fake_resources(std::size_t count) {
+    static std::vector<char> storage(1024);
+    REQUIRE(count <= storage.size());
+
+    std::vector<std::shared_ptr<T>> resources;
+    for (std::size_t idx = 0; idx < count; ++idx)
+        resources.emplace_back(std::shared_ptr<void>{}, reinterpret_cast<T*>(&storage[idx]));
+
+    return resources;
+}
+
+TEST_CASE("Packets with the same state are batched into instanced draws", "[RenderQueue]") {
+    // 10k props made of 10 meshes and 4 materials, pushed in random order as if iterated from the scene
+    constexpr uint32_t NUM_INSTANCES = 10'000;
+    const auto sub_meshes = make_fake_resources<Phos::SubMesh>(10);
+    const auto materials = make_fake_resources<Phos::Material>(4);
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<std::size_t> mesh_dist(0, sub_meshes.size() - 1);
+    std::uniform_int_distribution<std::size_t> material_dist(0, materials.size() - 1);
+    std::uniform_real_distribution<float> depth_dist(0.0f, 100.0f);
+
+    const auto instancing = GENERATE(true, false);
+
+    Phos::RenderQueue queue;
+    queue.set_instancing(instancing);
+
+    // The x translation of every instance is its index
+    std::vector<const Phos::SubMesh*> sub_mesh_of_instance;
+    std::vector<const Phos::Material*> material_of_instance;
+
+    for (uint32_t idx = 0; idx < NUM_INSTANCES; ++idx) {
+        const auto packet = Phos::RenderPacket{
+            .model = glm::translate(glm::mat4{1.0f}, glm::vec3(static_cast<float>(idx), 0.0f, 0.0f)),
+            .sub_mesh = sub_meshes[mesh_dist(generator)],
+            .material = materials[material_dist(generator)],
+        };
+        sub_mesh_of_instance.push_back(packet.sub_mesh.get());
+        material_of_instance.push_back(packet.material.get());
+
+        queue.push(0, packet, depth_dist(generator));
+    }
+    queue.sort();
+
+    uint32_t draws = 0, instances = 0, material_changes = 0, mesh_changes = 0;
+    queue.for_each(0, [&](const Phos::RenderQueue::RenderBatch& batch, Phos::RenderQueue::StateChanges changes) {
+        // Every instance of the batch shares the state of its first packet
+        REQUIRE(batch.first_instance == instances);
+        for (uint32_t instance_idx = 0; instance_idx < batch.instance_count; ++instance_idx) {
+            const auto& instance = queue.instances()[batch.first_instance + instance_idx];
+            const auto packet_idx = static_cast<std::size_t>(instance.model[3].x);
+
+            REQUIRE(sub_mesh_of_instance[packet_idx] == batch.packet->sub_mesh.get());
+            REQUIRE(material_of_instance[packet_idx] == batch.packet->material.get());
+        }
+
+        ++draws;
+        instances += batch.instance_count;
+        material_changes += changes.material;
+        mesh_changes += changes.mesh;
+    });
+
+    REQUIRE(instances == NUM_INSTANCES);
+    REQUIRE(material_changes == materials.size());
+
+    if (instancing) {
+        // One draw per mesh and material pair
+        REQUIRE(draws == sub_meshes.size() * materials.size());
+        REQUIRE(mesh_changes == draws);
+    } else {
+        REQUIRE(draws == NUM_INSTANCES);
+        REQUIRE(mesh_changes == sub_meshes.size() * materials.size());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "scene/registry.h"
+
+#include <string>
+#include <memory>
+
+#include <catch2/catch_all.hpp>
+
+struct Position {
+    float x, y, z;
+};
+
+struct Velocity {
+    float x, y, z;
+};
+
+struct Tag {
+    std::string name;
+};
+
+constexpr auto ARCHETYPE = Phos::Registry::StorageMode::Archetype;
+
+TEST_CASE("Archetype components can be added and retrieved", "[ArchetypeStorage]") {
+    auto registry = Phos::Registry(ARCHETYPE);
+    REQUIRE(registry.storage_mode() == ARCHETYPE);
+
+    const auto entity = registry.create();
+    registry.add_component(entity, Position{1.0f, 2.0f, 3.0f});
+
+    REQUIRE(registry.has_component<Position>(entity));
+    REQUIRE(!registry.has_component<Velocity>(entity));
+
+    // Adding a second component moves the entity to another archetype, keeping the existing data
+    registry.add_component(entity, Velocity{4.0f, 5.0f, 6.0f});
+
+    REQUIRE(registry.has_component<Velocity>(entity));
+    REQUIRE(registry.get_component<Position>(entity).y == 2.0f);
+    REQUIRE(registry.get_component<Velocity>(entity).z == 6.0f);
+
+    registry.remove_component<Position>(entity);
+
+    REQUIRE(!registry.has_component<Position>(entity));
+    REQUIRE(registry.get_component<Velocity>(entity).x == 4.0f);
+}
+
+TEST_CASE("Archetype rows stay valid when entities move", "[ArchetypeStorage]") {
+    auto registry = Phos::Registry(ARCHETYPE);
+
+    std::vector<Phos::EntityHandle> entities;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        const auto entity = registry.create();
+        registry.add_component(entity, Position{static_cast<float>(i), 0.0f, 0.0f});
+        registry.add_component(entity, Tag{std::to_string(i)});
+        entities.push_back(entity);
+    }
+
+    // Move every other entity to a different archetype and destroy every third one
+    for (uint32_t i = 0; i < entities.size(); i += 2)
+        registry.add_component(entities[i], Velocity{});
+    for (uint32_t i = 0; i < entities.size(); i += 3)
+        registry.destroy(entities[i]);
+
+    for (uint32_t i = 0; i < entities.size(); ++i) {
+        if (i % 3 == 0) {
+            REQUIRE(!registry.has_component<Position>(entities[i]));
+            continue;
+        }
+
+        REQUIRE(registry.get_component<Position>(entities[i]).x == static_cast<float>(i));
+        REQUIRE(registry.get_component<Tag>(entities[i]).name == std::to_string(i));
+        REQUIRE(registry.has_component<Velocity>(entities[i]) == (i % 2 == 0));
+    }
+}
+
+TEST_CASE("Archetype storage rejects stale handles", "[ArchetypeStorage]") {
+    auto registry = Phos::Registry(ARCHETYPE);
+
+    const auto entity = registry.create();
+    registry.add_component(entity, Position{});
+    registry.destroy(entity);
+
+    const auto recycled = registry.create();
+    registry.add_component(recycled, Position{});
+
+    REQUIRE(recycled.index() == entity.index());
+    REQUIRE(!registry.has_component<Position>(entity));
+    REQUIRE(registry.has_component<Position>(recycled));
+}
+
+TEST_CASE("Archetype storage destroys non trivial components", "[ArchetypeStorage]") {
+    const auto resource = std::make_shared<int>(0);
+
+    {
+        auto registry = Phos::Registry(ARCHETYPE);
+
+        const auto entity1 = registry.create();
+        const auto entity2 = registry.create();
+        registry.add_component(entity1, resource);
+        registry.add_component(entity2, resource);
+        REQUIRE(resource.use_count() == 3);
+
+        registry.add_component(entity1, Position{});
+        REQUIRE(resource.use_count() == 3);
+
+        registry.destroy(entity1);
+        REQUIRE(resource.use_count() == 2);
+    }
+
+    REQUIRE(resource.use_count() == 1);
+}
+
+TEST_CASE("Can view archetype entities with multiple components", "[ArchetypeStorage]") {
+    auto registry = Phos::Registry(ARCHETYPE);
+
+    // Enough entities to span several chunks, split between two archetypes that share Position
+    float expected = 0.0f;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        const auto entity = registry.create();
+        registry.add_component(entity, Position{static_cast<float>(i), 0.0f, 0.0f});
+
+        if (i % 4 == 0) {
+            registry.add_component(entity, Velocity{1.0f, 0.0f, 0.0f});
+            expected += static_cast<float>(i) + 1.0f;
+        }
+    }
+
+    const auto view = registry.view<Position, Velocity>();
+    REQUIRE(view.size_hint() == 1250);
+
+    std::size_t count = 0;
+    float sum = 0.0f;
+    for (const auto& [entity, position, velocity] : view) {
+        REQUIRE(view.contains(entity));
+        sum += position.x + velocity.x;
+        ++count;
+    }
+
+    REQUIRE(count == 1250);
+    REQUIRE(sum == expected);
+    REQUIRE(registry.view<Position>().size_hint() == 5000);
+    REQUIRE(registry.view<Tag>().begin() == registry.view<Tag>().end());
+}
@@ -0,0 +1,141 @@
+#include "scene/scene.h"
+#include "scene/entity.h"
+#include "scene/entity_command_buffer.h"
+#include "core/job_system.h"
+
+#include <catch2/catch_all.hpp>
+
+struct ComponentE {
+    int value = 0;
+};
+
+TEST_CASE("Commands are applied on flush", "[EntityCommandBuffer]") {
+    auto scene = Phos::Scene("Test scene");
+    auto commands = Phos::EntityCommandBuffer(&scene);
+
+    const auto existing = scene.create_entity();
+
+    const auto entity = commands.create("Spawned", Phos::UUID(42));
+    commands.add_component(entity, ComponentE{.value = 3});
+    commands.add_component(entity, Phos::TransformComponent{.position = glm::vec3(1.0f)});
+    commands.destroy(existing.id());
+
+    // Pending values can be read and modified before the flush
+    commands.find_pending_component<Phos::TransformComponent>(entity)->position.y = 2.0f;
+    REQUIRE(commands.find_pending_component<ComponentE>(existing.id()) == nullptr);
+
+    REQUIRE(!scene.valid(entity));
+    REQUIRE(scene.valid(existing.id()));
+
+    commands.flush();
+    REQUIRE(commands.empty());
+
+    REQUIRE(!scene.valid(existing.id()));
+    REQUIRE(scene.valid(entity));
+
+    const auto spawned = scene.get_entity_with_uuid(Phos::UUID(42));
+    REQUIRE(spawned.id() == entity);
+    REQUIRE(spawned.get_component<Phos::NameComponent>().name == "Spawned");
+    REQUIRE(spawned.get_component<ComponentE>().value == 3);
+    REQUIRE(spawned.get_component<Phos::TransformComponent>().position == glm::vec3(1.0f, 2.0f, 1.0f));
+}
+
+TEST_CASE("Commands can set parents and remove components", "[EntityCommandBuffer]") {
+    auto scene = Phos::Scene("Test scene");
+    auto commands = Phos::EntityCommandBuffer(&scene);
+
+    auto parent = scene.create_entity();
+    parent.add_component<ComponentE>();
+
+    const auto child = commands.create();
+    commands.set_parent(child, parent.id());
+    REQUIRE(commands.find_pending_parent(child) == parent.id());
+    REQUIRE(!commands.find_pending_parent(parent.id()).has_value());
+    commands.add_component(parent.id(), ComponentE{.value = 1});
+    REQUIRE(commands.find_pending_component<ComponentE>(parent.id())->value == 1);
+
+    // The last command wins, a pending removal hides the pending value
+    commands.remove_component<ComponentE>(parent.id());
+    REQUIRE(commands.find_pending_component<ComponentE>(parent.id()) == nullptr);
+
+    commands.flush();
+
+    REQUIRE(!parent.has_component<ComponentE>());
+    REQUIRE(scene.get_entity(child).parent() == parent);
+
+    // Destroying the parent also destroys the child, destroying the child again is ignored
+    commands.destroy(parent.id());
+    commands.destroy(child);
+    commands.flush();
+
+    REQUIRE(!scene.valid(child));
+    REQUIRE(scene.get_all_entities().empty());
+}
+
+TEST_CASE("Commands can be recorded from several threads", "[EntityCommandBuffer]") {
+    auto scene = Phos::Scene("Test scene");
+    auto commands = Phos::EntityCommandBuffer(&scene);
+
+    Phos::JobSystem::initialize(4);
+    Phos::JobSystem::parallel_for(1000, 16, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto entity = commands.create();
+            commands.add_component(entity, ComponentE{.value = static_cast<int>(i)});
+        }
+    });
+    Phos::JobSystem::shutdown();
+
+    commands.flush();
+
+    int sum = 0;
+    for (const auto& [_, component] : scene.view<ComponentE>())
+        sum += component.value;
+
+    REQUIRE(scene.get_all_entities().size() == 1000);
+    REQUIRE(sum == 999 * 1000 / 2);
+}
+
+TEST_CASE("A thread can alternate between command buffers", "[EntityCommandBuffer]") {
+    auto scene = Phos::Scene("Test scene");
+    auto first = Phos::EntityCommandBuffer(&scene);
+    auto second = Phos::EntityCommandBuffer(&scene);
+
+    for (int frame = 0; frame < 2; ++frame) {
+        const auto first_entity = first.create();
+        first.add_component(first_entity, ComponentE{.value = 1});
+
+        const auto second_entity = second.create();
+        second.add_component(second_entity, ComponentE{.value = 2});
+
+        // Switching buffers keeps the commands this thread recorded into each of them
+        const auto* first_pending = first.find_pending_component<ComponentE>(first_entity);
+        const auto* second_pending = second.find_pending_component<ComponentE>(second_entity);
+        REQUIRE((first_pending != nullptr && first_pending->value == 1));
+        REQUIRE((second_pending != nullptr && second_pending->value == 2));
+
+        first.flush();
+        second.flush();
+
+        REQUIRE(first.empty());
+        REQUIRE(second.empty());
+        REQUIRE(scene.get_entity(first_entity).get_component<ComponentE>().value == 1);
+        REQUIRE(scene.get_entity(second_entity).get_component<ComponentE>().value == 2);
+    }
+}
+
+TEST_CASE("Commands recorded while flushing wait for the next flush", "[EntityCommandBuffer]") {
+    auto scene = Phos::Scene("Test scene");
+    auto commands = Phos::EntityCommandBuffer(&scene);
+
+    scene.on_construct<ComponentE>([&](Phos::Registry&, Phos::EntityHandle) { (void)commands.create(); });
+
+    const auto entity = commands.create();
+    commands.add_component(entity, ComponentE{});
+    commands.flush();
+
+    REQUIRE(scene.get_all_entities().size() == 1);
+    REQUIRE(!commands.empty());
+
+    commands.flush();
+    REQUIRE(scene.get_all_entities().size() == 2);
+}
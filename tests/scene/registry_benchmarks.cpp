@@ -0,0 +1,59 @@
+#include "scene/registry.h"
+
+#include <catch2/catch_all.hpp>
+
+#include "scene/components.h"
+
+// Compares view iteration between sparse set and archetype storage.
+// Hidden by default, run with: PhosEngineTests "[benchmark]"
+
+static void populate_registry(Phos::Registry& registry, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto entity = registry.create();
+        registry.add_component(entity, Phos::TransformComponent{.position = glm::vec3(static_cast<float>(i))});
+        registry.add_component(entity, Phos::WorldTransformComponent{});
+
+        // Not every entity is renderable, so views cannot simply walk a single array
+        if (i % 2 == 0)
+            registry.add_component(entity, Phos::MeshRendererComponent{});
+    }
+}
+
+static float iterate_renderables(const Phos::Registry& registry) {
+    float sum = 0.0f;
+    for (const auto& [entity, transform, world_transform, mesh_renderer] :
+         registry.view<Phos::TransformComponent, Phos::WorldTransformComponent, Phos::MeshRendererComponent>()) {
+        sum += transform.position.x + world_transform.world[3].x;
+    }
+    return sum;
+}
+
+TEST_CASE("View iteration: sparse set vs archetype", "[.][benchmark]") {
+    const auto count = GENERATE(1'000u, 10'000u, 100'000u);
+
+    auto sparse_set = Phos::Registry(Phos::Registry::StorageMode::SparseSet);
+    auto archetype = Phos::Registry(Phos::Registry::StorageMode::Archetype);
+    populate_registry(sparse_set, count);
+    populate_registry(archetype, count);
+
+    REQUIRE(iterate_renderables(sparse_set) == iterate_renderables(archetype));
+
+    BENCHMARK("SparseSet " + std::to_string(count)) {
+        return iterate_renderables(sparse_set);
+    };
+
+    BENCHMARK("Archetype " + std::to_string(count)) {
+        return iterate_renderables(archetype);
+    };
+}
+
+TEST_CASE("Registry clone", "[.][benchmark]") {
+    const auto mode = GENERATE(Phos::Registry::StorageMode::SparseSet, Phos::Registry::StorageMode::Archetype);
+
+    auto registry = Phos::Registry(mode);
+    populate_registry(registry, 50'000);
+
+    BENCHMARK(std::string(mode == Phos::Registry::StorageMode::SparseSet ? "SparseSet" : "Archetype") + " 50000") {
+        return registry.clone();
+    };
+}
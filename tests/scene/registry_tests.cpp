@@ -10,6 +10,15 @@ struct ComponentB {
     float y;
 };
 
+TEST_CASE("Component types get stable ids", "[Registry]") {
+    const auto id_a = Phos::ComponentType::id<ComponentA>();
+    const auto id_b = Phos::ComponentType::id<ComponentB>();
+
+    REQUIRE(id_a != id_b);
+    REQUIRE(Phos::ComponentType::id<ComponentA>() == id_a);
+    REQUIRE(Phos::ComponentType::id<const ComponentA&>() == id_a);
+}
+
 TEST_CASE("Can create entities", "[Registry]") {
     auto registry = Phos::Registry();
 
@@ -33,6 +42,28 @@ TEST_CASE("Can destroy entities", "[Registry]") {
     REQUIRE(registry.number_entities() == 0);
 }
 
+TEST_CASE("Destroyed entity handles are detected", "[Registry]") {
+    auto registry = Phos::Registry();
+
+    auto entity1 = registry.create();
+    registry.add_component<ComponentA>(entity1, {.x = 1.0f});
+    registry.destroy(entity1);
+
+    // Index is recycled, but with a different version
+    auto entity2 = registry.create();
+    registry.add_component<ComponentA>(entity2, {.x = 2.0f});
+
+    REQUIRE(entity1.index() == entity2.index());
+    REQUIRE(entity1 != entity2);
+
+    REQUIRE_FALSE(registry.valid(entity1));
+    REQUIRE(registry.valid(entity2));
+
+    REQUIRE_FALSE(registry.has_component<ComponentA>(entity1));
+    REQUIRE(registry.get_component<ComponentA>(entity2).x == 2.0f);
+    REQUIRE(registry.number_entities() == 1);
+}
+
 TEST_CASE("Can add component to entity", "[Registry]") {
     auto registry = Phos::Registry();
 
@@ -84,18 +115,199 @@ TEST_CASE("Can get all entities with given component", "[Registry]") {
 
     registry.add_component<ComponentB>(entity2, {.y = 4.0f});
 
+    const auto entity_of = [](const auto& components) { return std::get<0>(components); };
+
     const auto& entities_a = registry.view<ComponentA>();
-    REQUIRE(std::ranges::find(entities_a, entity1) != entities_a.end());
-    REQUIRE(std::ranges::find(entities_a, entity2) != entities_a.end());
-    REQUIRE(std::ranges::find(entities_a, entity3) != entities_a.end());
+    REQUIRE(std::ranges::find(entities_a, entity1, entity_of) != entities_a.end());
+    REQUIRE(std::ranges::find(entities_a, entity2, entity_of) != entities_a.end());
+    REQUIRE(std::ranges::find(entities_a, entity3, entity_of) != entities_a.end());
 
     const auto& entities_b = registry.view<ComponentB>();
-    REQUIRE(std::ranges::find(entities_b, entity1) == entities_b.end());
-    REQUIRE(std::ranges::find(entities_b, entity2) != entities_b.end());
-    REQUIRE(std::ranges::find(entities_b, entity3) == entities_b.end());
+    REQUIRE(std::ranges::find(entities_b, entity1, entity_of) == entities_b.end());
+    REQUIRE(std::ranges::find(entities_b, entity2, entity_of) != entities_b.end());
+    REQUIRE(std::ranges::find(entities_b, entity3, entity_of) == entities_b.end());
 
     registry.remove_component<ComponentA>(entity3);
 
     const auto& entities_a_2 = registry.view<ComponentA>();
-    REQUIRE(std::ranges::find(entities_a_2, entity3) == entities_a_2.end());
+    REQUIRE(std::ranges::find(entities_a_2, entity3, entity_of) == entities_a_2.end());
+}
+
+TEST_CASE("Can view entities with multiple components", "[Registry]") {
+    auto registry = Phos::Registry();
+
+    auto entity1 = registry.create();
+    auto entity2 = registry.create();
+    auto entity3 = registry.create();
+
+    registry.add_component<ComponentA>(entity1, {.x = 1.0f});
+    registry.add_component<ComponentA>(entity2, {.x = 2.0f});
+    registry.add_component<ComponentA>(entity3, {.x = 3.0f});
+
+    registry.add_component<ComponentB>(entity3, {.y = 8.0f});
+    registry.add_component<ComponentB>(entity1, {.y = 4.0f});
+
+    const auto view = registry.view<ComponentA, ComponentB>();
+    REQUIRE(view.size_hint() == 2);
+    REQUIRE(view.contains(entity1));
+    REQUIRE_FALSE(view.contains(entity2));
+    REQUIRE(view.contains(entity3));
+
+    std::size_t count = 0;
+    for (const auto& [entity, a, b] : view) {
+        REQUIRE((entity == entity1 || entity == entity3));
+        REQUIRE(b.y == a.x * 2.0f + 2.0f);
+
+        a.x = 0.0f;
+        ++count;
+    }
+    REQUIRE(count == 2);
+
+    REQUIRE(registry.get_component<ComponentA>(entity1).x == 0.0f);
+    REQUIRE(registry.get_component<ComponentA>(entity2).x == 2.0f);
+    REQUIRE(registry.get_component<ComponentA>(entity3).x == 0.0f);
+
+    struct ComponentNeverAdded {};
+    REQUIRE(registry.view<ComponentA, ComponentNeverAdded>().begin() ==
+            registry.view<ComponentA, ComponentNeverAdded>().end());
+}
+
+TEST_CASE("Can create large number of entities", "[Registry]") {
+    auto registry = Phos::Registry();
+
+    constexpr std::size_t num_entities = 100'000;
+
+    std::vector<Phos::EntityHandle> entities;
+    for (std::size_t i = 0; i < num_entities; ++i) {
+        const auto entity = registry.create();
+        registry.add_component<ComponentA>(entity, {.x = static_cast<float>(i)});
+
+        if (i % 2 == 0)
+            registry.add_component<ComponentB>(entity, {.y = static_cast<float>(i)});
+
+        entities.push_back(entity);
+    }
+
+    REQUIRE(registry.number_entities() == num_entities);
+
+    // Remove components from the first half, moving the last elements of the arrays into the gaps
+    for (std::size_t i = 0; i < num_entities / 2; ++i)
+        registry.remove_component<ComponentA>(entities[i]);
+
+    for (std::size_t i = 0; i < num_entities; ++i) {
+        REQUIRE(registry.has_component<ComponentA>(entities[i]) == (i >= num_entities / 2));
+        REQUIRE(registry.has_component<ComponentB>(entities[i]) == (i % 2 == 0));
+
+        if (i >= num_entities / 2)
+            REQUIRE(registry.get_component<ComponentA>(entities[i]).x == static_cast<float>(i));
+    }
+
+    std::size_t count = 0;
+    for (const auto& [entity, a, b] : registry.view<ComponentA, ComponentB>()) {
+        REQUIRE(a.x == b.y);
+        ++count;
+    }
+    REQUIRE(count == num_entities / 4);
+}
+
+TEST_CASE("Can iterate views in parallel", "[Registry]") {
+    const auto mode = GENERATE(Phos::Registry::StorageMode::SparseSet, Phos::Registry::StorageMode::Archetype);
+    auto registry = Phos::Registry(mode);
+
+    for (uint32_t i = 0; i < 10'000; ++i) {
+        const auto entity = registry.create();
+        registry.add_component(entity, ComponentA{.x = static_cast<float>(i)});
+        if (i % 2 == 0)
+            registry.add_component(entity, ComponentB{.y = 0.0f});
+    }
+
+    Phos::JobSystem::initialize(4);
+    registry.view<ComponentA, ComponentB>().parallel_for_each(
+        [](Phos::EntityHandle, const ComponentA& a, ComponentB& b) { b.y = a.x * 2.0f; }, 64);
+    Phos::JobSystem::shutdown();
+
+    std::size_t count = 0;
+    for (const auto& [entity, a, b] : registry.view<ComponentA, ComponentB>()) {
+        REQUIRE(b.y == a.x * 2.0f);
+        ++count;
+    }
+    REQUIRE(count == 5'000);
+}
+
+TEST_CASE("Can track changed components", "[Registry]") {
+    const auto mode = GENERATE(Phos::Registry::StorageMode::SparseSet, Phos::Registry::StorageMode::Archetype);
+    auto registry = Phos::Registry(mode);
+
+    const auto entity1 = registry.create();
+    const auto entity2 = registry.create();
+    registry.add_component(entity1, ComponentA{.x = 1.0f});
+    registry.add_component(entity2, ComponentA{.x = 2.0f});
+
+    // Nothing has been seen yet, so every added component counts as changed
+    const auto last_seen = registry.advance_tick();
+    REQUIRE(registry.changed_since<ComponentA>(entity1, 0));
+    REQUIRE(!registry.changed_since<ComponentA>(entity1, last_seen));
+
+    registry.patch<ComponentA>(entity2, [](ComponentA& a) { a.x = 5.0f; });
+
+    // Moving entity2 to another archetype must keep its change tick
+    registry.add_component(entity1, ComponentB{});
+    registry.add_component(entity2, ComponentB{});
+
+    std::vector<Phos::EntityHandle> changed;
+    registry.for_each_changed<ComponentA>(last_seen, [&](Phos::EntityHandle entity, const ComponentA& a) {
+        REQUIRE(a.x == 5.0f);
+        changed.push_back(entity);
+    });
+
+    REQUIRE(changed == std::vector{entity2});
+    REQUIRE(registry.changed_since<ComponentB>(entity1, last_seen));
+}
+
+TEST_CASE("Observers are notified of component changes", "[Registry]") {
+    const auto mode = GENERATE(Phos::Registry::StorageMode::SparseSet, Phos::Registry::StorageMode::Archetype);
+    auto registry = Phos::Registry(mode);
+
+    uint32_t constructed = 0, updated = 0, destroyed = 0;
+    registry.on_construct<ComponentA>([&](Phos::Registry&, Phos::EntityHandle) { ++constructed; });
+    registry.on_update<ComponentA>([&](Phos::Registry&, Phos::EntityHandle) { ++updated; });
+    registry.on_destroy<ComponentA>([&](Phos::Registry& r, Phos::EntityHandle entity) {
+        // The component is still accessible when the observer runs
+        REQUIRE(r.get_component<ComponentA>(entity).x == 3.0f);
+        ++destroyed;
+    });
+
+    const auto entity1 = registry.create();
+    const auto entity2 = registry.create();
+    registry.add_component(entity1, ComponentA{.x = 3.0f});
+    registry.add_component(entity2, ComponentA{.x = 3.0f});
+    registry.add_component(entity2, ComponentB{});
+    REQUIRE(constructed == 2);
+
+    // Adding a component the entity already has is rejected, and is not a construction
+    registry.add_component(entity1, ComponentA{.x = 4.0f});
+    REQUIRE(constructed == 2);
+    REQUIRE(registry.get_component<ComponentA>(entity1).x == 3.0f);
+
+    registry.mark_changed<ComponentA>(entity1);
+    REQUIRE(updated == 1);
+
+    registry.remove_component<ComponentA>(entity1);
+    registry.destroy(entity2);
+    REQUIRE(destroyed == 2);
+}
+
+TEST_CASE("Can create and destroy entities in bulk", "[Registry]") {
+    auto registry = Phos::Registry();
+
+    const auto entities = registry.create(100);
+    registry.destroy(std::span(entities).subspan(0, 10));
+    REQUIRE(registry.number_entities() == 90);
+
+    // Destroyed indices are recycled with a new version
+    const auto recycled = registry.create(20);
+    REQUIRE(registry.number_entities() == 110);
+    for (const auto entity : recycled)
+        REQUIRE(std::ranges::find(entities, entity) == entities.end());
+    REQUIRE(std::ranges::all_of(recycled, [&](const auto entity) { return registry.valid(entity); }));
 }
@@ -0,0 +1,109 @@
+#include "scene/scene_hierarchy.h"
+
+#include <catch2/catch_all.hpp>
+
+static std::vector<uint32_t> order_indices(const Phos::SceneHierarchy& hierarchy) {
+    std::vector<uint32_t> indices;
+    for (const auto entity : hierarchy.order())
+        indices.push_back(entity.index());
+    return indices;
+}
+
+static std::vector<Phos::EntityHandle> create_entities(Phos::SceneHierarchy& hierarchy, uint32_t count) {
+    std::vector<Phos::EntityHandle> entities;
+    for (uint32_t i = 0; i < count; ++i) {
+        entities.emplace_back(i, 0);
+        hierarchy.add(entities.back());
+    }
+    return entities;
+}
+
+TEST_CASE("Hierarchy keeps depth first order", "[SceneHierarchy]") {
+    auto hierarchy = Phos::SceneHierarchy();
+    const auto e = create_entities(hierarchy, 6);
+
+    // 0 -> 2 -> 4, 0 -> 5, 1 -> 3
+    hierarchy.set_parent(e[2], e[0]);
+    hierarchy.set_parent(e[3], e[1]);
+    hierarchy.set_parent(e[4], e[2]);
+    hierarchy.set_parent(e[5], e[0]);
+
+    REQUIRE(order_indices(hierarchy) == std::vector<uint32_t>{0, 2, 4, 5, 1, 3});
+    REQUIRE(hierarchy.roots() == std::vector{e[0], e[1]});
+    REQUIRE(hierarchy.children(e[0]) == std::vector{e[2], e[5]});
+    REQUIRE(hierarchy.parent(e[4]) == e[2]);
+    REQUIRE(!hierarchy.has_parent(e[1]));
+
+    REQUIRE(hierarchy.subtree(e[0]).size() == 4);
+    REQUIRE(hierarchy.is_ancestor(e[0], e[4]));
+    REQUIRE(!hierarchy.is_ancestor(e[1], e[4]));
+
+    for (uint32_t position = 0; position < hierarchy.size(); ++position)
+        REQUIRE(hierarchy.position(hierarchy.order()[position]) == position);
+}
+
+TEST_CASE("Reparenting moves the whole subtree", "[SceneHierarchy]") {
+    auto hierarchy = Phos::SceneHierarchy();
+    const auto e = create_entities(hierarchy, 6);
+
+    // 0 -> 1 -> 2, 3 -> 4, 5
+    hierarchy.set_parent(e[1], e[0]);
+    hierarchy.set_parent(e[2], e[1]);
+    hierarchy.set_parent(e[4], e[3]);
+
+    // Forward move
+    hierarchy.set_parent(e[1], e[4]);
+    REQUIRE(order_indices(hierarchy) == std::vector<uint32_t>{0, 3, 4, 1, 2, 5});
+    REQUIRE(hierarchy.subtree(e[3]).size() == 4);
+    REQUIRE(hierarchy.subtree(e[0]).size() == 1);
+    REQUIRE(!hierarchy.has_children(e[0]));
+
+    // Backward move
+    hierarchy.set_parent(e[5], e[0]);
+    REQUIRE(order_indices(hierarchy) == std::vector<uint32_t>{0, 5, 3, 4, 1, 2});
+
+    // Moving to an ancestor makes it the last child
+    hierarchy.set_parent(e[2], e[3]);
+    REQUIRE(order_indices(hierarchy) == std::vector<uint32_t>{0, 5, 3, 4, 1, 2});
+    REQUIRE(hierarchy.children(e[3]) == std::vector{e[4], e[2]});
+
+    // Back to root
+    hierarchy.set_parent(e[4]);
+    REQUIRE(order_indices(hierarchy) == std::vector<uint32_t>{0, 5, 3, 2, 4, 1});
+    REQUIRE(hierarchy.roots() == std::vector{e[0], e[3], e[4]});
+
+    // Cycles are rejected
+    REQUIRE(!hierarchy.set_parent(e[4], e[1]));
+    REQUIRE(order_indices(hierarchy) == std::vector<uint32_t>{0, 5, 3, 2, 4, 1});
+
+    for (uint32_t position = 0; position < hierarchy.size(); ++position)
+        REQUIRE(hierarchy.position(hierarchy.order()[position]) == position);
+}
+
+TEST_CASE("Removing subtrees compacts the order", "[SceneHierarchy]") {
+    auto hierarchy = Phos::SceneHierarchy();
+    const auto e = create_entities(hierarchy, 6);
+
+    // 0 -> 1 -> 2, 0 -> 3, 4 -> 5
+    hierarchy.set_parent(e[1], e[0]);
+    hierarchy.set_parent(e[2], e[1]);
+    hierarchy.set_parent(e[3], e[0]);
+    hierarchy.set_parent(e[5], e[4]);
+
+    const auto removed = hierarchy.remove_subtrees(std::vector{e[2], e[1], e[5], e[1]});
+    REQUIRE(removed == std::vector{e[1], e[2], e[5]});
+
+    REQUIRE(order_indices(hierarchy) == std::vector<uint32_t>{0, 3, 4});
+    REQUIRE(hierarchy.children(e[0]) == std::vector{e[3]});
+    REQUIRE(hierarchy.subtree(e[0]).size() == 2);
+    REQUIRE(!hierarchy.has_children(e[4]));
+
+    REQUIRE(!hierarchy.contains(e[1]));
+    REQUIRE(hierarchy.contains(e[3]));
+
+    // Indices can be reused
+    const auto reused = Phos::EntityHandle(1, 1);
+    hierarchy.add(reused);
+    REQUIRE(hierarchy.contains(reused));
+    REQUIRE(!hierarchy.contains(e[1]));
+}
@@ -93,7 +93,7 @@ TEST_CASE("Can get all entities with given component and remove components", "[S
     REQUIRE(entities_d.empty());
 }
 
-TEST_CASE("Adding children updates RelationshipComponent accordingly", "[Scene]") {
+TEST_CASE("Adding children updates hierarchy accordingly", "[Scene]") {
     auto scene = Phos::Scene("Test scene");
 
     auto parent = scene.create_entity();
@@ -103,24 +103,21 @@ TEST_CASE("Adding children updates RelationshipComponent accordingly", "[Scene]"
     parent.add_child(child_1);
     parent.add_child(child_2);
 
-    const auto& parent_component = parent.get_component<Phos::RelationshipComponent>();
+    const auto parent_children = parent.children();
 
-    REQUIRE_FALSE(parent_component.parent.has_value());
-    REQUIRE(parent_component.children.size() == 2);
-    REQUIRE(parent_component.children[0] == child_1.uuid());
-    REQUIRE(parent_component.children[1] == child_2.uuid());
+    REQUIRE_FALSE(parent.parent().has_value());
+    REQUIRE(parent_children.size() == 2);
+    REQUIRE(parent_children[0] == child_1);
+    REQUIRE(parent_children[1] == child_2);
 
-    const auto& child_1_component = child_1.get_component<Phos::RelationshipComponent>();
-    const auto& child_2_component = child_2.get_component<Phos::RelationshipComponent>();
+    REQUIRE(child_1.parent().has_value());
+    REQUIRE(*child_1.parent() == parent);
 
-    REQUIRE(child_1_component.parent.has_value());
-    REQUIRE(*child_1_component.parent == parent.uuid());
-
-    REQUIRE(child_2_component.parent.has_value());
-    REQUIRE(*child_2_component.parent == parent.uuid());
+    REQUIRE(child_2.parent().has_value());
+    REQUIRE(*child_2.parent() == parent);
 }
 
-TEST_CASE("Adding parent updates RelationshipComponent accordingly", "[Scene]") {
+TEST_CASE("Adding parent updates hierarchy accordingly", "[Scene]") {
     auto scene = Phos::Scene("Test scene");
 
     auto parent = scene.create_entity();
@@ -130,24 +127,21 @@ TEST_CASE("Adding parent updates RelationshipComponent accordingly", "[Scene]")
     child_1.set_parent(parent);
     child_2.set_parent(parent);
 
-    const auto& parent_component = parent.get_component<Phos::RelationshipComponent>();
-
-    REQUIRE_FALSE(parent_component.parent.has_value());
-    REQUIRE(parent_component.children.size() == 2);
-    REQUIRE(parent_component.children[0] == child_1.uuid());
-    REQUIRE(parent_component.children[1] == child_2.uuid());
+    const auto parent_children = parent.children();
 
-    const auto& child_1_component = child_1.get_component<Phos::RelationshipComponent>();
-    const auto& child_2_component = child_2.get_component<Phos::RelationshipComponent>();
+    REQUIRE_FALSE(parent.parent().has_value());
+    REQUIRE(parent_children.size() == 2);
+    REQUIRE(parent_children[0] == child_1);
+    REQUIRE(parent_children[1] == child_2);
 
-    REQUIRE(child_1_component.parent.has_value());
-    REQUIRE(*child_1_component.parent == parent.uuid());
+    REQUIRE(child_1.parent().has_value());
+    REQUIRE(*child_1.parent() == parent);
 
-    REQUIRE(child_2_component.parent.has_value());
-    REQUIRE(*child_2_component.parent == parent.uuid());
+    REQUIRE(child_2.parent().has_value());
+    REQUIRE(*child_2.parent() == parent);
 }
 
-TEST_CASE("Adding multi level children updates RelationshipComponent accordingly", "[Scene]") {
+TEST_CASE("Adding multi level children updates hierarchy accordingly", "[Scene]") {
     auto scene = Phos::Scene("Test scene");
 
     auto parent = scene.create_entity();
@@ -159,24 +153,22 @@ TEST_CASE("Adding multi level children updates RelationshipComponent accordingly
     parent.add_child(child_3);
     child_1.add_child(child_2);
 
-    const auto& parent_component = parent.get_component<Phos::RelationshipComponent>();
-    const auto& child_1_component = child_1.get_component<Phos::RelationshipComponent>();
-    const auto& child_2_component = child_2.get_component<Phos::RelationshipComponent>();
-    const auto& child_3_component = child_3.get_component<Phos::RelationshipComponent>();
+    const auto parent_children = parent.children();
+    const auto child_1_children = child_1.children();
 
-    REQUIRE(parent_component.children.size() == 2);
-    REQUIRE(parent_component.children[0] == child_1.uuid());
-    REQUIRE(parent_component.children[1] == child_3.uuid());
+    REQUIRE(parent_children.size() == 2);
+    REQUIRE(parent_children[0] == child_1);
+    REQUIRE(parent_children[1] == child_3);
 
-    REQUIRE((child_1_component.parent.has_value() && *child_1_component.parent == parent.uuid()));
-    REQUIRE(child_1_component.children.size() == 1);
-    REQUIRE(child_1_component.children[0] == child_2.uuid());
+    REQUIRE((child_1.parent().has_value() && *child_1.parent() == parent));
+    REQUIRE(child_1_children.size() == 1);
+    REQUIRE(child_1_children[0] == child_2);
 
-    REQUIRE((child_2_component.parent.has_value() && *child_2_component.parent == child_1.uuid()));
-    REQUIRE(child_2_component.children.empty());
+    REQUIRE((child_2.parent().has_value() && *child_2.parent() == child_1));
+    REQUIRE(!child_2.has_children());
 
-    REQUIRE((child_3_component.parent.has_value() && *child_3_component.parent == parent.uuid()));
-    REQUIRE(child_3_component.children.empty());
+    REQUIRE((child_3.parent().has_value() && *child_3.parent() == parent));
+    REQUIRE(!child_3.has_children());
 }
 
 TEST_CASE("Removing entity also removes children", "[Scene]") {
@@ -205,7 +197,7 @@ TEST_CASE("Removing entity also removes children", "[Scene]") {
     REQUIRE(entities[0].uuid() == parent_2.uuid());
 }
 
-TEST_CASE("Removing sub-entity removes it's children and updates RelationshipComponent", "[Scene]") {
+TEST_CASE("Removing sub-entity removes it's children and updates hierarchy", "[Scene]") {
     auto scene = Phos::Scene("Test scene");
 
     auto parent = scene.create_entity();
@@ -229,9 +221,9 @@ TEST_CASE("Removing sub-entity removes it's children and updates RelationshipCom
     REQUIRE((std::ranges::find(entities, parent) != entities.end() &&
              std::ranges::find(entities, child_3) != entities.end()));
 
-    const auto& parent_component = parent.get_component<Phos::RelationshipComponent>();
-    REQUIRE(parent_component.children.size() == 1);
-    REQUIRE(parent_component.children[0] == child_3.uuid());
+    const auto parent_children = parent.children();
+    REQUIRE(parent_children.size() == 1);
+    REQUIRE(parent_children[0] == child_3);
 }
 
 TEST_CASE("Can clone scene", "[Scene]") {
@@ -278,3 +270,79 @@ TEST_CASE("Modifying cloned scene does not modify original", "[Scene]") {
     REQUIRE(check_entity_2.has_component<Phos::MeshRendererComponent>());
     REQUIRE_FALSE(check_entity_2.has_component<Phos::CameraComponent>());
 }
+
+TEST_CASE("Cloned scene keeps entity handles and component data", "[Scene]") {
+    const auto mode = GENERATE(Phos::Registry::StorageMode::SparseSet, Phos::Registry::StorageMode::Archetype);
+    auto scene = Phos::Scene("Test scene", mode);
+
+    std::vector<Phos::Entity> entities;
+    for (uint32_t i = 0; i < 100; ++i)
+        entities.push_back(scene.create_entity("Entity " + std::to_string(i), Phos::UUID()));
+
+    entities[1].set_parent(entities[0]);
+    entities[2].add_component<Phos::MeshRendererComponent>();
+    scene.destroy_entity(entities[50]);
+
+    auto clone_scene = Phos::Scene(scene);
+    REQUIRE(clone_scene.get_all_entities().size() == 99);
+
+    for (uint32_t i = 0; i < entities.size(); ++i) {
+        if (i == 50)
+            continue;
+
+        const auto clone_entity = clone_scene.get_entity(entities[i].id());
+        REQUIRE(clone_entity.uuid() == entities[i].uuid());
+        REQUIRE(clone_entity.get_component<Phos::NameComponent>().name == "Entity " + std::to_string(i));
+    }
+
+    const auto clone_entity_1 = clone_scene.get_entity_with_uuid(entities[1].uuid());
+    REQUIRE(clone_entity_1.parent()->uuid() == entities[0].uuid());
+    REQUIRE(clone_scene.get_entity(entities[2].id()).has_component<Phos::MeshRendererComponent>());
+
+    // New entities in the clone do not collide with the copied ones
+    const auto new_entity = clone_scene.create_entity();
+    REQUIRE(new_entity.id().index() == entities[50].id().index());
+    REQUIRE(new_entity.id() != entities[50].id());
+}
+
+TEST_CASE("Can create entities in bulk", "[Scene]") {
+    auto scene = Phos::Scene("Test scene");
+    scene.create_entity();
+
+    const auto entities = scene.create_entities(1000, "Bullet");
+    REQUIRE(entities.size() == 1000);
+    REQUIRE(scene.get_all_entities().size() == 1001);
+
+    REQUIRE(entities[0].get_component<Phos::NameComponent>().name == "Bullet 1");
+    REQUIRE(entities[999].get_component<Phos::NameComponent>().name == "Bullet 1000");
+
+    for (const auto& entity : entities) {
+        REQUIRE(entity.has_component<Phos::TransformComponent>());
+        REQUIRE(scene.get_entity_with_uuid(entity.uuid()) == entity);
+    }
+}
+
+TEST_CASE("Can destroy entities and subtrees in bulk", "[Scene]") {
+    auto scene = Phos::Scene("Test scene");
+
+    auto entities = scene.create_entities(6);
+    const auto& root = entities[0];
+
+    // 0 -> 1 -> 2, 0 -> 3, 4 -> 5
+    entities[1].set_parent(root);
+    entities[2].set_parent(entities[1]);
+    entities[3].set_parent(root);
+    entities[5].set_parent(entities[4]);
+
+    // Subtree of 1, an entity inside it, and a child whose parent is kept
+    const std::vector<Phos::Entity> to_destroy = {entities[1], entities[2], entities[5]};
+    scene.destroy_entities(to_destroy);
+
+    REQUIRE(scene.get_all_entities().size() == 3);
+    REQUIRE(root.children() == std::vector{entities[3]});
+    REQUIRE(!entities[4].has_children());
+
+    scene.destroy_subtree(root);
+    REQUIRE(scene.get_all_entities().size() == 1);
+    REQUIRE(!scene.valid(entities[3].id()));
+}
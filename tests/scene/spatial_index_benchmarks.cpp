@@ -0,0 +1,58 @@
+#include "scene/spatial_index.h"
+
+#include <catch2/catch_all.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+#include <string>
+
+#include "renderer/mesh.h"
+#include "renderer/frustum_culling.h"
+
+// Compares culling a grid of static meshes with the linear scan over BoundsArrays and with the spatial index.
+// Hidden by default, run with: PhosEngineTests "[benchmark]"
+
+static std::vector<Phos::AABB> make_grid(std::size_t count) {
+    const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+
+    std::vector<Phos::AABB> bounds(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto min = glm::vec3(static_cast<float>(i % side) * 2.0f, 0.0f, -static_cast<float>(i / side) * 2.0f);
+        bounds[i] = Phos::AABB{.min = min, .max = min + glm::vec3(1.0f)};
+    }
+    return bounds;
+}
+
+TEST_CASE("Frustum culling: linear scan vs spatial index", "[.][benchmark]") {
+    const auto count = GENERATE(std::size_t{1'000}, std::size_t{10'000}, std::size_t{100'000});
+
+    const auto bounds = make_grid(count);
+
+    Phos::BoundsArrays arrays;
+    arrays.reserve(count);
+    Phos::SpatialIndex index;
+    for (std::size_t i = 0; i < count; ++i) {
+        arrays.push_back(bounds[i]);
+        index.update(Phos::EntityHandle(static_cast<uint32_t>(i), 0), bounds[i]);
+    }
+
+    // Camera looking down the grid, with the same far plane as the editor camera
+    const auto projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.001f, 40.0f);
+    const auto view = glm::lookAt(glm::vec3(20.0f, 5.0f, 5.0f), glm::vec3(20.0f, 0.0f, -20.0f),
+                                  glm::vec3(0.0f, 1.0f, 0.0f));
+    const auto frustum = Phos::Frustum::from_view_projection(projection * view);
+
+    Phos::VisibilityMask mask;
+    std::vector<Phos::EntityHandle> visible;
+
+    BENCHMARK("Linear scan " + std::to_string(count)) {
+        Phos::FrustumCulling::cull(frustum, arrays, mask);
+        return Phos::FrustumCulling::count_visible(mask);
+    };
+
+    BENCHMARK("Spatial index " + std::to_string(count)) {
+        visible.clear();
+        index.query(frustum, visible);
+        return visible.size();
+    };
+}
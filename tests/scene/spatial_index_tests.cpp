@@ -0,0 +1,163 @@
+#include "scene/spatial_index.h"
+
+#include <catch2/catch_all.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <algorithm>
+
+#include "renderer/mesh.h"
+#include "renderer/frustum_culling.h"
+
+static Phos::AABB random_box(std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+    const auto min = glm::vec3(position(rng), position(rng), position(rng));
+    return Phos::AABB{.min = min, .max = min + glm::vec3(size(rng), size(rng), size(rng))};
+}
+
+static bool boxes_overlap(const Phos::AABB& a, const Phos::AABB& b) {
+    for (int axis = 0; axis < 3; ++axis) {
+        if (a.max[axis] < b.min[axis] || b.max[axis] < a.min[axis])
+            return false;
+    }
+    return true;
+}
+
+static std::vector<uint32_t> sorted_indices(const std::vector<Phos::EntityHandle>& entities) {
+    std::vector<uint32_t> indices;
+    for (const auto entity : entities)
+        indices.push_back(entity.index());
+    std::ranges::sort(indices);
+    return indices;
+}
+
+TEST_CASE("DynamicAABBTree stays valid while proxies are created, moved and destroyed", "[DynamicAABBTree]") {
+    std::mt19937 rng(42);
+    Phos::DynamicAABBTree tree;
+
+    std::vector<uint32_t> proxies;
+    for (uint64_t i = 0; i < 1000; ++i)
+        proxies.push_back(tree.create_proxy(random_box(rng), i));
+
+    REQUIRE(tree.validate());
+    REQUIRE(tree.proxy_count() == 1000);
+
+    // A balanced tree of 1000 leaves is around 10 levels high
+    REQUIRE(tree.height() <= 20);
+
+    for (std::size_t i = 0; i < proxies.size(); i += 3)
+        tree.move_proxy(proxies[i], random_box(rng));
+    REQUIRE(tree.validate());
+
+    for (std::size_t i = 0; i < proxies.size(); i += 2)
+        tree.destroy_proxy(proxies[i]);
+    REQUIRE(tree.validate());
+    REQUIRE(tree.proxy_count() == 500);
+
+    // Small movements stay inside of the enlarged box, larger ones reinsert the proxy
+    const auto box = Phos::AABB{.min = glm::vec3(0.0f), .max = glm::vec3(1.0f)};
+    const auto proxy = tree.create_proxy(box, 1000);
+    const auto offset = glm::vec3(0.05f, 0.0f, 0.0f);
+    REQUIRE_FALSE(tree.move_proxy(proxy, Phos::AABB{.min = box.min + offset, .max = box.max + offset}));
+    REQUIRE(tree.move_proxy(proxy, Phos::AABB{.min = box.min + 10.0f * offset, .max = box.max + 10.0f * offset}));
+    REQUIRE(tree.validate());
+}
+
+TEST_CASE("SpatialIndex queries match a linear scan", "[SpatialIndex]") {
+    std::mt19937 rng(7);
+    Phos::SpatialIndex index;
+
+    std::vector<Phos::AABB> bounds(2000);
+    for (uint32_t i = 0; i < bounds.size(); ++i) {
+        bounds[i] = random_box(rng);
+        index.update(Phos::EntityHandle(i, 0), bounds[i]);
+    }
+
+    // Move some entities far enough to be reinserted
+    for (uint32_t i = 0; i < bounds.size(); i += 5) {
+        bounds[i] = random_box(rng);
+        index.update(Phos::EntityHandle(i, 0), bounds[i]);
+    }
+
+    REQUIRE(index.size() == bounds.size());
+    REQUIRE(index.tree().validate());
+
+    SECTION("Frustum") {
+        const auto projection = glm::perspective(glm::radians(60.0f), 1.5f, 0.1f, 80.0f);
+        const auto view = glm::lookAt(glm::vec3(10.0f, 5.0f, 20.0f), glm::vec3(-30.0f, 0.0f, -40.0f),
+                                      glm::vec3(0.0f, 1.0f, 0.0f));
+        const auto frustum = Phos::Frustum::from_view_projection(projection * view);
+
+        std::vector<Phos::EntityHandle> visible;
+        index.query(frustum, visible);
+
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < bounds.size(); ++i) {
+            if (Phos::FrustumCulling::is_visible(frustum, bounds[i]))
+                expected.push_back(i);
+        }
+
+        REQUIRE(!expected.empty());
+        REQUIRE(sorted_indices(visible) == expected);
+    }
+
+    SECTION("AABB") {
+        const auto region = Phos::AABB{.min = glm::vec3(-20.0f), .max = glm::vec3(25.0f, 10.0f, 30.0f)};
+
+        std::vector<Phos::EntityHandle> overlapping;
+        index.query(region, overlapping);
+
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < bounds.size(); ++i) {
+            if (boxes_overlap(region, bounds[i]))
+                expected.push_back(i);
+        }
+
+        REQUIRE(!expected.empty());
+        REQUIRE(sorted_indices(overlapping) == expected);
+    }
+
+    SECTION("Raycast") {
+        const auto ray = Phos::Ray{.origin = glm::vec3(-120.0f, 0.5f, 0.5f), .direction = glm::vec3(1.0f, 0.0f, 0.0f)};
+
+        // Boxes crossing the line y = 0.5, z = 0.5, the closest one is the one with the smallest min.x
+        std::optional<uint32_t> expected;
+        for (uint32_t i = 0; i < bounds.size(); ++i) {
+            const auto& box = bounds[i];
+            if (box.min.y > 0.5f || box.max.y < 0.5f || box.min.z > 0.5f || box.max.z < 0.5f)
+                continue;
+            if (!expected.has_value() || box.min.x < bounds[*expected].min.x)
+                expected = i;
+        }
+
+        const auto hit = index.raycast(ray);
+        REQUIRE(hit.has_value() == expected.has_value());
+        if (expected.has_value()) {
+            REQUIRE(hit->entity.index() == *expected);
+            REQUIRE(hit->distance == Catch::Approx(bounds[*expected].min.x - ray.origin.x));
+        }
+
+        // Too short to reach anything
+        REQUIRE_FALSE(index.raycast(ray, 1.0f).has_value());
+    }
+}
+
+TEST_CASE("SpatialIndex removes entities", "[SpatialIndex]") {
+    Phos::SpatialIndex index;
+
+    const auto entity = Phos::EntityHandle(3, 0);
+    index.update(entity, Phos::AABB{.min = glm::vec3(-1.0f), .max = glm::vec3(1.0f)});
+    REQUIRE(index.contains(entity));
+
+    index.remove(entity);
+    REQUIRE_FALSE(index.contains(entity));
+    REQUIRE(index.size() == 0);
+
+    const auto ray = Phos::Ray{.origin = glm::vec3(0.0f, 0.0f, 5.0f), .direction = glm::vec3(0.0f, 0.0f, -1.0f)};
+    REQUIRE_FALSE(index.raycast(ray).has_value());
+
+    // Removing twice is ignored
+    index.remove(entity);
+    REQUIRE(index.tree().validate());
+}
@@ -0,0 +1,84 @@
+#include "scene/transform_kernels.h"
+
+#include <catch2/catch_all.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <array>
+#include <vector>
+
+#include "scene/components.h"
+
+// Compares the per entity glm composition that get_renderable_entities used with the batched kernels.
+// Hidden by default, run with: PhosEngineTests "[benchmark]"
+
+static std::vector<Phos::TransformComponent> make_transforms(std::size_t count) {
+    std::vector<Phos::TransformComponent> transforms(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto t = static_cast<float>(i);
+        transforms[i] = Phos::TransformComponent{
+            .position = glm::vec3(t, -t, 0.5f * t),
+            .rotation = glm::vec3(0.01f * t, 0.02f * t, -0.03f * t),
+            .scale = glm::vec3(1.0f + 0.001f * t),
+        };
+    }
+    return transforms;
+}
+
+static glm::mat4 glm_model(const Phos::TransformComponent& transform) {
+    auto model = glm::mat4(1.0f);
+    model = glm::translate(model, transform.position);
+    model = model * glm::mat4_cast(glm::quat(transform.rotation));
+    return glm::scale(model, transform.scale);
+}
+
+TEST_CASE("Transform composition: glm vs kernels", "[.][benchmark]") {
+    const auto count = GENERATE(std::size_t{1'000}, std::size_t{10'000}, std::size_t{100'000});
+
+    const auto transforms = make_transforms(count);
+    const auto parent = glm::translate(glm::mat4{1.0f}, glm::vec3(1.0f, 2.0f, 3.0f));
+
+    std::array<std::vector<float>, 9> soa;
+    for (auto& array : soa)
+        array.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            soa[axis][i] = transforms[i].position[axis];
+            soa[3 + axis][i] = transforms[i].rotation[axis];
+            soa[6 + axis][i] = transforms[i].scale[axis];
+        }
+    }
+
+    const Phos::TransformArrays arrays{
+        .position = {soa[0].data(), soa[1].data(), soa[2].data()},
+        .rotation = {soa[3].data(), soa[4].data(), soa[5].data()},
+        .scale = {soa[6].data(), soa[7].data(), soa[8].data()},
+        .count = count,
+    };
+    const std::vector<const glm::mat4*> parents(count, &parent);
+
+    std::vector<glm::mat4> local(count), world(count);
+
+    BENCHMARK("glm " + std::to_string(count)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            local[i] = glm_model(transforms[i]);
+            world[i] = parent * local[i];
+        }
+        return world.back();
+    };
+
+    const std::array<std::pair<Phos::SimdBackend, std::string>, 3> backends = {{
+        {Phos::SimdBackend::Scalar, "Scalar "},
+        {Phos::SimdBackend::SSE4, "SSE4 "},
+        {Phos::SimdBackend::AVX2, "AVX2 "},
+    }};
+
+    for (const auto& [backend, name] : backends) {
+        if (!Phos::CpuFeatures::supports(backend))
+            continue;
+
+        BENCHMARK(name + std::to_string(count)) {
+            Phos::TransformKernels::compose(backend, arrays, parents, local, world);
+            return world.back();
+        };
+    }
+}
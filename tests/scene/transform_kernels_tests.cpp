@@ -0,0 +1,102 @@
+#include "scene/transform_kernels.h"
+
+#include <catch2/catch_all.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <array>
+#include <vector>
+
+using Backend = Phos::SimdBackend;
+
+struct TransformBatch {
+    std::array<std::vector<float>, 9> soa;
+
+    explicit TransformBatch(std::size_t count) {
+        for (auto& array : soa)
+            array.resize(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto t = static_cast<float>(i);
+            for (int axis = 0; axis < 3; ++axis) {
+                const auto a = static_cast<float>(axis);
+                soa[axis][i] = t * 0.5f - a;
+                // Covers negative angles and angles past a full turn
+                soa[3 + axis][i] = (t - 10.0f) * 0.37f + a * 1.3f;
+                soa[6 + axis][i] = 0.5f + 0.1f * t + 0.2f * a;
+            }
+        }
+    }
+
+    [[nodiscard]] Phos::TransformArrays arrays() const {
+        return {
+            .position = {soa[0].data(), soa[1].data(), soa[2].data()},
+            .rotation = {soa[3].data(), soa[4].data(), soa[5].data()},
+            .scale = {soa[6].data(), soa[7].data(), soa[8].data()},
+            .count = soa[0].size(),
+        };
+    }
+
+    [[nodiscard]] glm::mat4 expected_local(std::size_t i) const {
+        const auto position = glm::vec3(soa[0][i], soa[1][i], soa[2][i]);
+        const auto rotation = glm::vec3(soa[3][i], soa[4][i], soa[5][i]);
+        const auto scale = glm::vec3(soa[6][i], soa[7][i], soa[8][i]);
+
+        auto model = glm::translate(glm::mat4{1.0f}, position);
+        model = model * glm::mat4_cast(glm::quat(rotation));
+        return glm::scale(model, scale);
+    }
+};
+
+static bool approx_equal(const glm::mat4& a, const glm::mat4& b) {
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            if (std::abs(a[column][row] - b[column][row]) > 1e-4f * std::max(1.0f, std::abs(b[column][row])))
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Transform kernels match glm", "[TransformKernels]") {
+    const auto backend = GENERATE(Backend::Scalar, Backend::SSE4, Backend::AVX2);
+    if (!Phos::CpuFeatures::supports(backend))
+        return;
+
+    // Counts that are not a multiple of the batch size exercise the scalar tail
+    const auto count = GENERATE(std::size_t{1}, std::size_t{7}, std::size_t{37});
+    const auto batch = TransformBatch(count);
+
+    std::vector<glm::mat4> local(count), world(count);
+
+    SECTION("Without parents") {
+        Phos::TransformKernels::compose(backend, batch.arrays(), {}, local, world);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(approx_equal(local[i], batch.expected_local(i)));
+            REQUIRE(approx_equal(world[i], local[i]));
+        }
+    }
+
+    SECTION("With parents") {
+        const auto parent = glm::translate(glm::mat4{1.0f}, glm::vec3(1.0f, -2.0f, 3.0f)) *
+                            glm::mat4_cast(glm::quat(glm::vec3(0.3f, -1.2f, 2.5f))) *
+                            glm::scale(glm::mat4{1.0f}, glm::vec3(2.0f, 1.0f, 0.5f));
+
+        // Every other transform has no parent
+        std::vector<const glm::mat4*> parents(count);
+        for (std::size_t i = 0; i < count; ++i)
+            parents[i] = i % 2 == 0 ? &parent : nullptr;
+
+        Phos::TransformKernels::compose(backend, batch.arrays(), parents, local, world);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto expected = batch.expected_local(i);
+            REQUIRE(approx_equal(local[i], expected));
+            REQUIRE(approx_equal(world[i], parents[i] != nullptr ? parent * expected : expected));
+        }
+    }
+}
+
+TEST_CASE("Best backend is supported", "[TransformKernels]") {
+    REQUIRE(Phos::CpuFeatures::supports(Phos::CpuFeatures::best_simd_backend()));
+}
@@ -0,0 +1,87 @@
+#include "scene/scene.h"
+#include "scene/entity.h"
+#include "scene/transform_system.h"
+
+#include <catch2/catch_all.hpp>
+
+static glm::vec3 world_position(const Phos::Entity& entity) {
+    return entity.get_component<Phos::WorldTransformComponent>().position();
+}
+
+TEST_CASE("World transforms compose parent transforms", "[TransformSystem]") {
+    auto scene = Phos::Scene("Test scene");
+
+    auto root = scene.create_entity();
+    auto child = scene.create_entity();
+    auto grandchild = scene.create_entity();
+
+    child.set_parent(root);
+    grandchild.set_parent(child);
+
+    root.get_component<Phos::TransformComponent>().position = glm::vec3(1.0f, 0.0f, 0.0f);
+    root.get_component<Phos::TransformComponent>().scale = glm::vec3(2.0f);
+    child.get_component<Phos::TransformComponent>().position = glm::vec3(0.0f, 1.0f, 0.0f);
+    grandchild.get_component<Phos::TransformComponent>().position = glm::vec3(0.0f, 0.0f, 1.0f);
+
+    Phos::TransformSystem::update(scene);
+
+    REQUIRE(world_position(root) == glm::vec3(1.0f, 0.0f, 0.0f));
+    REQUIRE(world_position(child) == glm::vec3(1.0f, 2.0f, 0.0f));
+    REQUIRE(world_position(grandchild) == glm::vec3(1.0f, 2.0f, 2.0f));
+}
+
+TEST_CASE("Only changed subtrees are recomputed", "[TransformSystem]") {
+    auto scene = Phos::Scene("Test scene");
+
+    auto root = scene.create_entity();
+    auto child = scene.create_entity();
+    auto other = scene.create_entity();
+
+    child.set_parent(root);
+    child.get_component<Phos::TransformComponent>().position = glm::vec3(0.0f, 1.0f, 0.0f);
+
+    Phos::TransformSystem::update(scene);
+
+    // Entities whose world transform is written by the next update
+    std::vector<Phos::EntityHandle> recomputed;
+    const auto update_transforms = [&]() {
+        const auto since = scene.current_tick();
+        Phos::TransformSystem::update(scene);
+
+        recomputed.clear();
+        scene.for_each_changed<Phos::WorldTransformComponent>(
+            since, [&](Phos::EntityHandle entity, const auto&) { recomputed.push_back(entity); });
+    };
+
+    // Nothing changed
+    update_transforms();
+    REQUIRE(recomputed.empty());
+
+    // Changing the parent recomputes its children
+    root.patch<Phos::TransformComponent>([](auto& transform) { transform.position.x = 5.0f; });
+    update_transforms();
+
+    REQUIRE(recomputed.size() == 2);
+    REQUIRE(std::ranges::find(recomputed, other.id()) == recomputed.end());
+    REQUIRE(world_position(child) == glm::vec3(5.0f, 1.0f, 0.0f));
+}
+
+TEST_CASE("Reparenting updates world transforms", "[TransformSystem]") {
+    auto scene = Phos::Scene("Test scene");
+
+    auto parent1 = scene.create_entity();
+    auto parent2 = scene.create_entity();
+    auto child = scene.create_entity();
+
+    parent1.get_component<Phos::TransformComponent>().position = glm::vec3(1.0f, 0.0f, 0.0f);
+    parent2.get_component<Phos::TransformComponent>().position = glm::vec3(0.0f, 0.0f, 3.0f);
+    child.set_parent(parent1);
+
+    Phos::TransformSystem::update(scene);
+    REQUIRE(world_position(child) == glm::vec3(1.0f, 0.0f, 0.0f));
+
+    child.set_parent(parent2);
+
+    Phos::TransformSystem::update(scene);
+    REQUIRE(world_position(child) == glm::vec3(0.0f, 0.0f, 3.0f));
+}